@@ -0,0 +1,906 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../s21_fixed_matrix.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_matrix_io.h"
+#include "../s21_matrix_oop.h"
+#include "../s21_matrix_sparse.h"
+#include "../s21_matrix_text.h"
+#include "../s21_matrix_update.h"
+
+namespace {
+
+const int kMinSize = 4;
+const int kMaxSize = 4096;
+// Наивное произведение слишком медленное для больших размеров
+const int kMaxNaiveSize = 512;
+
+/**
+ * @brief Заполняет матрицу псевдослучайными числами из [-1, 1] и
+ * усиливает диагональ, чтобы матрица была хорошо обусловлена
+ */
+template <class T = double>
+S21BasicMatrix<T> RandomMatrix(int rows, int cols) {
+  static std::mt19937 generator(21);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  S21BasicMatrix<T> matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix.At(i, j) = static_cast<T>(distribution(generator));
+    }
+  }
+  for (int i = 0; i < rows && i < cols; ++i) {
+    matrix.At(i, i) += static_cast<T>(2.0);
+  }
+  return matrix;
+}
+
+void Sizes(benchmark::internal::Benchmark *b) {
+  for (int n = kMinSize; n <= kMaxSize; n *= 4) {
+    b->Arg(n);
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+void NaiveSizes(benchmark::internal::Benchmark *b) {
+  for (int n = kMinSize; n <= kMaxNaiveSize; n *= 2) {
+    b->Arg(n);
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+/**
+ * @brief Размер x число потоков: 1, 2, 4, ... и число аппаратных потоков
+ */
+void ThreadCounts(benchmark::internal::Benchmark *b) {
+  const int hardware =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for (int n : {256, 1024, 2048}) {
+    int threads = 1;
+    for (; threads < hardware; threads *= 2) {
+      b->Args({n, threads});
+    }
+    b->Args({n, hardware});
+  }
+  b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+void SetElements(benchmark::State &state, int n) {
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+void SetFlops(benchmark::State &state, double flops) {
+  state.counters["FLOPS"] =
+      benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// --- Создание, копирование и перемещение ---
+
+void BM_Construct(benchmark::State &state) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    S21Matrix matrix(n, n);
+    benchmark::DoNotOptimize(matrix.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_Construct)->Apply(Sizes);
+
+void BM_ConstructPooled(benchmark::State &state) {
+  const int n = state.range(0);
+  S21MatrixPool pool;
+  const S21MatrixPoolScope scope(pool);
+  for (auto _ : state) {
+    S21Matrix matrix(n, n);
+    benchmark::DoNotOptimize(matrix.Data());
+  }
+  SetElements(state, n);
+  state.counters["hits"] = static_cast<double>(pool.Stats().hits);
+}
+BENCHMARK(BM_ConstructPooled)->Apply(Sizes);
+
+void BM_Copy(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix source = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix copy(source);
+    benchmark::DoNotOptimize(copy.Data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+}
+BENCHMARK(BM_Copy)->Apply(Sizes);
+
+void BM_CopyAssign(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix source = RandomMatrix(n, n);
+  S21Matrix target(n, n);
+  for (auto _ : state) {
+    target = source;
+    benchmark::DoNotOptimize(target.Data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+}
+BENCHMARK(BM_CopyAssign)->Apply(Sizes);
+
+void BM_Move(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix source = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(source));
+    source = std::move(moved);
+    benchmark::DoNotOptimize(source.Data());
+  }
+}
+BENCHMARK(BM_Move)->Apply(Sizes);
+
+// --- Поэлементные операции ---
+
+void BM_Add(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    a += b;
+    benchmark::DoNotOptimize(a.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_Add)->Apply(Sizes);
+
+void BM_Sub(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    a -= b;
+    benchmark::DoNotOptimize(a.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_Sub)->Apply(Sizes);
+
+void BM_AddFloat(benchmark::State &state) {
+  const int n = state.range(0);
+  S21BasicMatrix<float> a = RandomMatrix<float>(n, n);
+  const S21BasicMatrix<float> b = RandomMatrix<float>(n, n);
+  for (auto _ : state) {
+    a += b;
+    benchmark::DoNotOptimize(a.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_AddFloat)->Apply(Sizes);
+
+void BM_MulNumber(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    a *= 1.0000001;
+    benchmark::DoNotOptimize(a.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_MulNumber)->Apply(Sizes);
+
+void BM_Expression(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  const S21Matrix c = RandomMatrix(n, n);
+  S21Matrix result(n, n);
+  for (auto _ : state) {
+    result = a + b * 2.0 - c;
+    benchmark::DoNotOptimize(result.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_Expression)->Apply(Sizes);
+
+void BM_Equal(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b(a);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a == b);
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_Equal)->Apply(Sizes);
+
+// --- Произведение, транспонирование, определитель, обратная ---
+
+void BM_Gemm(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_Gemm)->Apply(Sizes);
+
+void BM_GemmFloat(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21BasicMatrix<float> a = RandomMatrix<float>(n, n);
+  const S21BasicMatrix<float> b = RandomMatrix<float>(n, n);
+  for (auto _ : state) {
+    S21BasicMatrix<float> c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_GemmFloat)->Apply(Sizes);
+
+/**
+ * @brief Размер x режим умножения: 0 - kAccurate, 1 - kFast
+ */
+void StrassenSizes(benchmark::internal::Benchmark *b) {
+  for (int n : {1024, 2048, 4096}) {
+    b->Args({n, 0});
+    b->Args({n, 1});
+  }
+  b->Unit(benchmark::kMillisecond);
+}
+
+/**
+ * @brief Произведение в заданном режиме: сравнение алгоритма Штрассена с
+ * блочным ядром
+ */
+void BM_GemmStrassen(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21MultiplyMode mode = S21GetMultiplyMode();
+  S21SetMultiplyMode(state.range(1) ? S21MultiplyMode::kFast
+                                    : S21MultiplyMode::kAccurate);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+  S21SetMultiplyMode(mode);
+}
+BENCHMARK(BM_GemmStrassen)->Apply(StrassenSizes);
+
+void BM_GemmComplex(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21BasicMatrix<std::complex<double> > a =
+      RandomMatrix<std::complex<double> >(n, n);
+  const S21BasicMatrix<std::complex<double> > b =
+      RandomMatrix<std::complex<double> >(n, n);
+  for (auto _ : state) {
+    S21BasicMatrix<std::complex<double> > c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  // Комплексное умножение со сложением - 8 вещественных операций
+  SetFlops(state, 8.0 * n * n * n);
+}
+BENCHMARK(BM_GemmComplex)->Apply(NaiveSizes);
+
+/**
+ * @brief Базовая линия: тройной цикл i-j-k через operator()
+ */
+void BM_NaiveGemm(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix c(n, n);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        double sum = 0.0;
+        for (int k = 0; k < n; ++k) {
+          sum += a(i, k) * b(k, j);
+        }
+        c(i, j) = sum;
+      }
+    }
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_NaiveGemm)->Apply(NaiveSizes);
+
+void BM_MulMatrixAssign(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    state.PauseTiming();
+    S21Matrix c(a);
+    state.ResumeTiming();
+    c *= b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_MulMatrixAssign)->Apply(Sizes);
+
+void BM_AccumulateProduct(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  S21Matrix c(n, n);
+  for (auto _ : state) {
+    c += a.Transpose() * b * 2.0;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_AccumulateProduct)->Apply(Sizes);
+
+void BM_FusedGemm(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  S21Matrix c(n, n);
+  for (auto _ : state) {
+    S21Gemm(2.0, a, S21Transpose::kTrans, b, S21Transpose::kNoTrans, 1.0, &c);
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_FusedGemm)->Apply(Sizes);
+
+void BM_Transpose(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix t = a.Transpose();
+    benchmark::DoNotOptimize(t.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_Transpose)->Apply(Sizes);
+
+void BM_TransposeInPlace(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::DoNotOptimize(a.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_TransposeInPlace)->Apply(Sizes);
+
+/**
+ * @brief Высокая матрица (16n x n): перестановка по циклам
+ */
+void BM_TransposeInPlaceTall(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = RandomMatrix(16 * n, n);
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::DoNotOptimize(a.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * 16 * n * n);
+}
+BENCHMARK(BM_TransposeInPlaceTall)->RangeMultiplier(4)->Range(4, 1024);
+
+void BM_Determinant(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Determinant());
+  }
+  SetFlops(state, 2.0 / 3.0 * n * n * n);
+}
+BENCHMARK(BM_Determinant)->Apply(Sizes);
+
+void BM_InverseMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_InverseMatrix)->Apply(Sizes);
+
+// --- Матрицы фиксированного размера ---
+
+/**
+ * @brief Произведение и обращение 4 x 4: S21Matrix4 против S21Matrix того
+ * же размера
+ */
+void BM_FixedMatrix4(benchmark::State &state) {
+  const S21Matrix4 a(RandomMatrix(4, 4));
+  const S21Matrix4 b(RandomMatrix(4, 4));
+  for (auto _ : state) {
+    S21Matrix4 c = (a * b).InverseMatrix();
+    benchmark::DoNotOptimize(c.Data());
+  }
+}
+BENCHMARK(BM_FixedMatrix4);
+
+void BM_DynamicMatrix4(benchmark::State &state) {
+  const S21Matrix a = RandomMatrix(4, 4);
+  const S21Matrix b = RandomMatrix(4, 4);
+  for (auto _ : state) {
+    S21Matrix c = (a * b).InverseMatrix();
+    benchmark::DoNotOptimize(c.Data());
+  }
+}
+BENCHMARK(BM_DynamicMatrix4);
+
+// --- Разреженные матрицы ---
+
+/**
+ * @brief Разреженная матрица n x n с per_row ненулевыми элементами из
+ * [-1, 1] в случайных столбцах каждой строки
+ */
+S21SparseMatrix RandomSparse(int n, int per_row) {
+  static std::mt19937 generator(21);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::uniform_int_distribution<int> column(0, n - 1);
+  std::vector<S21SparseMatrix::Triplet> triplets;
+  for (int i = 0; i < n; ++i) {
+    for (int k = 0; k < per_row; ++k) {
+      triplets.push_back({i, column(generator), value(generator)});
+    }
+  }
+  return S21SparseMatrix(n, n, triplets);
+}
+
+void SparseSizes(benchmark::internal::Benchmark *b) {
+  for (int n = 1024; n <= 65536; n *= 4) {
+    b->Arg(n);
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+/**
+ * @brief Разреженная n x n (16 элементов в строке) на плотную n x 64
+ */
+void BM_SparseDense(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21SparseMatrix a = RandomSparse(n, 16);
+  const S21Matrix b = RandomMatrix(n, 64);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * a.NonZeros() * b.Cols());
+}
+BENCHMARK(BM_SparseDense)->Apply(SparseSizes);
+
+/**
+ * @brief Произведение разреженных n x n по 16 элементов в строке
+ */
+void BM_SparseSparse(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21SparseMatrix a = RandomSparse(n, 16);
+  const S21SparseMatrix b = RandomSparse(n, 16);
+  for (auto _ : state) {
+    S21SparseMatrix c = a * b;
+    benchmark::DoNotOptimize(c.Values().data());
+  }
+  SetFlops(state, 2.0 * a.NonZeros() * 16);
+}
+BENCHMARK(BM_SparseSparse)->Apply(SparseSizes);
+
+// --- Двоичный формат ---
+
+const char kBenchFile[] = "bench_matrix.s21m";
+
+void BM_SaveMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21SaveMatrix(kBenchFile, a);
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(kBenchFile);
+}
+BENCHMARK(BM_SaveMatrix)->Apply(Sizes);
+
+void BM_LoadMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  S21SaveMatrix(kBenchFile, RandomMatrix(n, n));
+  for (auto _ : state) {
+    S21Matrix a = S21LoadMatrix(kBenchFile);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * n * sizeof(double));
+  std::remove(kBenchFile);
+}
+BENCHMARK(BM_LoadMatrix)->Apply(Sizes);
+
+/**
+ * @brief Открытие отображённого файла: не зависит от размера матрицы
+ */
+void BM_MapMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  S21SaveMatrix(kBenchFile, RandomMatrix(n, n));
+  for (auto _ : state) {
+    S21MappedMatrix a(kBenchFile);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  std::remove(kBenchFile);
+}
+BENCHMARK(BM_MapMatrix)->Apply(Sizes);
+
+// --- Текстовые форматы ---
+
+const char kBenchCsv[] = "bench_matrix.csv";
+
+void BM_WriteCsv(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    std::ofstream stream(kBenchCsv, std::ios::binary | std::ios::trunc);
+    S21WriteCsv(stream, a);
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+  std::remove(kBenchCsv);
+}
+BENCHMARK(BM_WriteCsv)->Apply(Sizes);
+
+void BM_ReadCsv(benchmark::State &state) {
+  const int n = state.range(0);
+  {
+    std::ofstream stream(kBenchCsv, std::ios::binary | std::ios::trunc);
+    S21WriteCsv(stream, RandomMatrix(n, n));
+  }
+  for (auto _ : state) {
+    S21Matrix a = S21ReadCsv(kBenchCsv);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+  std::remove(kBenchCsv);
+}
+BENCHMARK(BM_ReadCsv)->Apply(Sizes);
+
+// --- Наборы маленьких матриц ---
+
+const int kBatchSize = 1 << 16;
+
+/**
+ * @brief Порядок матриц: 3, 4, 6, 8
+ */
+void BatchSizes(benchmark::internal::Benchmark *b) {
+  for (int n : {3, 4, 6, 8}) {
+    b->Arg(n);
+  }
+  b->Unit(benchmark::kMillisecond);
+}
+
+S21MatrixBatch RandomBatch(int n) {
+  S21MatrixBatch batch(kBatchSize, n, n);
+  for (int index = 0; index < kBatchSize; ++index) {
+    batch.Set(index, RandomMatrix(n, n));
+  }
+  return batch;
+}
+
+std::vector<S21Matrix> RandomMatrices(int n) {
+  std::vector<S21Matrix> matrices;
+  for (int index = 0; index < kBatchSize; ++index) {
+    matrices.push_back(RandomMatrix(n, n));
+  }
+  return matrices;
+}
+
+void BM_BatchMultiply(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21MatrixBatch a = RandomBatch(n);
+  const S21MatrixBatch b = RandomBatch(n);
+  for (auto _ : state) {
+    S21MatrixBatch c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_BatchMultiply)->Apply(BatchSizes);
+
+/**
+ * @brief То же по одной матрице: для сравнения с BM_BatchMultiply
+ */
+void BM_LoopMultiply(benchmark::State &state) {
+  const int n = state.range(0);
+  const std::vector<S21Matrix> a = RandomMatrices(n);
+  const std::vector<S21Matrix> b = RandomMatrices(n);
+  for (auto _ : state) {
+    for (int index = 0; index < kBatchSize; ++index) {
+      S21Matrix c = a[index] * b[index];
+      benchmark::DoNotOptimize(c.Data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_LoopMultiply)->Apply(BatchSizes);
+
+void BM_BatchInverse(benchmark::State &state) {
+  const S21MatrixBatch a = RandomBatch(state.range(0));
+  for (auto _ : state) {
+    S21MatrixBatch inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_BatchInverse)->Apply(BatchSizes);
+
+void BM_LoopInverse(benchmark::State &state) {
+  const std::vector<S21Matrix> a = RandomMatrices(state.range(0));
+  for (auto _ : state) {
+    for (const S21Matrix &matrix : a) {
+      S21Matrix inverse = matrix.InverseMatrix();
+      benchmark::DoNotOptimize(inverse.Data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_LoopInverse)->Apply(BatchSizes);
+
+void BM_BatchDeterminant(benchmark::State &state) {
+  const S21MatrixBatch a = RandomBatch(state.range(0));
+  for (auto _ : state) {
+    std::vector<double> det = a.Determinant();
+    benchmark::DoNotOptimize(det.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_BatchDeterminant)->Apply(BatchSizes);
+
+// --- Масштабирование по потокам ---
+
+/**
+ * @brief Устанавливает число потоков на время замера и восстанавливает
+ * прежнее значение
+ */
+class ThreadCountGuard {
+ public:
+  explicit ThreadCountGuard(int threads) : previous_(S21GetThreadCount()) {
+    S21SetThreadCount(threads);
+  }
+  ~ThreadCountGuard() { S21SetThreadCount(previous_); }
+
+ private:
+  int previous_;
+};
+
+void BM_GemmThreads(benchmark::State &state) {
+  const int n = state.range(0);
+  const ThreadCountGuard guard(state.range(1));
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_GemmThreads)->Apply(ThreadCounts);
+
+void BM_InverseMatrixThreads(benchmark::State &state) {
+  const int n = state.range(0);
+  const ThreadCountGuard guard(state.range(1));
+  const S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_InverseMatrixThreads)->Apply(ThreadCounts);
+
+void BM_AddThreads(benchmark::State &state) {
+  const int n = state.range(0);
+  const ThreadCountGuard guard(state.range(1));
+  S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    a += b;
+    benchmark::DoNotOptimize(a.Data());
+  }
+  SetElements(state, n);
+}
+BENCHMARK(BM_AddThreads)->Apply(ThreadCounts);
+
+// --- Внешние BLAS и LAPACK ---
+
+/**
+ * @brief Размер x реализация: 0 - kNative, 1 - kBlas (без BLAS обе
+ * строки считают собственные ядра)
+ */
+void BackendSizes(benchmark::internal::Benchmark *b) {
+  for (int n : {16, 32, 64, 128, 256, 512, 1024}) {
+    b->Args({n, 0});
+    b->Args({n, 1});
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+/**
+ * @brief Выбирает реализацию на время замера и восстанавливает прежнюю
+ */
+class BackendGuard {
+ public:
+  explicit BackendGuard(int backend) : previous_(S21GetBackend()) {
+    S21SetBackend(backend == 0 ? S21Backend::kNative : S21Backend::kBlas);
+  }
+  ~BackendGuard() { S21SetBackend(previous_); }
+
+ private:
+  S21Backend previous_;
+};
+
+void BM_GemmBackend(benchmark::State &state) {
+  const int n = state.range(0);
+  const BackendGuard guard(state.range(1));
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix c = a * b;
+    benchmark::DoNotOptimize(c.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_GemmBackend)->Apply(BackendSizes);
+
+void BM_InverseBackend(benchmark::State &state) {
+  const int n = state.range(0);
+  const BackendGuard guard(state.range(1));
+  const S21Matrix a = RandomMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_InverseBackend)->Apply(BackendSizes);
+
+void BM_SolveBackend(benchmark::State &state) {
+  const int n = state.range(0);
+  const BackendGuard guard(state.range(1));
+  const S21Matrix a = RandomMatrix(n, n);
+  const S21Matrix b = RandomMatrix(n, 16);
+  for (auto _ : state) {
+    S21Matrix x = a.Solve(b, S21MatrixStructure::kGeneral);
+    benchmark::DoNotOptimize(x.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n / 3.0 + 2.0 * n * n * 16);
+}
+BENCHMARK(BM_SolveBackend)->Apply(BackendSizes);
+
+// --- Симметричные матрицы и QR ---
+
+/**
+ * @brief Симметричная положительно определённая матрица B * B^T + n * I
+ */
+S21Matrix SpdMatrix(int n) {
+  const S21Matrix b = RandomMatrix(n, n);
+  S21Matrix a = b * b.Transpose();
+  for (int i = 0; i < n; ++i) {
+    a(i, i) += n;
+  }
+  return a;
+}
+
+/**
+ * @brief Размер x матрица: 0 - общего вида (LU), 1 - симметричная
+ * положительно определённая (Холецкий)
+ */
+void SymmetricSizes(benchmark::internal::Benchmark *b) {
+  for (int n : {64, 128, 256, 512, 1024}) {
+    b->Args({n, 0});
+    b->Args({n, 1});
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+void BM_InverseSymmetric(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = state.range(1) == 0 ? RandomMatrix(n, n) : SpdMatrix(n);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_InverseSymmetric)->Apply(SymmetricSizes);
+
+/**
+ * @brief Одна и та же симметричная матрица: kGeneral против kAuto
+ */
+void BM_SolveSymmetric(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = SpdMatrix(n);
+  const S21Matrix b = RandomMatrix(n, 16);
+  const S21MatrixStructure structure = state.range(1) == 0
+                                           ? S21MatrixStructure::kGeneral
+                                           : S21MatrixStructure::kAuto;
+  for (auto _ : state) {
+    S21Matrix x = a.Solve(b, structure);
+    benchmark::DoNotOptimize(x.Data());
+  }
+  SetFlops(state, 2.0 * n * n * n / 3.0 + 2.0 * n * n * 16);
+}
+BENCHMARK(BM_SolveSymmetric)->Apply(SymmetricSizes);
+
+/**
+ * @brief Наименьшие квадраты для матрицы 2n x n: 0 - нормальные уравнения
+ * A^T * A * X = A^T * b, 1 - QR-разложение
+ */
+void BM_LeastSquares(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = RandomMatrix(2 * n, n);
+  const S21Matrix b = RandomMatrix(2 * n, 4);
+  for (auto _ : state) {
+    if (state.range(1) == 0) {
+      const S21Matrix a_t = a.Transpose();
+      S21Matrix x = (a_t * a).Solve(a_t * b);
+      benchmark::DoNotOptimize(x.Data());
+    } else {
+      S21Matrix x = a.LeastSquares(b);
+      benchmark::DoNotOptimize(x.Data());
+    }
+  }
+}
+BENCHMARK(BM_LeastSquares)->Apply(SymmetricSizes);
+
+// --- Обновления малого ранга ---
+
+/**
+ * @brief Шаг онлайн-оценки: заменить строку и получить обратную матрицу.
+ * 0 - InverseMatrix() заново, 1 - S21CachedInverse::ReplaceRow
+ */
+void BM_ReplaceRowInverse(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = RandomMatrix(n, n);
+  S21CachedInverse cache(a);
+  int index = 0;
+  for (auto _ : state) {
+    const S21Matrix row = RandomMatrix(1, n);
+    if (state.range(1) == 0) {
+      for (int j = 0; j < n; ++j) {
+        a(index, j) = row(0, j);
+      }
+      S21Matrix inverse = a.InverseMatrix();
+      benchmark::DoNotOptimize(inverse.Data());
+    } else {
+      cache.ReplaceRow(index, row);
+      benchmark::DoNotOptimize(cache.Inverse().Data());
+    }
+    index = (index + 1) % n;
+  }
+}
+BENCHMARK(BM_ReplaceRowInverse)->Apply(SymmetricSizes);
+
+/**
+ * @brief Обновление ранга 1 разложения Холецкого: 0 - новое разложение
+ * A + x * x^T, 1 - S21Cholesky::Update
+ */
+void BM_CholeskyUpdate(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = SpdMatrix(n);
+  const S21Matrix x = RandomMatrix(n, 1);
+  S21Cholesky cholesky = a.Cholesky();
+  for (auto _ : state) {
+    if (state.range(1) == 0) {
+      S21Cholesky fresh = (a + x * x.Transpose()).Cholesky();
+      benchmark::DoNotOptimize(fresh.Factors().Data());
+    } else {
+      cholesky.Update(x);
+      benchmark::DoNotOptimize(cholesky.Factors().Data());
+    }
+  }
+}
+BENCHMARK(BM_CholeskyUpdate)->Apply(SymmetricSizes);
+
+}  // namespace
+
+BENCHMARK_MAIN();
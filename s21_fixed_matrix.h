@@ -0,0 +1,425 @@
+#ifndef SRC_S21_FIXED_MATRIX_H
+#define SRC_S21_FIXED_MATRIX_H
+
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Матрица R x C с размерностью, известной при компиляции
+ *
+ * @details Элементы хранятся построчно во встроенном std::array, поэтому
+ * матрица не обращается к куче и может жить на стеке. Несовпадение
+ * размерностей операндов - ошибка компиляции. Все операции, кроме
+ * преобразований в S21Matrix и из неё, - constexpr. Произведение
+ * разворачивается полностью; определитель и обратная матрица для n <= 4
+ * считаются по явным формулам, для больших n - методом Гаусса с выбором
+ * ведущего элемента.
+ */
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Matrix dimensions must be positive.");
+
+ public:
+  static constexpr double kEpsilon = 1.0e-6;
+
+  constexpr S21FixedMatrix() : data_() {}
+
+  /**
+   * @brief Матрица из R * C чисел, перечисленных построчно
+   */
+  template <class... T,
+            class = typename std::enable_if<
+                std::conjunction<std::is_arithmetic<T>...>::value>::type>
+  constexpr S21FixedMatrix(T... values)
+      : data_{{static_cast<double>(values)...}} {
+    static_assert(sizeof...(T) == R * C,
+                  "Number of values must match the matrix size.");
+  }
+
+  /**
+   * @brief Копирует S21Matrix такой же размерности
+   *
+   * @throw std::invalid_argument если размерность matrix не R x C
+   */
+  explicit S21FixedMatrix(const S21Matrix &matrix) : data_() {
+    if (matrix.Rows() != R || matrix.Cols() != C) {
+      throw std::invalid_argument(
+          "Matrix dimensions do not match the fixed size.");
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        At(i, j) = matrix.At(i, j);
+      }
+    }
+  }
+
+  explicit operator S21Matrix() const { return ToMatrix(); }
+
+  S21Matrix ToMatrix() const { return S21Matrix(R, C, data_.data()); }
+
+  /**
+   * @brief Представление для операций S21Matrix над этой матрицей
+   */
+  S21MatrixView View() const {
+    return S21MatrixView(data_.data(), R, C, C, 1);
+  }
+
+  static constexpr S21FixedMatrix Identity() {
+    static_assert(R == C, "Identity is only defined for square matrices.");
+    S21FixedMatrix identity;
+    for (int i = 0; i < R; ++i) {
+      identity.At(i, i) = 1.0;
+    }
+    return identity;
+  }
+
+  static constexpr int Rows() { return R; }
+  static constexpr int Cols() { return C; }
+  static constexpr bool IsSquare() { return R == C; }
+  constexpr const double *Data() const { return data_.data(); }
+  constexpr double *Data() { return data_.data(); }
+
+  /**
+   * @brief Элемент без проверки индексов
+   */
+  constexpr double &At(int row, int col) { return data_[row * C + col]; }
+  constexpr const double &At(int row, int col) const {
+    return data_[row * C + col];
+  }
+
+  /**
+   * @brief Элемент с проверкой индексов
+   *
+   * @throw std::out_of_range если индекс выходит за границы
+   */
+  constexpr double &operator()(int row, int col) {
+    CheckIndex(row, col);
+    return At(row, col);
+  }
+  constexpr const double &operator()(int row, int col) const {
+    CheckIndex(row, col);
+    return At(row, col);
+  }
+
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const {
+    for (int i = 0; i < R * C; ++i) {
+      if (Abs(data_[i] - other.data_[i]) > kEpsilon) {
+        return false;
+      }
+    }
+    return true;
+  }
+  constexpr bool operator==(const S21FixedMatrix &other) const {
+    return EqMatrix(other);
+  }
+  constexpr bool operator!=(const S21FixedMatrix &other) const {
+    return !EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &other) {
+    for (int i = 0; i < R * C; ++i) {
+      data_[i] += other.data_[i];
+    }
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &other) {
+    for (int i = 0; i < R * C; ++i) {
+      data_[i] -= other.data_[i];
+    }
+    return *this;
+  }
+  constexpr S21FixedMatrix &operator*=(double number) {
+    for (int i = 0; i < R * C; ++i) {
+      data_[i] *= number;
+    }
+    return *this;
+  }
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    return result += other;
+  }
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    return result -= other;
+  }
+  constexpr S21FixedMatrix operator*(double number) const {
+    S21FixedMatrix result(*this);
+    return result *= number;
+  }
+  friend constexpr S21FixedMatrix operator*(double number,
+                                            const S21FixedMatrix &matrix) {
+    return matrix * number;
+  }
+
+  /**
+   * @brief Произведение (R x C) * (C x K): каждый элемент результата -
+   * развёрнутая на этапе компиляции сумма из C произведений
+   */
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K> &other) const {
+    return Multiply(other, std::make_integer_sequence<int, R * K>());
+  }
+
+  constexpr S21FixedMatrix &operator*=(const S21FixedMatrix<C, C> &other) {
+    return *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<C, R> Transpose() const {
+    S21FixedMatrix<C, R> result;
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        result.At(j, i) = At(i, j);
+      }
+    }
+    return result;
+  }
+
+  constexpr double Determinant() const {
+    static_assert(R == C, "Determinant is only defined for square matrices.");
+    if constexpr (R == 1) {
+      return At(0, 0);
+    } else if constexpr (R == 2) {
+      return At(0, 0) * At(1, 1) - At(0, 1) * At(1, 0);
+    } else if constexpr (R == 3) {
+      return At(0, 0) * (At(1, 1) * At(2, 2) - At(1, 2) * At(2, 1)) -
+             At(0, 1) * (At(1, 0) * At(2, 2) - At(1, 2) * At(2, 0)) +
+             At(0, 2) * (At(1, 0) * At(2, 1) - At(1, 1) * At(2, 0));
+    } else if constexpr (R == 4) {
+      const Minors4 m = ComputeMinors4();
+      return m.s[0] * m.c[5] - m.s[1] * m.c[4] + m.s[2] * m.c[3] +
+             m.s[3] * m.c[2] - m.s[4] * m.c[1] + m.s[5] * m.c[0];
+    } else {
+      return EliminationDeterminant();
+    }
+  }
+
+  /**
+   * @brief Обратная матрица
+   *
+   * @throw std::invalid_argument если матрица вырождена
+   */
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "Inverse is only defined for square matrices.");
+    if constexpr (R <= 4) {
+      const double det = Determinant();
+      double scale = MaxAbs();
+      for (int i = 1; i < R; ++i) {
+        scale *= MaxAbs();
+      }
+      if (Abs(det) <= R * kMachineEpsilon * scale) {
+        throw std::invalid_argument(
+            "Matrix is singular and cannot be inverted.");
+      }
+      S21FixedMatrix result = Adjugate();
+      return result *= 1.0 / det;
+    } else {
+      return EliminationInverse();
+    }
+  }
+
+ private:
+  template <int, int>
+  friend class S21FixedMatrix;
+
+  static constexpr double kMachineEpsilon = 2.220446049250313e-16;
+
+  static constexpr double Abs(double value) {
+    return value < 0.0 ? -value : value;
+  }
+
+  constexpr void CheckIndex(int row, int col) const {
+    if (row < 0 || row >= R || col < 0 || col >= C) {
+      throw std::out_of_range("Matrix index out of range.");
+    }
+  }
+
+  constexpr double MaxAbs() const {
+    double max_abs = 0.0;
+    for (int i = 0; i < R * C; ++i) {
+      max_abs = Abs(data_[i]) > max_abs ? Abs(data_[i]) : max_abs;
+    }
+    return max_abs;
+  }
+
+  template <int K, int... I>
+  constexpr S21FixedMatrix<R, K> Multiply(
+      const S21FixedMatrix<C, K> &other,
+      std::integer_sequence<int, I...>) const {
+    return S21FixedMatrix<R, K>(
+        Dot(other, I / K, I % K, std::make_integer_sequence<int, C>())...);
+  }
+
+  template <int K, int... P>
+  constexpr double Dot(const S21FixedMatrix<C, K> &other, int row, int col,
+                       std::integer_sequence<int, P...>) const {
+    return (0.0 + ... + (At(row, P) * other.At(P, col)));
+  }
+
+  /**
+   * @brief Определители 2 x 2 из двух верхних (s) и двух нижних (c) строк
+   * матрицы 4 x 4: через них выражаются определитель и все алгебраические
+   * дополнения
+   */
+  struct Minors4 {
+    double s[6];
+    double c[6];
+  };
+
+  constexpr Minors4 ComputeMinors4() const {
+    const auto &a = *this;
+    return Minors4{{a.At(0, 0) * a.At(1, 1) - a.At(1, 0) * a.At(0, 1),
+                    a.At(0, 0) * a.At(1, 2) - a.At(1, 0) * a.At(0, 2),
+                    a.At(0, 0) * a.At(1, 3) - a.At(1, 0) * a.At(0, 3),
+                    a.At(0, 1) * a.At(1, 2) - a.At(1, 1) * a.At(0, 2),
+                    a.At(0, 1) * a.At(1, 3) - a.At(1, 1) * a.At(0, 3),
+                    a.At(0, 2) * a.At(1, 3) - a.At(1, 2) * a.At(0, 3)},
+                   {a.At(2, 0) * a.At(3, 1) - a.At(3, 0) * a.At(2, 1),
+                    a.At(2, 0) * a.At(3, 2) - a.At(3, 0) * a.At(2, 2),
+                    a.At(2, 0) * a.At(3, 3) - a.At(3, 0) * a.At(2, 3),
+                    a.At(2, 1) * a.At(3, 2) - a.At(3, 1) * a.At(2, 2),
+                    a.At(2, 1) * a.At(3, 3) - a.At(3, 1) * a.At(2, 3),
+                    a.At(2, 2) * a.At(3, 3) - a.At(3, 2) * a.At(2, 3)}};
+  }
+
+  /**
+   * @brief Присоединённая матрица (транспонированная матрица
+   * алгебраических дополнений) для n <= 4
+   */
+  constexpr S21FixedMatrix Adjugate() const {
+    const auto &a = *this;
+    if constexpr (R == 1) {
+      return S21FixedMatrix(1.0);
+    } else if constexpr (R == 2) {
+      return S21FixedMatrix(a.At(1, 1), -a.At(0, 1), -a.At(1, 0), a.At(0, 0));
+    } else if constexpr (R == 3) {
+      return S21FixedMatrix(
+          a.At(1, 1) * a.At(2, 2) - a.At(1, 2) * a.At(2, 1),
+          a.At(0, 2) * a.At(2, 1) - a.At(0, 1) * a.At(2, 2),
+          a.At(0, 1) * a.At(1, 2) - a.At(0, 2) * a.At(1, 1),
+          a.At(1, 2) * a.At(2, 0) - a.At(1, 0) * a.At(2, 2),
+          a.At(0, 0) * a.At(2, 2) - a.At(0, 2) * a.At(2, 0),
+          a.At(0, 2) * a.At(1, 0) - a.At(0, 0) * a.At(1, 2),
+          a.At(1, 0) * a.At(2, 1) - a.At(1, 1) * a.At(2, 0),
+          a.At(0, 1) * a.At(2, 0) - a.At(0, 0) * a.At(2, 1),
+          a.At(0, 0) * a.At(1, 1) - a.At(0, 1) * a.At(1, 0));
+    } else {
+      const Minors4 m = ComputeMinors4();
+      const double *s = m.s;
+      const double *c = m.c;
+      return S21FixedMatrix(
+          a.At(1, 1) * c[5] - a.At(1, 2) * c[4] + a.At(1, 3) * c[3],
+          -a.At(0, 1) * c[5] + a.At(0, 2) * c[4] - a.At(0, 3) * c[3],
+          a.At(3, 1) * s[5] - a.At(3, 2) * s[4] + a.At(3, 3) * s[3],
+          -a.At(2, 1) * s[5] + a.At(2, 2) * s[4] - a.At(2, 3) * s[3],
+          -a.At(1, 0) * c[5] + a.At(1, 2) * c[2] - a.At(1, 3) * c[1],
+          a.At(0, 0) * c[5] - a.At(0, 2) * c[2] + a.At(0, 3) * c[1],
+          -a.At(3, 0) * s[5] + a.At(3, 2) * s[2] - a.At(3, 3) * s[1],
+          a.At(2, 0) * s[5] - a.At(2, 2) * s[2] + a.At(2, 3) * s[1],
+          a.At(1, 0) * c[4] - a.At(1, 1) * c[2] + a.At(1, 3) * c[0],
+          -a.At(0, 0) * c[4] + a.At(0, 1) * c[2] - a.At(0, 3) * c[0],
+          a.At(3, 0) * s[4] - a.At(3, 1) * s[2] + a.At(3, 3) * s[0],
+          -a.At(2, 0) * s[4] + a.At(2, 1) * s[2] - a.At(2, 3) * s[0],
+          -a.At(1, 0) * c[3] + a.At(1, 1) * c[1] - a.At(1, 2) * c[0],
+          a.At(0, 0) * c[3] - a.At(0, 1) * c[1] + a.At(0, 2) * c[0],
+          -a.At(3, 0) * s[3] + a.At(3, 1) * s[1] - a.At(3, 2) * s[0],
+          a.At(2, 0) * s[3] - a.At(2, 1) * s[1] + a.At(2, 2) * s[0]);
+    }
+  }
+
+  /**
+   * @brief Индекс строки с наибольшим по модулю элементом столбца k среди
+   * строк k..R-1
+   */
+  constexpr int PivotRow(int k) const {
+    int pivot = k;
+    for (int i = k + 1; i < R; ++i) {
+      if (Abs(At(i, k)) > Abs(At(pivot, k))) {
+        pivot = i;
+      }
+    }
+    return pivot;
+  }
+
+  constexpr void SwapRows(int lhs, int rhs) {
+    for (int j = 0; j < C; ++j) {
+      const double value = At(lhs, j);
+      At(lhs, j) = At(rhs, j);
+      At(rhs, j) = value;
+    }
+  }
+
+  constexpr double EliminationDeterminant() const {
+    S21FixedMatrix a(*this);
+    double det = 1.0;
+    for (int k = 0; k < R; ++k) {
+      const int pivot = a.PivotRow(k);
+      if (a.At(pivot, k) == 0.0) {
+        return 0.0;
+      }
+      if (pivot != k) {
+        a.SwapRows(pivot, k);
+        det = -det;
+      }
+      det *= a.At(k, k);
+      for (int i = k + 1; i < R; ++i) {
+        const double factor = a.At(i, k) / a.At(k, k);
+        for (int j = k + 1; j < R; ++j) {
+          a.At(i, j) -= factor * a.At(k, j);
+        }
+      }
+    }
+    return det;
+  }
+
+  /**
+   * @brief Обращение методом Гаусса - Жордана с частичным выбором
+   * ведущего элемента
+   *
+   * @throw std::invalid_argument если модуль ведущего элемента не
+   * превосходит n * eps * max|a_ij|
+   */
+  constexpr S21FixedMatrix EliminationInverse() const {
+    const double tolerance = R * kMachineEpsilon * MaxAbs();
+    S21FixedMatrix a(*this);
+    S21FixedMatrix inverse = Identity();
+    for (int k = 0; k < R; ++k) {
+      const int pivot = a.PivotRow(k);
+      if (Abs(a.At(pivot, k)) <= tolerance) {
+        throw std::invalid_argument(
+            "Matrix is singular and cannot be inverted.");
+      }
+      a.SwapRows(pivot, k);
+      inverse.SwapRows(pivot, k);
+      const double inv_pivot = 1.0 / a.At(k, k);
+      for (int j = 0; j < C; ++j) {
+        a.At(k, j) *= inv_pivot;
+        inverse.At(k, j) *= inv_pivot;
+      }
+      for (int i = 0; i < R; ++i) {
+        if (i == k) {
+          continue;
+        }
+        const double factor = a.At(i, k);
+        for (int j = 0; j < C; ++j) {
+          a.At(i, j) -= factor * a.At(k, j);
+          inverse.At(i, j) -= factor * inverse.At(k, j);
+        }
+      }
+    }
+    return inverse;
+  }
+
+  std::array<double, R * C> data_;
+};
+
+typedef S21FixedMatrix<2, 2> S21Matrix2;
+typedef S21FixedMatrix<3, 3> S21Matrix3;
+typedef S21FixedMatrix<4, 4> S21Matrix4;
+typedef S21FixedMatrix<6, 6> S21Matrix6;
+
+#endif  // SRC_S21_FIXED_MATRIX_H
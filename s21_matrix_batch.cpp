@@ -0,0 +1,579 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_pool.h"
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace detail {
+namespace {
+
+const int kLanes = S21BasicMatrixBatch<double>::kLanes;
+
+// Ядра ниже работают с одной группой из kLanes матриц. Внутренний цикл
+// каждого из них идёт по матрицам группы и не содержит переходов, поэтому
+// компилятор превращает его в векторные инструкции того набора, для
+// которого собрана обёртка (см. SelectBatchKernels).
+
+/**
+ * @brief C = A * B для группы матриц: A - n x k, B - k x m
+ */
+template <class T>
+void MultiplyGroup(const T *a, const T *b, T *c, int n, int k, int m) {
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < m; ++j) {
+      T sum[kLanes] = {};
+      for (int p = 0; p < k; ++p) {
+        const T *a_ip = a + (static_cast<std::ptrdiff_t>(i) * k + p) * kLanes;
+        const T *b_pj = b + (static_cast<std::ptrdiff_t>(p) * m + j) * kLanes;
+        for (int l = 0; l < kLanes; ++l) {
+          sum[l] += a_ip[l] * b_pj[l];
+        }
+      }
+      T *c_ij = c + (static_cast<std::ptrdiff_t>(i) * m + j) * kLanes;
+      for (int l = 0; l < kLanes; ++l) {
+        c_ij[l] = sum[l];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Меняет местами строки lhs и rhs длины count в тех матрицах, для
+ * которых mask[l] истинно
+ */
+template <class T>
+void SwapLanes(T *lhs, T *rhs, int count, const bool *mask) {
+  for (int j = 0; j < count; ++j) {
+    for (int l = 0; l < kLanes; ++l) {
+      const T u = lhs[j * kLanes + l];
+      const T v = rhs[j * kLanes + l];
+      lhs[j * kLanes + l] = mask[l] ? v : u;
+      rhs[j * kLanes + l] = mask[l] ? u : v;
+    }
+  }
+}
+
+template <class T>
+void ScaleLanes(T *row, int count, const T *factor) {
+  for (int j = 0; j < count; ++j) {
+    for (int l = 0; l < kLanes; ++l) {
+      row[j * kLanes + l] *= factor[l];
+    }
+  }
+}
+
+/**
+ * @brief dst -= factor * src построчно для каждой матрицы группы
+ */
+template <class T>
+void SubtractLanes(T *dst, const T *src, int count, const T *factor) {
+  for (int j = 0; j < count; ++j) {
+    T value[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      value[l] = src[j * kLanes + l];
+    }
+    for (int l = 0; l < kLanes; ++l) {
+      dst[j * kLanes + l] -= factor[l] * value[l];
+    }
+  }
+}
+
+/**
+ * @brief Исключение Гаусса с выбором ведущего элемента по столбцу,
+ * отдельным для каждой матрицы группы
+ *
+ * @param a Группа матриц порядка n, разрушается
+ * @param x Правые части, n x m на матрицу. Если x == nullptr, выполняется
+ * только прямой ход, иначе исключение Гаусса-Жордана заменяет x решением.
+ * @param det Определители матриц группы
+ * @param singular Признаки вырожденности: модуль какого-либо ведущего
+ * элемента не превосходит n * eps * max|a_ij|, как в S21BasicLU
+ * @details Строки переставляются выбором по маске, а строка с нулевым
+ * ведущим элементом умножается на ноль вместо деления, поэтому вырожденная
+ * матрица группы не мешает остальным и не порождает inf и NaN.
+ */
+template <class T>
+void EliminateGroup(T *a, int n, T *x, int m, T *det, bool *singular) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  const std::ptrdiff_t a_row = static_cast<std::ptrdiff_t>(n) * kLanes;
+  const std::ptrdiff_t x_row = static_cast<std::ptrdiff_t>(m) * kLanes;
+  Real tolerance[kLanes] = {};
+  for (std::ptrdiff_t p = 0; p < n * a_row; p += kLanes) {
+    for (int l = 0; l < kLanes; ++l) {
+      tolerance[l] = std::max(tolerance[l], Real(std::abs(a[p + l])));
+    }
+  }
+  for (int l = 0; l < kLanes; ++l) {
+    tolerance[l] *= n * std::numeric_limits<Real>::epsilon();
+    det[l] = T(1);
+    singular[l] = false;
+  }
+
+  for (int k = 0; k < n; ++k) {
+    T *a_k = a + k * a_row;
+    T *x_k = x + k * x_row;
+    int pivot[kLanes];
+    Real best[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      pivot[l] = k;
+      best[l] = std::abs(a_k[k * kLanes + l]);
+    }
+    for (int i = k + 1; i < n; ++i) {
+      const T *a_ik = a + i * a_row + k * kLanes;
+      for (int l = 0; l < kLanes; ++l) {
+        const Real value = std::abs(a_ik[l]);
+        if (value > best[l]) {
+          best[l] = value;
+          pivot[l] = i;
+        }
+      }
+    }
+    for (int i = k + 1; i < n; ++i) {
+      bool mask[kLanes];
+      bool any = false;
+      for (int l = 0; l < kLanes; ++l) {
+        mask[l] = pivot[l] == i;
+        any = any || mask[l];
+      }
+      if (any) {
+        SwapLanes(a_k + k * kLanes, a + i * a_row + k * kLanes, n - k, mask);
+        if (x != nullptr) {
+          SwapLanes(x_k, x + i * x_row, m, mask);
+        }
+      }
+    }
+
+    T inverse[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      const T d = a_k[k * kLanes + l];
+      det[l] = pivot[l] == k ? det[l] * d : -det[l] * d;
+      singular[l] = singular[l] || std::abs(d) <= tolerance[l];
+      inverse[l] = d == T() ? T() : T(1) / d;
+    }
+    T *a_next = a_k + (k + 1) * kLanes;
+    if (x == nullptr) {
+      for (int i = k + 1; i < n; ++i) {
+        T *a_i = a + i * a_row;
+        T factor[kLanes];
+        for (int l = 0; l < kLanes; ++l) {
+          factor[l] = a_i[k * kLanes + l] * inverse[l];
+        }
+        SubtractLanes(a_i + (k + 1) * kLanes, a_next, n - k - 1, factor);
+      }
+      continue;
+    }
+    ScaleLanes(a_next, n - k - 1, inverse);
+    ScaleLanes(x_k, m, inverse);
+    for (int i = 0; i < n; ++i) {
+      if (i == k) {
+        continue;
+      }
+      T *a_i = a + i * a_row;
+      T factor[kLanes];
+      for (int l = 0; l < kLanes; ++l) {
+        factor[l] = a_i[k * kLanes + l];
+      }
+      SubtractLanes(a_i + (k + 1) * kLanes, a_next, n - k - 1, factor);
+      SubtractLanes(x + i * x_row, x_k, m, factor);
+    }
+  }
+}
+
+template <class T>
+struct BatchKernels {
+  void (*multiply)(const T *a, const T *b, T *c, int n, int k, int m);
+  void (*eliminate)(T *a, int n, T *x, int m, T *det, bool *singular);
+};
+
+template <class T>
+const BatchKernels<T> kScalarBatchKernels = {MultiplyGroup<T>,
+                                             EliminateGroup<T>};
+
+#ifdef S21_SIMD_X86
+// Обёртки встраивают ядра целиком (flatten) и компилируют их под свой
+// набор инструкций: группа из kLanes double занимает два регистра ymm или
+// один zmm.
+template <class T>
+S21_TARGET("avx2,fma")
+__attribute__((flatten)) void MultiplyGroupAvx2(const T *a, const T *b, T *c,
+                                                int n, int k, int m) {
+  MultiplyGroup(a, b, c, n, k, m);
+}
+
+template <class T>
+S21_TARGET("avx2,fma")
+__attribute__((flatten)) void EliminateGroupAvx2(T *a, int n, T *x, int m,
+                                                 T *det, bool *singular) {
+  EliminateGroup(a, n, x, m, det, singular);
+}
+
+template <class T>
+S21_TARGET("avx512f")
+__attribute__((flatten)) void MultiplyGroupAvx512(const T *a, const T *b,
+                                                  T *c, int n, int k, int m) {
+  MultiplyGroup(a, b, c, n, k, m);
+}
+
+template <class T>
+S21_TARGET("avx512f")
+__attribute__((flatten)) void EliminateGroupAvx512(T *a, int n, T *x, int m,
+                                                   T *det, bool *singular) {
+  EliminateGroup(a, n, x, m, det, singular);
+}
+
+template <class T>
+const BatchKernels<T> kAvx2BatchKernels = {MultiplyGroupAvx2<T>,
+                                           EliminateGroupAvx2<T>};
+template <class T>
+const BatchKernels<T> kAvx512BatchKernels = {MultiplyGroupAvx512<T>,
+                                             EliminateGroupAvx512<T>};
+#endif  // S21_SIMD_X86
+
+/**
+ * @brief Ядра по текущему S21GetSimdLevel(); векторные обёртки есть только
+ * для float и double
+ */
+template <class T>
+const BatchKernels<T> &SelectBatchKernels() {
+  return kScalarBatchKernels<T>;
+}
+
+template <class T>
+const BatchKernels<T> &SelectVectorBatchKernels() {
+  switch (S21GetSimdLevel()) {
+#ifdef S21_SIMD_X86
+    case S21SimdLevel::kAvx512:
+      return kAvx512BatchKernels<T>;
+    case S21SimdLevel::kAvx2:
+      return kAvx2BatchKernels<T>;
+#endif
+    default:
+      return kScalarBatchKernels<T>;
+  }
+}
+
+template <>
+const BatchKernels<double> &SelectBatchKernels<double>() {
+  return SelectVectorBatchKernels<double>();
+}
+
+template <>
+const BatchKernels<float> &SelectBatchKernels<float>() {
+  return SelectVectorBatchKernels<float>();
+}
+
+}  // namespace
+}  // namespace detail
+}  // namespace s21
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch()
+    : size_(0), rows_(0), cols_(0), data_(nullptr) {}
+
+/**
+ * @brief Создаёт набор из size нулевых матриц rows x cols
+ *
+ * @throw std::invalid_argument если size, rows или cols отрицательны
+ */
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int size, int rows, int cols)
+    : size_(size), rows_(rows), cols_(cols), data_(nullptr) {
+  if (size < 0 || rows < 0 || cols < 0) {
+    throw std::invalid_argument("Batch dimensions must be non-negative.");
+  }
+  Allocate();
+  std::fill(data_, data_ + Length(), T());
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(const S21BasicMatrixBatch &other)
+    : size_(other.size_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(nullptr) {
+  Allocate();
+  std::copy(other.data_, other.data_ + Length(), data_);
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    S21BasicMatrixBatch &&other) noexcept
+    : size_(other.size_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(other.data_) {
+  other.size_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.data_ = nullptr;
+}
+
+template <class T>
+S21BasicMatrixBatch<T>::~S21BasicMatrixBatch() {
+  s21::detail::FreeBuffer(data_);
+}
+
+template <class T>
+S21BasicMatrixBatch<T> &S21BasicMatrixBatch<T>::operator=(
+    const S21BasicMatrixBatch &other) {
+  if (this != &other) {
+    *this = S21BasicMatrixBatch(other);
+  }
+  return *this;
+}
+
+template <class T>
+S21BasicMatrixBatch<T> &S21BasicMatrixBatch<T>::operator=(
+    S21BasicMatrixBatch &&other) noexcept {
+  if (this != &other) {
+    s21::detail::FreeBuffer(data_);
+    size_ = other.size_;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    data_ = other.data_;
+    other.size_ = 0;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * @brief Выделяет буфер под все группы; пустой набор памяти не занимает
+ *
+ * @throw std::bad_alloc если не удалось выделить память
+ */
+template <class T>
+void S21BasicMatrixBatch<T>::Allocate() {
+  if (Length() > 0) {
+    data_ =
+        static_cast<T *>(s21::detail::AllocateBuffer(Length(), sizeof(T)));
+  }
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::CheckIndex(int index) const {
+  if (index < 0 || index >= size_) {
+    throw std::out_of_range("Batch index out of range.");
+  }
+}
+
+/**
+ * @brief Элемент (i, j) матрицы index
+ *
+ * @throw std::out_of_range если индексы выходят за пределы
+ */
+template <class T>
+T &S21BasicMatrixBatch<T>::operator()(int index, int i, int j) {
+  CheckIndex(index);
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix index out of range.");
+  }
+  return Coeff(index, i, j);
+}
+
+template <class T>
+const T &S21BasicMatrixBatch<T>::operator()(int index, int i, int j) const {
+  CheckIndex(index);
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix index out of range.");
+  }
+  return Coeff(index, i, j);
+}
+
+/**
+ * @brief Копирует матрицу index в обычную матрицу
+ *
+ * @throw std::out_of_range если index выходит за пределы
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  CheckIndex(index);
+  S21BasicMatrix<T> matrix(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      matrix.At(i, j) = Coeff(index, i, j);
+    }
+  }
+  return matrix;
+}
+
+/**
+ * @brief Записывает matrix на место матрицы index
+ *
+ * @throw std::out_of_range если index выходит за пределы
+ * @throw std::invalid_argument если размерность matrix не совпадает с
+ * размерностью матриц набора
+ */
+template <class T>
+void S21BasicMatrixBatch<T>::Set(int index,
+                                 const S21BasicMatrixView<T> &matrix) {
+  CheckIndex(index);
+  if (matrix.Rows() != rows_ || matrix.Cols() != cols_) {
+    throw std::invalid_argument(
+        "Matrix dimensions must match the batch dimensions.");
+  }
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      Coeff(index, i, j) = matrix.Coeff(i, j);
+    }
+  }
+}
+
+template <class T>
+void S21BasicMatrixBatch<T>::Set(int index, const S21BasicMatrix<T> &matrix) {
+  Set(index, S21BasicMatrixView<T>(matrix));
+}
+
+/**
+ * @brief Попарные произведения матриц двух наборов
+ *
+ * @throw std::invalid_argument если размеры наборов различны или число
+ * столбцов матриц *this не равно числу строк матриц other
+ */
+template <class T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator*(
+    const S21BasicMatrixBatch &other) const {
+  if (size_ != other.size_ || cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrices must have compatible dimensions for multiplication.");
+  }
+  S21BasicMatrixBatch result(size_, rows_, other.cols_);
+  if (result.data_ == nullptr) {
+    return result;
+  }
+  const s21::detail::BatchKernels<T> &kernels =
+      s21::detail::SelectBatchKernels<T>();
+  const long long work =
+      static_cast<long long>(Groups()) * rows_ * cols_ * other.cols_ * kLanes;
+  s21::detail::ParallelFor(0, Groups(), work, [&](int first, int last) {
+    for (int g = first; g < last; ++g) {
+      kernels.multiply(Data() + g * GroupLength(),
+                       other.Data() + g * other.GroupLength(),
+                       result.Data() + g * result.GroupLength(), rows_,
+                       cols_, other.cols_);
+    }
+  });
+  return result;
+}
+
+/**
+ * @brief Исключение для всех групп: прямой ход с определителями, если
+ * x == nullptr, иначе решение с правыми частями x
+ *
+ * @param singular_error Текст исключения для вырожденной матрицы: его
+ * задаёт вызывающая операция (обращение или решение системы)
+ * @throw std::invalid_argument если x != nullptr и какая-либо матрица
+ * набора вырождена
+ */
+template <class T>
+void S21BasicMatrixBatch<T>::Eliminate(S21BasicMatrixBatch *x,
+                                       std::vector<T> *det,
+                                       const char *singular_error) const {
+  const int n = rows_;
+  const int m = x == nullptr ? 0 : x->cols_;
+  std::vector<T> all_det(Groups() * kLanes);
+  std::vector<char> all_singular(Groups() * kLanes);
+  const s21::detail::BatchKernels<T> &kernels =
+      s21::detail::SelectBatchKernels<T>();
+  const long long work =
+      static_cast<long long>(Groups()) * n * n * (n + m) * kLanes;
+  s21::detail::ParallelFor(0, Groups(), work, [&](int first, int last) {
+    std::vector<T> a(GroupLength());
+    for (int g = first; g < last; ++g) {
+      std::copy(Data() + g * GroupLength(), Data() + (g + 1) * GroupLength(),
+                a.begin());
+      bool singular[kLanes];
+      kernels.eliminate(
+          a.data(), n,
+          m == 0 ? nullptr : x->Data() + g * x->GroupLength(), m,
+          all_det.data() + g * kLanes, singular);
+      std::copy(singular, singular + kLanes,
+                all_singular.begin() + g * kLanes);
+    }
+  });
+  if (x != nullptr &&
+      std::find(all_singular.begin(), all_singular.begin() + size_, 1) !=
+          all_singular.begin() + size_) {
+    throw std::invalid_argument(singular_error);
+  }
+  if (det != nullptr) {
+    det->assign(all_det.begin(), all_det.begin() + size_);
+  }
+}
+
+/**
+ * @brief Определители всех матриц набора
+ *
+ * @throw std::invalid_argument если матрицы не квадратные
+ */
+template <class T>
+std::vector<T> S21BasicMatrixBatch<T>::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Determinant is only defined for square matrices.");
+  }
+  std::vector<T> det;
+  Eliminate(nullptr, &det, nullptr);
+  return det;
+}
+
+/**
+ * @brief Обратные матрицы для всех матриц набора
+ *
+ * @throw std::invalid_argument если матрицы не квадратные или какая-либо
+ * из них вырождена
+ */
+template <class T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Inverse matrix is only defined for square matrices.");
+  }
+  S21BasicMatrixBatch x(size_, rows_, cols_);
+  for (std::size_t g = 0; g < Length(); g += GroupLength()) {
+    for (int i = 0; i < rows_; ++i) {
+      std::fill_n(x.data_ + g + (i * cols_ + i) * kLanes, kLanes, T(1));
+    }
+  }
+  Eliminate(&x, nullptr, "Matrix is singular and cannot be inverted.");
+  return x;
+}
+
+/**
+ * @brief Решает системы A[index] * X[index] = rhs[index] для всего набора
+ *
+ * @param rhs Набор правых частей того же размера, матрицы с Rows()
+ * строками
+ * @return Набор решений той же размерности, что и rhs
+ * @throw std::invalid_argument если матрицы не квадратные, размеры наборов
+ * различны, число строк правых частей не совпадает с порядком матриц или
+ * какая-либо матрица вырождена
+ */
+template <class T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::Solve(
+    const S21BasicMatrixBatch &rhs) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Linear systems can only be solved for square matrices.");
+  }
+  if (rhs.size_ != size_ || rhs.rows_ != rows_) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  S21BasicMatrixBatch x(rhs);
+  Eliminate(&x, nullptr,
+            "Matrix is singular; the system has no unique solution.");
+  return x;
+}
+
+#define S21_INSTANTIATE(T) template class S21BasicMatrixBatch<T>;
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
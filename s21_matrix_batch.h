@@ -0,0 +1,99 @@
+#ifndef SRC_S21_MATRIX_BATCH_H
+#define SRC_S21_MATRIX_BATCH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+template <class T>
+class S21BasicMatrixBatch;
+
+typedef S21BasicMatrixBatch<double> S21MatrixBatch;
+
+/**
+ * @brief Набор из Size() независимых матриц одной размерности
+ * Rows() x Cols()
+ *
+ * @details Рассчитан на множество маленьких матриц (3 x 3 - 8 x 8), для
+ * которых вызов S21Matrix::operator* или InverseMatrix на каждую стоит
+ * дороже самих вычислений. Матрицы хранятся чередованием: они разбиты на
+ * группы по kLanes, и элемент (i, j) матрицы index лежит по адресу
+ *
+ *     Data() + (index / kLanes * Rows() * Cols() + i * Cols() + j) * kLanes
+ *            + index % kLanes
+ *
+ * Один и тот же элемент соседних матриц идёт подряд, поэтому операции над
+ * набором векторизуются по матрицам: одна инструкция обрабатывает элемент
+ * сразу нескольких матриц, а выбор ведущего элемента в каждой матрице
+ * свой. Группы обрабатываются параллельно в общем пуле потоков. Последняя
+ * группа дополнена нулевыми матрицами, которые операции не проверяют и не
+ * возвращают. Память выделяется как у S21Matrix: с выравниванием по 64
+ * байтам и из пула, если действует S21MatrixPoolScope.
+ */
+template <class T>
+class S21BasicMatrixBatch {
+ public:
+  typedef T Scalar;
+  typedef typename S21MatrixTraits<T>::Real Real;
+
+  static constexpr int kLanes = 8;
+
+  S21BasicMatrixBatch();
+  S21BasicMatrixBatch(int size, int rows, int cols);
+  S21BasicMatrixBatch(const S21BasicMatrixBatch &other);
+  S21BasicMatrixBatch(S21BasicMatrixBatch &&other) noexcept;
+  ~S21BasicMatrixBatch();
+
+  S21BasicMatrixBatch &operator=(const S21BasicMatrixBatch &other);
+  S21BasicMatrixBatch &operator=(S21BasicMatrixBatch &&other) noexcept;
+
+  inline int Size() const { return size_; }
+  inline int Rows() const { return rows_; }
+  inline int Cols() const { return cols_; }
+  inline int Groups() const { return (size_ + kLanes - 1) / kLanes; }
+  inline T *Data() { return data_; }
+  inline const T *Data() const { return data_; }
+
+  inline T &Coeff(int index, int i, int j) {
+    return data_[Offset(index, i, j)];
+  }
+  inline const T &Coeff(int index, int i, int j) const {
+    return data_[Offset(index, i, j)];
+  }
+  T &operator()(int index, int i, int j);
+  const T &operator()(int index, int i, int j) const;
+
+  S21BasicMatrix<T> Get(int index) const;
+  void Set(int index, const S21BasicMatrixView<T> &matrix);
+  void Set(int index, const S21BasicMatrix<T> &matrix);
+
+  S21BasicMatrixBatch operator*(const S21BasicMatrixBatch &other) const;
+  std::vector<T> Determinant() const;
+  S21BasicMatrixBatch InverseMatrix() const;
+  S21BasicMatrixBatch Solve(const S21BasicMatrixBatch &rhs) const;
+
+ private:
+  inline std::size_t GroupLength() const {
+    return static_cast<std::size_t>(rows_) * cols_ * kLanes;
+  }
+  inline std::size_t Length() const { return Groups() * GroupLength(); }
+  inline std::size_t Offset(int index, int i, int j) const {
+    return index / kLanes * GroupLength() +
+           (static_cast<std::size_t>(i) * cols_ + j) * kLanes + index % kLanes;
+  }
+  void Allocate();
+  void CheckIndex(int index) const;
+  void Eliminate(S21BasicMatrixBatch *x, std::vector<T> *det,
+                 const char *singular_error) const;
+
+  int size_, rows_, cols_;
+  T *data_;
+};
+
+#define S21_DECLARE_INSTANTIATION(T) \
+  extern template class S21BasicMatrixBatch<T>;
+S21_ELEMENT_TYPES(S21_DECLARE_INSTANTIATION)
+#undef S21_DECLARE_INSTANTIATION
+
+#endif  // SRC_S21_MATRIX_BATCH_H
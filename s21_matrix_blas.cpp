@@ -0,0 +1,239 @@
+#include "s21_matrix_blas.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_transpose.h"
+
+#ifdef S21_WITH_BLAS
+#include <cblas.h>
+
+extern "C" {
+void sgetrf_(const int *m, const int *n, float *a, const int *lda, int *ipiv,
+             int *info);
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv,
+             int *info);
+void sgetri_(const int *n, float *a, const int *lda, const int *ipiv,
+             float *work, const int *lwork, int *info);
+void dgetri_(const int *n, double *a, const int *lda, const int *ipiv,
+             double *work, const int *lwork, int *info);
+}
+#endif
+
+namespace {
+#ifdef S21_WITH_BLAS
+const S21Backend kDefaultBackend = S21Backend::kBlas;
+#else
+const S21Backend kDefaultBackend = S21Backend::kNative;
+#endif
+
+std::atomic<int> g_backend(static_cast<int>(kDefaultBackend));
+}  // namespace
+
+namespace s21 {
+namespace detail {
+
+#ifdef S21_WITH_BLAS
+namespace {
+
+// Пороги, ниже которых собственные ядра быстрее: вызов BLAS и
+// транспонирование для LAPACK на малых матрицах не окупаются
+const long long kMinGemmVolume = 48LL * 48 * 48;
+const int kMinLuOrder = 96;
+const long long kMinTrsmVolume = 64LL * 64 * 64;
+
+/**
+ * @brief Функции BLAS и LAPACK для типа T
+ */
+template <class T>
+struct Blas;
+
+template <>
+struct Blas<float> {
+  static constexpr auto gemm = cblas_sgemm;
+  static constexpr auto trsm = cblas_strsm;
+  static constexpr auto getrf = sgetrf_;
+  static constexpr auto getri = sgetri_;
+};
+
+template <>
+struct Blas<double> {
+  static constexpr auto gemm = cblas_dgemm;
+  static constexpr auto trsm = cblas_dtrsm;
+  static constexpr auto getrf = dgetrf_;
+  static constexpr auto getri = dgetri_;
+};
+
+bool Enabled() {
+  return static_cast<S21Backend>(g_backend.load()) == S21Backend::kBlas;
+}
+
+/**
+ * @brief Описывает операнд с шагами rs и cs как матрицу BLAS в порядке
+ * строк: сам операнд (cs == 1) или транспонированный (rs == 1)
+ *
+ * @return false, если ни один шаг не единичный или ld меньше допустимого
+ */
+bool Layout(int rows, int cols, std::ptrdiff_t rs, std::ptrdiff_t cs,
+            CBLAS_TRANSPOSE *trans, int *ld) {
+  if (cs == 1 && rs >= std::max(cols, 1)) {
+    *trans = CblasNoTrans;
+    *ld = static_cast<int>(rs);
+    return true;
+  }
+  if (rs == 1 && cs >= std::max(rows, 1)) {
+    *trans = CblasTrans;
+    *ld = static_cast<int>(cs);
+    return true;
+  }
+  return false;
+}
+
+template <class T>
+bool Gemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t a_rs,
+          std::ptrdiff_t a_cs, const T *b, std::ptrdiff_t b_rs,
+          std::ptrdiff_t b_cs, T beta, T *c, std::ptrdiff_t c_rs) {
+  CBLAS_TRANSPOSE trans_a, trans_b;
+  int lda, ldb;
+  if (!Enabled() || static_cast<long long>(m) * n * k < kMinGemmVolume ||
+      !Layout(m, k, a_rs, a_cs, &trans_a, &lda) ||
+      !Layout(k, n, b_rs, b_cs, &trans_b, &ldb) || c_rs < n) {
+    return false;
+  }
+  Blas<T>::gemm(CblasRowMajor, trans_a, trans_b, m, n, k, alpha, a, lda, b,
+                ldb, beta, c, static_cast<int>(c_rs));
+  return true;
+}
+
+/**
+ * @details LAPACK хранит матрицы по столбцам, поэтому матрица
+ * транспонируется на месте до и после getrf. Перестановки getrf - те же
+ * последовательные обмены строк, что у LuFactor, только с нумерацией с 1.
+ */
+template <class T>
+bool LuFactor(T *a, int n, std::ptrdiff_t s, int *pivots, int *sign) {
+  if (!Enabled() || n < kMinLuOrder) {
+    return false;
+  }
+  const int lda = static_cast<int>(s);
+  int info = 0;
+  TransposeSquareInPlace(a, n, s);
+  Blas<T>::getrf(&n, &n, a, &lda, pivots, &info);
+  TransposeSquareInPlace(a, n, s);
+  *sign = 1;
+  for (int k = 0; k < n; ++k) {
+    --pivots[k];
+    if (pivots[k] != k) {
+      *sign = -*sign;
+    }
+  }
+  return true;
+}
+
+template <class T>
+bool LuInvert(T *a, int n, std::ptrdiff_t s, const int *pivots) {
+  if (!Enabled() || n < kMinLuOrder) {
+    return false;
+  }
+  std::vector<int> ipiv(pivots, pivots + n);
+  for (int &pivot : ipiv) {
+    ++pivot;
+  }
+  const int lda = static_cast<int>(s);
+  int info = 0, lwork = -1;
+  T optimal = T();
+  Blas<T>::getri(&n, a, &lda, ipiv.data(), &optimal, &lwork, &info);
+  lwork = std::max(static_cast<int>(optimal), n);
+  std::vector<T> work(lwork);
+  TransposeSquareInPlace(a, n, s);
+  Blas<T>::getri(&n, a, &lda, ipiv.data(), work.data(), &lwork, &info);
+  TransposeSquareInPlace(a, n, s);
+  return true;
+}
+
+template <class T>
+bool SolveTriangular(const T *a, int n, std::ptrdiff_t s, bool lower,
+                     bool unit_diagonal, T *x, int m, std::ptrdiff_t xs) {
+  if (!Enabled() || static_cast<long long>(n) * n * m < kMinTrsmVolume) {
+    return false;
+  }
+  Blas<T>::trsm(CblasRowMajor, CblasLeft, lower ? CblasLower : CblasUpper,
+                CblasNoTrans, unit_diagonal ? CblasUnit : CblasNonUnit, n, m,
+                T(1), a, static_cast<int>(s), x, static_cast<int>(xs));
+  return true;
+}
+
+}  // namespace
+
+#define S21_BLAS_OVERLOADS(T)                                                  \
+  bool BlasGemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t a_rs, \
+                std::ptrdiff_t a_cs, const T *b, std::ptrdiff_t b_rs,          \
+                std::ptrdiff_t b_cs, T beta, T *c, std::ptrdiff_t c_rs) {      \
+    return Gemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);  \
+  }                                                                            \
+  bool BlasLuFactor(T *a, int n, std::ptrdiff_t s, int *pivots, int *sign) {   \
+    return LuFactor(a, n, s, pivots, sign);                                    \
+  }                                                                            \
+  bool BlasLuInvert(T *a, int n, std::ptrdiff_t s, const int *pivots) {        \
+    return LuInvert(a, n, s, pivots);                                          \
+  }                                                                            \
+  bool BlasSolveTriangular(const T *a, int n, std::ptrdiff_t s, bool lower,    \
+                           bool unit_diagonal, T *x, int m,                    \
+                           std::ptrdiff_t xs) {                                \
+    return SolveTriangular(a, n, s, lower, unit_diagonal, x, m, xs);           \
+  }
+#else
+#define S21_BLAS_OVERLOADS(T)                                                 \
+  bool BlasGemm(int, int, int, T, const T *, std::ptrdiff_t, std::ptrdiff_t,  \
+                const T *, std::ptrdiff_t, std::ptrdiff_t, T, T *,            \
+                std::ptrdiff_t) {                                             \
+    return false;                                                             \
+  }                                                                           \
+  bool BlasLuFactor(T *, int, std::ptrdiff_t, int *, int *) { return false; } \
+  bool BlasLuInvert(T *, int, std::ptrdiff_t, const int *) { return false; }  \
+  bool BlasSolveTriangular(const T *, int, std::ptrdiff_t, bool, bool, T *,   \
+                           int, std::ptrdiff_t) {                             \
+    return false;                                                             \
+  }
+#endif
+
+S21_BLAS_OVERLOADS(float)
+S21_BLAS_OVERLOADS(double)
+#undef S21_BLAS_OVERLOADS
+
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief Собрана ли библиотека с BLAS и LAPACK (make BLAS=...)
+ */
+bool S21HasBlas() {
+#ifdef S21_WITH_BLAS
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Текущая реализация умножения и разложений; по умолчанию kBlas,
+ * если библиотека собрана с BLAS
+ */
+S21Backend S21GetBackend() {
+  return static_cast<S21Backend>(g_backend.load());
+}
+
+/**
+ * @brief Выбирает реализацию умножения и разложений
+ *
+ * @details Без BLAS kBlas заменяется на kNative. Используется для тестов и
+ * сравнения производительности.
+ */
+void S21SetBackend(S21Backend backend) {
+  if (!S21HasBlas()) {
+    backend = S21Backend::kNative;
+  }
+  g_backend.store(static_cast<int>(backend));
+}
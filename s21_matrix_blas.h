@@ -0,0 +1,81 @@
+#ifndef SRC_S21_MATRIX_BLAS_H
+#define SRC_S21_MATRIX_BLAS_H
+
+#include <cstddef>
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Передаёт Gemm внешней библиотеке BLAS
+ *
+ * @return false, если вызов не передан: библиотека собрана без BLAS,
+ * выбран S21Backend::kNative, произведение слишком мало, чтобы окупить
+ * вызов, или шаги операндов не выражаются через lda/ldb. Тогда C не
+ * изменяется, и произведение считают собственные ядра.
+ * @details Параметры те же, что у Gemm. Обобщённые версии для типов без
+ * BLAS-аналога всегда возвращают false.
+ */
+template <class T>
+inline bool BlasGemm(int, int, int, T, const T *, std::ptrdiff_t,
+                     std::ptrdiff_t, const T *, std::ptrdiff_t, std::ptrdiff_t,
+                     T, T *, std::ptrdiff_t) {
+  return false;
+}
+bool BlasGemm(int m, int n, int k, float alpha, const float *a,
+              std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const float *b,
+              std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, float beta, float *c,
+              std::ptrdiff_t c_rs);
+bool BlasGemm(int m, int n, int k, double alpha, const double *a,
+              std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const double *b,
+              std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, double beta, double *c,
+              std::ptrdiff_t c_rs);
+
+/**
+ * @brief LuFactor через LAPACK getrf
+ *
+ * @param sign Знак перестановки, если разложение выполнено
+ * @return false, если разложение не выполнено (см. BlasGemm)
+ */
+template <class T>
+inline bool BlasLuFactor(T *, int, std::ptrdiff_t, int *, int *) {
+  return false;
+}
+bool BlasLuFactor(float *a, int n, std::ptrdiff_t s, int *pivots, int *sign);
+bool BlasLuFactor(double *a, int n, std::ptrdiff_t s, int *pivots, int *sign);
+
+/**
+ * @brief LuInvert через LAPACK getri
+ *
+ * @return false, если обращение не выполнено (см. BlasGemm)
+ */
+template <class T>
+inline bool BlasLuInvert(T *, int, std::ptrdiff_t, const int *) {
+  return false;
+}
+bool BlasLuInvert(float *a, int n, std::ptrdiff_t s, const int *pivots);
+bool BlasLuInvert(double *a, int n, std::ptrdiff_t s, const int *pivots);
+
+/**
+ * @brief SolveLower и SolveUpper через BLAS trsm
+ *
+ * @param lower Решать L * X = B (иначе U * X = B)
+ * @param unit_diagonal Считать диагональ единичной
+ * @return false, если решение не выполнено (см. BlasGemm)
+ */
+template <class T>
+inline bool BlasSolveTriangular(const T *, int, std::ptrdiff_t, bool, bool,
+                                T *, int, std::ptrdiff_t) {
+  return false;
+}
+bool BlasSolveTriangular(const float *a, int n, std::ptrdiff_t s, bool lower,
+                         bool unit_diagonal, float *x, int m,
+                         std::ptrdiff_t xs);
+bool BlasSolveTriangular(const double *a, int n, std::ptrdiff_t s, bool lower,
+                         bool unit_diagonal, double *x, int m,
+                         std::ptrdiff_t xs);
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_BLAS_H
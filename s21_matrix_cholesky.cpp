@@ -0,0 +1,492 @@
+#include "s21_matrix_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace detail {
+namespace {
+// Ширина панели разложения и полосы строк, которой остаток матрицы
+// обновляется выше диагонали: в диагональных блоках полосы GEMM считает и
+// ненужный нижний треугольник, поэтому полоса не делается широкой
+const int kCholeskyBlock = 64;
+const int kUpdateBlock = 128;
+
+/**
+ * @brief Записывает в нижний треугольник сопряжённый верхний
+ */
+template <class T>
+void MirrorUpper(T *a, int n, std::ptrdiff_t s) {
+  ParallelFor(0, n, static_cast<long long>(n) * n / 2,
+              [&](int first, int last) {
+                for (int i = first; i < last; ++i) {
+                  T *row = a + i * s;
+                  for (int j = 0; j < i; ++j) {
+                    row[j] = S21MatrixTraits<T>::Conj(a[j * s + i]);
+                  }
+                }
+              });
+}
+
+/**
+ * @brief Раскладывает строки k0..k0+kb-1 матрицы U целиком, до столбца n
+ *
+ * @details После деления строки k на u_kk её вклад вычитается из
+ * оставшихся строк панели: a(i, j) -= conj(u_ki) * u_kj при j >= i.
+ * Столбцы независимы и делятся между потоками.
+ */
+template <class T>
+bool FactorizePanel(T *a, int n, std::ptrdiff_t s, int k0, int kb,
+                    typename S21MatrixTraits<T>::Real tolerance) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  for (int k = k0; k < k0 + kb; ++k) {
+    T *u_row = a + k * s;
+    const Real d = std::real(u_row[k]);
+    if (!(d > tolerance)) {
+      return false;
+    }
+    const Real u_kk = std::sqrt(d);
+    const T inv_diag = T(Real(1) / u_kk);
+    u_row[k] = T(u_kk);
+    for (int j = k + 1; j < n; ++j) {
+      u_row[j] *= inv_diag;
+    }
+    const long long work = static_cast<long long>(n - k) * (k0 + kb - k);
+    ParallelFor(k + 1, n, work, [&](int first, int last) {
+      for (int i = k + 1; i < k0 + kb; ++i) {
+        const T c = S21MatrixTraits<T>::Conj(u_row[i]);
+        T *row = a + i * s;
+        for (int j = std::max(i, first); j < last; ++j) {
+          row[j] -= c * u_row[j];
+        }
+      }
+    });
+  }
+  return true;
+}
+
+}  // namespace
+
+template <class T>
+bool IsHermitian(const T *a, int n, std::ptrdiff_t rs, std::ptrdiff_t cs) {
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      if (a[i * rs + j * cs] != S21MatrixTraits<T>::Conj(a[j * rs + i * cs])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class T>
+typename S21MatrixTraits<T>::Real CholeskyTolerance(const T *a, int n,
+                                                    std::ptrdiff_t s) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  Real max_abs = Real();
+  for (int i = 0; i < n; ++i) {
+    max_abs = std::max(max_abs, Real(std::abs(a[i * s + i])));
+  }
+  return n * std::numeric_limits<Real>::epsilon() * max_abs;
+}
+
+/**
+ * @details Разложение ведётся над U = L^H, строки которой лежат в памяти
+ * подряд. После панели U11, U12 остаток обновляется: A22 -= U12^H * U12.
+ * Первый множитель - сопряжённая копия U12, прочитанная с переставленными
+ * шагами.
+ */
+template <class T>
+bool CholeskyFactor(T *a, int n, std::ptrdiff_t s,
+                    typename S21MatrixTraits<T>::Real tolerance) {
+  std::vector<T> panel;
+  for (int k0 = 0; k0 < n; k0 += kCholeskyBlock) {
+    const int kb = std::min(kCholeskyBlock, n - k0);
+    const int rest = n - k0 - kb;
+    if (!FactorizePanel(a, n, s, k0, kb, tolerance)) {
+      return false;
+    }
+    if (rest == 0) {
+      continue;
+    }
+
+    const T *u12 = a + k0 * s + k0 + kb;
+    T *a22 = a + (k0 + kb) * s + k0 + kb;
+    panel.resize(static_cast<std::size_t>(kb) * rest);
+    for (int p = 0; p < kb; ++p) {
+      for (int j = 0; j < rest; ++j) {
+        panel[p * rest + j] = S21MatrixTraits<T>::Conj(u12[p * s + j]);
+      }
+    }
+    for (int r0 = 0; r0 < rest; r0 += kUpdateBlock) {
+      const int rb = std::min(kUpdateBlock, rest - r0);
+      Gemm(rb, rest - r0, kb, T(-1), panel.data() + r0, 1, rest, u12 + r0, s,
+           1, T(1), a22 + r0 * s + r0, s);
+    }
+  }
+  MirrorUpper(a, n, s);
+  return true;
+}
+
+/**
+ * @details Нижний треугольник inv(U) обнуляется, чтобы полосы строк можно
+ * было умножать GEMM целиком. Полоса I строк результата зависит от строк I
+ * и ниже, поэтому полосы считаются сверху вниз, а сопряжённая копия
+ * полосы I берётся до того, как её место займёт результат. GEMM даёт
+ * conj(inv(A)); при отражении в нижний треугольник это учитывается.
+ */
+template <class T>
+void CholeskyInvert(T *a, int n, std::ptrdiff_t s) {
+  std::vector<T> work(n);
+  InvertUpper(a, n, s, work.data());
+  for (int i = 1; i < n; ++i) {
+    std::fill(a + i * s, a + i * s + i, T());
+  }
+
+  std::vector<T> band;
+  std::vector<T> diagonal;
+  for (int i0 = 0; i0 < n; i0 += kUpdateBlock) {
+    const int ib = std::min(kUpdateBlock, n - i0);
+    const int i1 = i0 + ib;
+    const int width = n - i0;
+    band.resize(static_cast<std::size_t>(ib) * width);
+    for (int i = 0; i < ib; ++i) {
+      const T *row = a + (i0 + i) * s + i0;
+      for (int p = 0; p < width; ++p) {
+        band[i * width + p] = S21MatrixTraits<T>::Conj(row[p]);
+      }
+    }
+    diagonal.resize(static_cast<std::size_t>(ib) * ib);
+    Gemm(ib, ib, width, T(1), band.data(), width, 1, a + i0 * s + i0, 1, s,
+         T(), diagonal.data(), ib);
+    if (i1 < n) {
+      Gemm(ib, n - i1, n - i1, T(1), band.data() + ib, width, 1,
+           a + i1 * s + i1, 1, s, T(), a + i0 * s + i1, s);
+    }
+    for (int i = 0; i < ib; ++i) {
+      std::copy(diagonal.data() + i * ib, diagonal.data() + (i + 1) * ib,
+                a + (i0 + i) * s + i0);
+    }
+  }
+
+  ParallelFor(0, n, static_cast<long long>(n) * n, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      T *row = a + i * s;
+      for (int j = i; j < n; ++j) {
+        row[j] = S21MatrixTraits<T>::Conj(row[j]);
+      }
+    }
+  });
+  MirrorUpper(a, n, s);
+}
+
+template <class T>
+void CholeskyUpdate(T *a, int n, std::ptrdiff_t s, T *x) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  for (int k = 0; k < n; ++k) {
+    T *row = a + k * s;
+    const Real d = std::real(row[k]);
+    const Real r = std::sqrt(d * d + std::norm(x[k]));
+    const Real c = r / d;
+    const T sk = x[k] / d;
+    row[k] = T(r);
+    for (int i = k + 1; i < n; ++i) {
+      row[i] = (row[i] + sk * S21MatrixTraits<T>::Conj(x[i])) / c;
+      x[i] = c * x[i] - sk * S21MatrixTraits<T>::Conj(row[i]);
+    }
+  }
+  MirrorUpper(a, n, s);
+}
+
+/**
+ * @details Вращение i действует на строку i множителя U и на добавочную
+ * нулевую строку. Вращения применяются от последнего к первому, поэтому
+ * столбцы независимы; чтобы идти по строкам, а не по столбцам,
+ * промежуточные значения добавочной строки хранятся для всех столбцов
+ * полосы. Диагональ результата затем делается вещественной и
+ * положительной умножением строк на фазовые множители.
+ */
+template <class T>
+bool CholeskyDowndate(T *a, int n, std::ptrdiff_t s, T *x,
+                      typename S21MatrixTraits<T>::Real tolerance) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  SolveLower(a, n, s, false, x, 1, 1);
+  Real norm2 = Real();
+  for (int i = 0; i < n; ++i) {
+    norm2 += std::norm(x[i]);
+  }
+  if (Real(1) - norm2 <= tolerance) {
+    return false;
+  }
+
+  // Косинусы вращений - в c, синусы - на месте x
+  std::vector<Real> c(n);
+  Real alpha = std::sqrt(Real(1) - norm2);
+  for (int i = n - 1; i >= 0; --i) {
+    const Real scale = alpha + std::abs(x[i]);
+    const Real a_i = alpha / scale;
+    const T b_i = x[i] / scale;
+    const Real norm = std::sqrt(a_i * a_i + std::norm(b_i));
+    c[i] = a_i / norm;
+    x[i] = S21MatrixTraits<T>::Conj(b_i) / norm;
+    alpha = scale * norm;
+  }
+  ParallelFor(0, n, 3LL * n * n, [&](int first, int last) {
+    std::vector<T> extra(last - first, T());
+    for (int i = last - 1; i >= 0; --i) {
+      T *row = a + i * s;
+      const T sin_conj = S21MatrixTraits<T>::Conj(x[i]);
+      for (int j = std::max(i, first); j < last; ++j) {
+        T &xx = extra[j - first];
+        const T t = c[i] * xx + x[i] * row[j];
+        row[j] = c[i] * row[j] - sin_conj * xx;
+        xx = t;
+      }
+    }
+  });
+  for (int i = 0; i < n; ++i) {
+    T *row = a + i * s;
+    const Real modulus = std::abs(row[i]);
+    if (row[i] != T(modulus)) {
+      const T phase = S21MatrixTraits<T>::Conj(row[i]) / modulus;
+      for (int j = i + 1; j < n; ++j) {
+        row[j] *= phase;
+      }
+      row[i] = T(modulus);
+    }
+  }
+  MirrorUpper(a, n, s);
+  return true;
+}
+
+#define S21_INSTANTIATE(T)                                                \
+  template bool IsHermitian<T>(const T *, int, std::ptrdiff_t,            \
+                               std::ptrdiff_t);                           \
+  template S21MatrixTraits<T>::Real CholeskyTolerance<T>(const T *, int,  \
+                                                         std::ptrdiff_t); \
+  template bool CholeskyFactor<T>(T *, int, std::ptrdiff_t,               \
+                                  S21MatrixTraits<T>::Real);              \
+  template void CholeskyInvert<T>(T *, int, std::ptrdiff_t);              \
+  template void CholeskyUpdate<T>(T *, int, std::ptrdiff_t, T *);         \
+  template bool CholeskyDowndate<T>(T *, int, std::ptrdiff_t, T *,        \
+                                    S21MatrixTraits<T>::Real);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
+
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief Разложение Холецкого
+ *
+ * @throw std::invalid_argument если матрица не квадратная
+ */
+template <class T>
+S21BasicCholesky<T> S21BasicMatrix<T>::Cholesky() const {
+  return S21BasicCholesky<T>(*this);
+}
+
+/**
+ * @brief Раскладывает эрмитову (вещественную симметричную) матрицу:
+ * A = L * L^H
+ *
+ * @param matrix Квадратная матрица; читаются только элементы на главной
+ * диагонали и выше
+ * @throw std::invalid_argument если матрица не квадратная
+ * @details Матрица, не являющаяся положительно определённой,
+ * раскладывается без ошибки, IsPositiveDefinite() при этом возвращает
+ * false. Квадрат диагонального элемента L, не превосходящий
+ * n * eps * max|a_ii|, тоже считается признаком этого.
+ */
+template <class T>
+S21BasicCholesky<T>::S21BasicCholesky(const S21BasicMatrix<T> &matrix)
+    : S21BasicCholesky(matrix.View()) {}
+
+/**
+ * @brief Раскладывает матрицу, заданную представлением
+ *
+ * @details Элементы копируются один раз - в хранилище множителей.
+ */
+template <class T>
+S21BasicCholesky<T>::S21BasicCholesky(const S21BasicMatrixView<T> &matrix)
+    : factors_(), positive_definite_(false) {
+  if (!matrix.IsSquare()) {
+    throw std::invalid_argument(
+        "Cholesky decomposition is only defined for square matrices.");
+  }
+  const int n = matrix.Rows();
+  factors_ = S21BasicMatrix<T>(matrix);
+  if (n == 0) {
+    return;
+  }
+  positive_definite_ = s21::detail::CholeskyFactor(
+      factors_.Data(), n, factors_.Stride(),
+      s21::detail::CholeskyTolerance(factors_.Data(), n, factors_.Stride()));
+}
+
+template <class T>
+void S21BasicCholesky<T>::CheckPositiveDefinite() const {
+  if (!positive_definite_) {
+    throw std::invalid_argument("Matrix is not positive definite.");
+  }
+}
+
+/**
+ * @brief Множитель L: нижнетреугольная матрица с положительной диагональю
+ *
+ * @throw std::invalid_argument если матрица не положительно определена
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicCholesky<T>::L() const {
+  CheckPositiveDefinite();
+  S21BasicMatrix<T> l(factors_);
+  for (int i = 0; i < Size(); ++i) {
+    T *row = l.Data() + static_cast<std::size_t>(i) * l.Stride();
+    std::fill(row + i + 1, row + Size(), T());
+  }
+  return l;
+}
+
+/**
+ * @brief Определитель исходной матрицы: квадрат произведения диагональных
+ * элементов L
+ *
+ * @throw std::invalid_argument если матрица не положительно определена
+ */
+template <class T>
+T S21BasicCholesky<T>::Determinant() const {
+  CheckPositiveDefinite();
+  T det = T(1);
+  for (int i = 0; i < Size(); ++i) {
+    det *= factors_.At(i, i);
+  }
+  return det * det;
+}
+
+/**
+ * @brief Решает систему A * X = rhs прямой подстановкой с L и обратной с
+ * L^H
+ *
+ * @param rhs Матрица правых частей с Size() строками
+ * @return Матрица решений той же размерности, что и rhs
+ * @throw std::invalid_argument если число строк rhs не совпадает с
+ * порядком матрицы или матрица не положительно определена
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Solve(
+    const S21BasicMatrix<T> &rhs) const {
+  const int n = Size();
+  if (rhs.Rows() != n) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  CheckPositiveDefinite();
+
+  S21BasicMatrix<T> x(rhs);
+  if (x.Data() == nullptr) {
+    return x;
+  }
+  s21::detail::SolveLower(factors_.Data(), n, factors_.Stride(), false,
+                          x.Data(), x.Cols(), x.Stride());
+  s21::detail::SolveUpper(factors_.Data(), n, factors_.Stride(), x.Data(),
+                          x.Cols(), x.Stride());
+  return x;
+}
+
+/**
+ * @brief Обратная матрица
+ *
+ * @throw std::invalid_argument если матрица не положительно определена
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicCholesky<T>::InverseMatrix() const {
+  CheckPositiveDefinite();
+  S21BasicMatrix<T> inverse(factors_);
+  if (inverse.Data() != nullptr) {
+    s21::detail::CholeskyInvert(inverse.Data(), Size(), inverse.Stride());
+  }
+  return inverse;
+}
+
+template <class T>
+void S21BasicCholesky<T>::CheckUpdate(const S21BasicMatrix<T> &x) const {
+  if (x.Rows() != Size()) {
+    throw std::invalid_argument(
+        "Update vectors must have as many rows as the matrix.");
+  }
+  CheckPositiveDefinite();
+}
+
+/**
+ * @brief Пересчитывает разложение для A + X * X^H
+ *
+ * @param x Матрица из Size() строк; каждый столбец - обновление ранга 1
+ * @throw std::invalid_argument если число строк x не совпадает с порядком
+ * матрицы или матрица не положительно определена
+ * @details O(n^2) операций на столбец x вместо O(n^3) у нового
+ * разложения. Результат положительно определён всегда.
+ */
+template <class T>
+void S21BasicCholesky<T>::Update(const S21BasicMatrix<T> &x) {
+  CheckUpdate(x);
+  std::vector<T> column(Size());
+  for (int j = 0; j < x.Cols(); ++j) {
+    for (int i = 0; i < Size(); ++i) {
+      column[i] = x.At(i, j);
+    }
+    s21::detail::CholeskyUpdate(factors_.Data(), Size(), factors_.Stride(),
+                                column.data());
+  }
+}
+
+/**
+ * @brief Пересчитывает разложение для A - X * X^H
+ *
+ * @param x Матрица из Size() строк; каждый столбец - понижение ранга 1
+ * @throw std::invalid_argument если число строк x не совпадает с порядком
+ * матрицы, матрица не положительно определена или перестаёт быть
+ * положительно определённой после понижения; в последнем случае
+ * разложение не изменяется
+ * @details O(n^2) операций на столбец x. Порог - n * eps для отношения
+ * det(A - x * x^H) / det(A) после каждого столбца.
+ */
+template <class T>
+void S21BasicCholesky<T>::Downdate(const S21BasicMatrix<T> &x) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  CheckUpdate(x);
+  const Real tolerance = Size() * std::numeric_limits<Real>::epsilon();
+  S21BasicMatrix<T> backup;
+  if (x.Cols() > 1) {
+    backup = factors_;
+  }
+  std::vector<T> column(Size());
+  for (int j = 0; j < x.Cols(); ++j) {
+    for (int i = 0; i < Size(); ++i) {
+      column[i] = x.At(i, j);
+    }
+    if (!s21::detail::CholeskyDowndate(factors_.Data(), Size(),
+                                       factors_.Stride(), column.data(),
+                                       tolerance)) {
+      if (j > 0) {
+        factors_ = std::move(backup);
+      }
+      throw std::invalid_argument(
+          "Downdate makes the matrix not positive definite.");
+    }
+  }
+}
+
+#define S21_INSTANTIATE(T)            \
+  template class S21BasicCholesky<T>; \
+  template S21BasicCholesky<T> S21BasicMatrix<T>::Cholesky() const;
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
@@ -0,0 +1,95 @@
+#ifndef SRC_S21_MATRIX_CHOLESKY_H
+#define SRC_S21_MATRIX_CHOLESKY_H
+
+#include <cstddef>
+
+#include "s21_matrix_traits.h"
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Проверяет, что a(i, j) == conj(a(j, i)) для всех i, j
+ *
+ * @details Для вещественных матриц это симметричность, для комплексных -
+ * эрмитовость. Сравнение точное и прекращается на первой несовпадающей
+ * паре, поэтому для матриц общего вида проверка почти ничего не стоит.
+ */
+template <class T>
+bool IsHermitian(const T *a, int n, std::ptrdiff_t rs, std::ptrdiff_t cs);
+
+/**
+ * @brief Порог для квадратов диагональных элементов L: n * eps * max|a_ii|
+ *
+ * @details У положительно определённой матрицы наибольший по модулю
+ * элемент лежит на диагонали, поэтому порог совпадает с порогом
+ * LuTolerance, но читает только диагональ.
+ */
+template <class T>
+typename S21MatrixTraits<T>::Real CholeskyTolerance(const T *a, int n,
+                                                    std::ptrdiff_t s);
+
+/**
+ * @brief Разложение Холецкого на месте: A = L * L^H
+ *
+ * @param a Матрица порядка n, строки идут с шагом s. Читаются только
+ * элементы на главной диагонали и выше.
+ * @param tolerance Наименьшее допустимое значение l_kk^2
+ * @return false, если матрица не положительно определена (очередной
+ * l_kk^2 не больше tolerance); тогда содержимое a не определено
+ * @details При успехе L записывается на главной диагонали и ниже, а L^H -
+ * выше неё, поэтому a можно сразу передавать и SolveLower, и SolveUpper.
+ * Разложение блочное: панель из строк U = L^H считается построчно, остаток
+ * матрицы обновляется GEMM, причём только на диагонали и выше. Это вдвое
+ * меньше операций, чем у LuFactor.
+ */
+template <class T>
+bool CholeskyFactor(T *a, int n, std::ptrdiff_t s,
+                    typename S21MatrixTraits<T>::Real tolerance);
+
+/**
+ * @brief Обращает матрицу на месте по её разложению Холецкого
+ *
+ * @param a Результат CholeskyFactor, заменяется на обратную матрицу
+ * @details inv(A) = inv(U) * inv(U)^H для U = L^H: U обращается на месте
+ * (InvertUpper), затем полосами строк считается верхний треугольник
+ * произведения (GEMM) и отражается в нижний. Операций примерно вдвое
+ * меньше, чем при обращении через LU-разложение.
+ */
+template <class T>
+void CholeskyInvert(T *a, int n, std::ptrdiff_t s);
+
+/**
+ * @brief Обновление разложения Холецкого: A + x * x^H
+ *
+ * @param a Результат CholeskyFactor, заменяется разложением A + x * x^H
+ * @param x Вектор из n элементов, портится
+ * @details Как в LINPACK xCHUD: строка k множителя U = L^H поворачивается
+ * вместе с x так, чтобы занулить x_k. O(n^2) операций вместо O(n^3) у
+ * нового разложения.
+ */
+template <class T>
+void CholeskyUpdate(T *a, int n, std::ptrdiff_t s, T *x);
+
+/**
+ * @brief Понижение разложения Холецкого: A - x * x^H
+ *
+ * @param a Результат CholeskyFactor, заменяется разложением A - x * x^H
+ * @param x Вектор из n элементов, портится
+ * @param tolerance Наименьшее допустимое значение
+ * 1 - ||L^-1 * x||^2 = det(A - x * x^H) / det(A)
+ * @return false, если A - x * x^H не положительно определена; тогда a не
+ * изменяется
+ * @details Как в LINPACK xCHDD: после решения L * p = x строки U
+ * поворачиваются обычными (не гиперболическими) вращениями, которые
+ * переводят (p, sqrt(1 - ||p||^2)) в (0, 1). Это устойчиво даже при почти
+ * вырожденном результате.
+ */
+template <class T>
+bool CholeskyDowndate(T *a, int n, std::ptrdiff_t s, T *x,
+                      typename S21MatrixTraits<T>::Real tolerance);
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_CHOLESKY_H
@@ -0,0 +1,250 @@
+#ifndef SRC_S21_MATRIX_EXPR_H
+#define SRC_S21_MATRIX_EXPR_H
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_traits.h"
+
+template <class T>
+class S21BasicMatrix;
+template <class T>
+class S21BasicLU;
+template <class T>
+class S21BasicCholesky;
+template <class T>
+class S21BasicQR;
+enum class S21MatrixStructure;
+
+/**
+ * @brief Тип элементов узла выражения E; специализируется для каждого
+ * вида узлов
+ */
+template <class E>
+struct S21ExprScalar;
+
+/**
+ * @brief Базовый класс ленивых поэлементных выражений над матрицами
+ *
+ * @details Выражения вида A + B - C * 2.0 не создают промежуточных матриц:
+ * операторы строят дерево узлов, а вычисление происходит одним проходом
+ * при присваивании в S21Matrix. Каждый узел E предоставляет Rows(), Cols()
+ * и Coeff(i, j) - значение элемента без проверки индексов. Операнды
+ * одного выражения должны иметь один тип элементов.
+ * @warning Выражение хранит ссылки на матрицы-операнды, поэтому его нельзя
+ * сохранять в auto-переменную дольше, чем живут операнды. Временные
+ * матрицы-операнды по ссылке не хранятся: для них действуют перегрузки с
+ * S21BasicMatrix &&, возвращающие матрицу.
+ */
+template <class E>
+class S21MatrixExpr {
+ public:
+  typedef typename S21ExprScalar<E>::type Scalar;
+
+  inline const E &Derived() const { return static_cast<const E &>(*this); }
+  inline int Rows() const { return Derived().Rows(); }
+  inline int Cols() const { return Derived().Cols(); }
+  inline Scalar Coeff(int row, int col) const {
+    return Derived().Coeff(row, col);
+  }
+};
+
+/**
+ * @brief Узел выражения с константными функциями-членами S21Matrix
+ *
+ * @details Результат A + B, A - B или A * 2.0 - узел выражения, а не
+ * матрица, но с ним можно обращаться как с матрицей: (A + B).Transpose(),
+ * (A * 2.0).Determinant(). Такие функции вычисляют выражение во временную
+ * матрицу и вызывают одноимённую функцию у неё; operator() вычисляет
+ * только запрошенный элемент. Определены в s21_matrix_oop.h.
+ */
+template <class E>
+class S21MatrixExprNode : public S21MatrixExpr<E> {
+ public:
+  typedef typename S21ExprScalar<E>::type Scalar;
+  typedef S21BasicMatrix<Scalar> Matrix;
+
+  inline int Length() const { return this->Rows() * this->Cols(); }
+  inline bool IsSquare() const { return this->Rows() == this->Cols(); }
+  Scalar operator()(int row, int col) const;
+
+  Matrix Eval() const;
+  void Print() const;
+  bool EqMatrix(const Matrix &other) const;
+  Matrix Transpose() const;
+  Matrix CalcComplements() const;
+  Scalar Determinant() const;
+  S21BasicLU<Scalar> LU() const;
+  S21BasicCholesky<Scalar> Cholesky() const;
+  S21BasicQR<Scalar> QR() const;
+  Matrix Solve(const Matrix &rhs) const;
+  Matrix Solve(const Matrix &rhs, S21MatrixStructure structure) const;
+  S21MatrixStructure DetectStructure() const;
+  Matrix LeastSquares(const Matrix &rhs) const;
+  Matrix InverseMatrix() const;
+};
+
+/**
+ * @brief Способ хранения операнда в узле: матрицы - по ссылке, узлы
+ * выражений - по значению
+ */
+template <class E>
+struct S21ExprOperand {
+  typedef const E type;
+};
+template <class T>
+struct S21ExprOperand<S21BasicMatrix<T> > {
+  typedef const S21BasicMatrix<T> &type;
+};
+
+/**
+ * @brief Поэлементные операции узлов выражений; DimensionError() - текст
+ * исключения при несовпадении размерностей операндов
+ */
+struct S21AddOp {
+  static inline const char *DimensionError() {
+    return "Matrices must have the same dimensions for addition.";
+  }
+  template <class T>
+  static inline T Apply(T lhs, T rhs) {
+    return lhs + rhs;
+  }
+};
+struct S21SubOp {
+  static inline const char *DimensionError() {
+    return "Matrices must have the same dimensions for subtraction.";
+  }
+  template <class T>
+  static inline T Apply(T lhs, T rhs) {
+    return lhs - rhs;
+  }
+};
+struct S21ReverseSubOp {
+  static inline const char *DimensionError() {
+    return S21SubOp::DimensionError();
+  }
+  template <class T>
+  static inline T Apply(T lhs, T rhs) {
+    return rhs - lhs;
+  }
+};
+
+template <class L, class R, class Op>
+class S21MatrixBinaryExpr;
+template <class E>
+class S21MatrixScaledExpr;
+
+template <class L, class R, class Op>
+struct S21ExprScalar<S21MatrixBinaryExpr<L, R, Op> > {
+  typedef typename S21ExprScalar<L>::type type;
+};
+template <class E>
+struct S21ExprScalar<S21MatrixScaledExpr<E> > {
+  typedef typename S21ExprScalar<E>::type type;
+};
+
+/**
+ * @brief Узел поэлементной бинарной операции (сложение или вычитание)
+ *
+ * @throw std::invalid_argument при построении, если размерности операндов
+ * не совпадают
+ */
+template <class L, class R, class Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixExprNode<S21MatrixBinaryExpr<L, R, Op> > {
+  static_assert(std::is_same<typename S21ExprScalar<L>::type,
+                             typename S21ExprScalar<R>::type>::value,
+                "Operands must have the same element type.");
+
+ public:
+  typedef typename S21ExprScalar<L>::type Scalar;
+
+  S21MatrixBinaryExpr(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.Rows() != rhs.Rows() || lhs.Cols() != rhs.Cols()) {
+      throw std::invalid_argument(Op::DimensionError());
+    }
+  }
+  inline int Rows() const { return lhs_.Rows(); }
+  inline int Cols() const { return lhs_.Cols(); }
+  inline Scalar Coeff(int row, int col) const {
+    return Op::Apply(lhs_.Coeff(row, col), rhs_.Coeff(row, col));
+  }
+  inline const L &Lhs() const { return lhs_; }
+  inline const R &Rhs() const { return rhs_; }
+
+ private:
+  typename S21ExprOperand<L>::type lhs_;
+  typename S21ExprOperand<R>::type rhs_;
+};
+
+/**
+ * @brief Узел умножения выражения на число
+ */
+template <class E>
+class S21MatrixScaledExpr
+    : public S21MatrixExprNode<S21MatrixScaledExpr<E> > {
+ public:
+  typedef typename S21ExprScalar<E>::type Scalar;
+
+  S21MatrixScaledExpr(const E &expr, Scalar number)
+      : expr_(expr), number_(number) {}
+  inline int Rows() const { return expr_.Rows(); }
+  inline int Cols() const { return expr_.Cols(); }
+  inline Scalar Coeff(int row, int col) const {
+    return expr_.Coeff(row, col) * number_;
+  }
+  inline const E &Operand() const { return expr_; }
+
+ private:
+  typename S21ExprOperand<E>::type expr_;
+  Scalar number_;
+};
+
+/**
+ * @brief Читает ли выражение память матрицы по другим индексам; листья
+ * дерева проверяются перегрузками в s21_matrix_oop.h
+ */
+template <class L, class R, class Op, class T>
+inline bool S21ExprOverlaps(const S21MatrixBinaryExpr<L, R, Op> &expr,
+                            const S21BasicMatrix<T> &matrix) {
+  return S21ExprOverlaps(expr.Lhs(), matrix) ||
+         S21ExprOverlaps(expr.Rhs(), matrix);
+}
+
+template <class E, class T>
+inline bool S21ExprOverlaps(const S21MatrixScaledExpr<E> &expr,
+                            const S21BasicMatrix<T> &matrix) {
+  return S21ExprOverlaps(expr.Operand(), matrix);
+}
+
+template <class L, class R>
+inline S21MatrixBinaryExpr<L, R, S21AddOp> operator+(
+    const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  return S21MatrixBinaryExpr<L, R, S21AddOp>(lhs.Derived(), rhs.Derived());
+}
+
+template <class L, class R>
+inline S21MatrixBinaryExpr<L, R, S21SubOp> operator-(
+    const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  return S21MatrixBinaryExpr<L, R, S21SubOp>(lhs.Derived(), rhs.Derived());
+}
+
+/**
+ * @brief Умножение выражения на число; число приводится к типу элементов
+ * выражения
+ */
+template <class E>
+inline S21MatrixScaledExpr<E> operator*(
+    const S21MatrixExpr<E> &expr,
+    const typename S21ExprScalar<E>::type number) {
+  return S21MatrixScaledExpr<E>(expr.Derived(), number);
+}
+
+template <class E>
+inline S21MatrixScaledExpr<E> operator*(
+    const typename S21ExprScalar<E>::type number,
+    const S21MatrixExpr<E> &expr) {
+  return S21MatrixScaledExpr<E>(expr.Derived(), number);
+}
+
+#endif  // SRC_S21_MATRIX_EXPR_H
@@ -0,0 +1,401 @@
+#include "s21_matrix_gemm.h"
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include "s21_matrix_blas.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+#ifdef S21_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+namespace detail {
+namespace {
+
+// Размер регистрового блока микроядра: kMr строк A на Tile<T>::kNr
+// столбцов B. Строка блока float вдвое короче в байтах, поэтому блок
+// float вдвое шире: в обоих случаях строка занимает два регистра ymm
+const int kMr = 4;
+
+template <class T>
+struct Tile {
+  static const int kNr = 8;
+};
+
+template <>
+struct Tile<float> {
+  static const int kNr = 16;
+};
+
+// Размеры блоков для кэшей: панель B (kKc x kNr) остаётся в L1,
+// блок A (kMc x kKc) - в L2, блок B (kKc x kNc) - в L3
+const int kMc = 128;
+const int kKc = 256;
+const int kNc = 4096;
+// Произведения меньше этого объёма (m * n * k) не окупают упаковку
+const long long kSmallVolume = 32LL * 32 * 32;
+
+/**
+ * @brief Упаковывает блок A (mc x kc) в горизонтальные панели по kMr строк
+ *
+ * @details Внутри панели элементы идут по столбцам, неполная последняя
+ * панель дополняется нулями.
+ */
+template <class T>
+void PackA(int mc, int kc, const T *a, std::ptrdiff_t rs, std::ptrdiff_t cs,
+           T *buffer) {
+  for (int i = 0; i < mc; i += kMr) {
+    const int mr = std::min(kMr, mc - i);
+    const T *panel = a + i * rs;
+    for (int p = 0; p < kc; ++p) {
+      for (int ii = 0; ii < mr; ++ii) {
+        buffer[ii] = panel[ii * rs + p * cs];
+      }
+      for (int ii = mr; ii < kMr; ++ii) {
+        buffer[ii] = T();
+      }
+      buffer += kMr;
+    }
+  }
+}
+
+/**
+ * @brief Упаковывает блок B (kc x nc) в вертикальные панели по kNr столбцов
+ *
+ * @details Внутри панели элементы идут по строкам, неполная последняя
+ * панель дополняется нулями.
+ */
+template <class T>
+void PackB(int kc, int nc, const T *b, std::ptrdiff_t rs, std::ptrdiff_t cs,
+           T *buffer) {
+  const int kNr = Tile<T>::kNr;
+  for (int j = 0; j < nc; j += kNr) {
+    const int nr = std::min(kNr, nc - j);
+    const T *panel = b + j * cs;
+    for (int p = 0; p < kc; ++p) {
+      for (int jj = 0; jj < nr; ++jj) {
+        buffer[jj] = panel[p * rs + jj * cs];
+      }
+      for (int jj = nr; jj < kNr; ++jj) {
+        buffer[jj] = T();
+      }
+      buffer += kNr;
+    }
+  }
+}
+
+/**
+ * @brief Микроядро: C(kMr x kNr) = alpha * A_panel * B_panel + beta * C
+ *
+ * @details Аккумуляторы блока kMr x kNr держатся в регистрах на всём
+ * протяжении цикла по kc.
+ */
+template <class T>
+void MicroKernel(int kc, const T *a, const T *b, T alpha, T beta, T *c,
+                 std::ptrdiff_t c_rs) {
+  const int kNr = Tile<T>::kNr;
+  T ab[kMr][kNr] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kMr; ++i) {
+      const T a_ip = a[i];
+      for (int j = 0; j < kNr; ++j) {
+        ab[i][j] += a_ip * b[j];
+      }
+    }
+    a += kMr;
+    b += kNr;
+  }
+
+  for (int i = 0; i < kMr; ++i) {
+    T *c_row = c + i * c_rs;
+    for (int j = 0; j < kNr; ++j) {
+      c_row[j] = (beta == T()) ? alpha * ab[i][j]
+                               : alpha * ab[i][j] + beta * c_row[j];
+    }
+  }
+}
+
+template <class T>
+using MicroKernelFn = void (*)(int kc, const T *a, const T *b, T alpha,
+                               T beta, T *c, std::ptrdiff_t c_rs);
+
+#ifdef S21_SIMD_X86
+/**
+ * @brief Микроядро на AVX2 + FMA: строка блока kMr x kNr занимает два
+ * регистра ymm, все восемь аккумуляторов живут в регистрах
+ */
+S21_TARGET("avx2,fma")
+void MicroKernelAvx2(int kc, const double *a, const double *b, double alpha,
+                     double beta, double *c, std::ptrdiff_t c_rs) {
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  for (int p = 0; p < kc; ++p) {
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+    __m256d a_i = _mm256_broadcast_sd(a);
+    c00 = _mm256_fmadd_pd(a_i, b0, c00);
+    c01 = _mm256_fmadd_pd(a_i, b1, c01);
+    a_i = _mm256_broadcast_sd(a + 1);
+    c10 = _mm256_fmadd_pd(a_i, b0, c10);
+    c11 = _mm256_fmadd_pd(a_i, b1, c11);
+    a_i = _mm256_broadcast_sd(a + 2);
+    c20 = _mm256_fmadd_pd(a_i, b0, c20);
+    c21 = _mm256_fmadd_pd(a_i, b1, c21);
+    a_i = _mm256_broadcast_sd(a + 3);
+    c30 = _mm256_fmadd_pd(a_i, b0, c30);
+    c31 = _mm256_fmadd_pd(a_i, b1, c31);
+    a += kMr;
+    b += Tile<double>::kNr;
+  }
+
+  const __m256d acc[kMr][2] = {
+      {c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+  const __m256d va = _mm256_set1_pd(alpha);
+  const __m256d vb = _mm256_set1_pd(beta);
+  for (int i = 0; i < kMr; ++i) {
+    double *c_row = c + i * c_rs;
+    for (int h = 0; h < 2; ++h) {
+      __m256d value = _mm256_mul_pd(va, acc[i][h]);
+      if (beta != 0.0) {
+        value = _mm256_fmadd_pd(vb, _mm256_loadu_pd(c_row + 4 * h), value);
+      }
+      _mm256_storeu_pd(c_row + 4 * h, value);
+    }
+  }
+}
+
+/**
+ * @brief Микроядро float на AVX2 + FMA: блок 4 x 16, по восемь чисел в
+ * регистре
+ */
+S21_TARGET("avx2,fma")
+void MicroKernelAvx2(int kc, const float *a, const float *b, float alpha,
+                     float beta, float *c, std::ptrdiff_t c_rs) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  for (int p = 0; p < kc; ++p) {
+    const __m256 b0 = _mm256_loadu_ps(b);
+    const __m256 b1 = _mm256_loadu_ps(b + 8);
+    __m256 a_i = _mm256_broadcast_ss(a);
+    c00 = _mm256_fmadd_ps(a_i, b0, c00);
+    c01 = _mm256_fmadd_ps(a_i, b1, c01);
+    a_i = _mm256_broadcast_ss(a + 1);
+    c10 = _mm256_fmadd_ps(a_i, b0, c10);
+    c11 = _mm256_fmadd_ps(a_i, b1, c11);
+    a_i = _mm256_broadcast_ss(a + 2);
+    c20 = _mm256_fmadd_ps(a_i, b0, c20);
+    c21 = _mm256_fmadd_ps(a_i, b1, c21);
+    a_i = _mm256_broadcast_ss(a + 3);
+    c30 = _mm256_fmadd_ps(a_i, b0, c30);
+    c31 = _mm256_fmadd_ps(a_i, b1, c31);
+    a += kMr;
+    b += Tile<float>::kNr;
+  }
+
+  const __m256 acc[kMr][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+  const __m256 va = _mm256_set1_ps(alpha);
+  const __m256 vb = _mm256_set1_ps(beta);
+  for (int i = 0; i < kMr; ++i) {
+    float *c_row = c + i * c_rs;
+    for (int h = 0; h < 2; ++h) {
+      __m256 value = _mm256_mul_ps(va, acc[i][h]);
+      if (beta != 0.0f) {
+        value = _mm256_fmadd_ps(vb, _mm256_loadu_ps(c_row + 8 * h), value);
+      }
+      _mm256_storeu_ps(c_row + 8 * h, value);
+    }
+  }
+}
+#endif  // S21_SIMD_X86
+
+/**
+ * @brief Выбирает микроядро по текущему S21GetSimdLevel(); векторные ядра
+ * есть только для float и double
+ */
+template <class T>
+MicroKernelFn<T> SelectMicroKernel() {
+  return MicroKernel<T>;
+}
+
+template <class T>
+MicroKernelFn<T> SelectVectorMicroKernel() {
+#ifdef S21_SIMD_X86
+  if (static_cast<int>(S21GetSimdLevel()) >=
+      static_cast<int>(S21SimdLevel::kAvx2)) {
+    return MicroKernelAvx2;
+  }
+#endif
+  return MicroKernel<T>;
+}
+
+template <>
+MicroKernelFn<double> SelectMicroKernel<double>() {
+  return SelectVectorMicroKernel<double>();
+}
+
+template <>
+MicroKernelFn<float> SelectMicroKernel<float>() {
+  return SelectVectorMicroKernel<float>();
+}
+
+/**
+ * @brief Умножает упакованные блоки A (mc x kc) и B (kc x nc)
+ *
+ * @details Краевые блоки считаются во временный буфер и затем
+ * добавляются в C только в пределах матрицы.
+ */
+template <class T>
+void MacroKernel(MicroKernelFn<T> kernel, int mc, int nc, int kc, T alpha,
+                 const T *a_pack, const T *b_pack, T beta, T *c,
+                 std::ptrdiff_t c_rs) {
+  const int kNr = Tile<T>::kNr;
+  for (int j = 0; j < nc; j += kNr) {
+    const int nr = std::min(kNr, nc - j);
+    const T *b_panel = b_pack + static_cast<std::ptrdiff_t>(j) * kc;
+    for (int i = 0; i < mc; i += kMr) {
+      const int mr = std::min(kMr, mc - i);
+      const T *a_panel = a_pack + static_cast<std::ptrdiff_t>(i) * kc;
+      T *c_tile = c + i * c_rs + j;
+      if (mr == kMr && nr == kNr) {
+        kernel(kc, a_panel, b_panel, alpha, beta, c_tile, c_rs);
+        continue;
+      }
+
+      T tile[kMr * kNr];
+      kernel(kc, a_panel, b_panel, alpha, T(), tile, kNr);
+      for (int ii = 0; ii < mr; ++ii) {
+        T *c_row = c_tile + ii * c_rs;
+        for (int jj = 0; jj < nr; ++jj) {
+          c_row[jj] = (beta == T()) ? tile[ii * kNr + jj]
+                                    : tile[ii * kNr + jj] + beta * c_row[jj];
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Умножает C на beta, не читая C при beta == 0
+ */
+template <class T>
+void ScaleC(int m, int n, T beta, T *c, std::ptrdiff_t c_rs) {
+  for (int i = 0; i < m; ++i) {
+    T *c_row = c + i * c_rs;
+    if (beta == T()) {
+      std::fill(c_row, c_row + n, T());
+    } else if (beta != T(1)) {
+      for (int j = 0; j < n; ++j) {
+        c_row[j] *= beta;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Произведение малых матриц без упаковки (порядок циклов i-p-j)
+ */
+template <class T>
+void SmallGemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t a_rs,
+               std::ptrdiff_t a_cs, const T *b, std::ptrdiff_t b_rs,
+               std::ptrdiff_t b_cs, T beta, T *c, std::ptrdiff_t c_rs) {
+  ScaleC(m, n, beta, c, c_rs);
+  for (int i = 0; i < m; ++i) {
+    T *c_row = c + i * c_rs;
+    for (int p = 0; p < k; ++p) {
+      const T a_ip = alpha * a[i * a_rs + p * a_cs];
+      const T *b_row = b + p * b_rs;
+      for (int j = 0; j < n; ++j) {
+        c_row[j] += a_ip * b_row[j * b_cs];
+      }
+    }
+  }
+}
+
+inline int RoundUp(int value, int multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+}  // namespace
+
+template <class T>
+void Gemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t a_rs,
+          std::ptrdiff_t a_cs, const T *b, std::ptrdiff_t b_rs,
+          std::ptrdiff_t b_cs, T beta, T *c, std::ptrdiff_t c_rs) {
+  if (BlasGemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs)) {
+    return;
+  }
+  if (UseStrassen(m, n, k)) {
+    StrassenGemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+  } else {
+    ClassicGemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+  }
+}
+
+template <class T>
+void ClassicGemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t a_rs,
+                 std::ptrdiff_t a_cs, const T *b, std::ptrdiff_t b_rs,
+                 std::ptrdiff_t b_cs, T beta, T *c, std::ptrdiff_t c_rs) {
+  if (m <= 0 || n <= 0) {
+    return;
+  }
+  if (k <= 0 || alpha == T()) {
+    ScaleC(m, n, beta, c, c_rs);
+    return;
+  }
+  if (static_cast<long long>(m) * n * k <= kSmallVolume) {
+    SmallGemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+    return;
+  }
+
+  const MicroKernelFn<T> kernel = SelectMicroKernel<T>();
+  // Блоки A делятся между потоками; при малом m блок уменьшается, чтобы
+  // работы хватило всем потокам
+  const int threads = S21GetThreadCount();
+  const int block_m =
+      std::max(kMr, std::min(kMc, RoundUp((m + threads - 1) / threads, kMr)));
+  const int blocks = (m + block_m - 1) / block_m;
+  std::vector<T> b_pack(
+      static_cast<std::size_t>(RoundUp(std::min(n, kNc), Tile<T>::kNr)) *
+      std::min(k, kKc));
+
+  for (int jc = 0; jc < n; jc += kNc) {
+    const int nc = std::min(kNc, n - jc);
+    for (int pc = 0; pc < k; pc += kKc) {
+      const int kc = std::min(kKc, k - pc);
+      const T beta_pc = (pc == 0) ? beta : T(1);
+      PackB(kc, nc, b + pc * b_rs + jc * b_cs, b_rs, b_cs, b_pack.data());
+      ParallelFor(0, blocks, 2LL * m * nc * kc, [&](int first, int last) {
+        std::vector<T> a_pack(static_cast<std::size_t>(block_m) * kc);
+        for (int block = first; block < last; ++block) {
+          const int ic = block * block_m;
+          const int mc = std::min(block_m, m - ic);
+          PackA(mc, kc, a + ic * a_rs + pc * a_cs, a_rs, a_cs, a_pack.data());
+          MacroKernel(kernel, mc, nc, kc, alpha, a_pack.data(), b_pack.data(),
+                      beta_pc, c + ic * c_rs + jc, c_rs);
+        }
+      });
+    }
+  }
+}
+
+#define S21_INSTANTIATE(T)                                                  \
+  template void Gemm<T>(int, int, int, T, const T *, std::ptrdiff_t,        \
+                        std::ptrdiff_t, const T *, std::ptrdiff_t,          \
+                        std::ptrdiff_t, T, T *, std::ptrdiff_t);            \
+  template void ClassicGemm<T>(int, int, int, T, const T *, std::ptrdiff_t, \
+                               std::ptrdiff_t, const T *, std::ptrdiff_t,   \
+                               std::ptrdiff_t, T, T *, std::ptrdiff_t);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
+
+}  // namespace detail
+}  // namespace s21
@@ -0,0 +1,66 @@
+#ifndef SRC_S21_MATRIX_GEMM_H
+#define SRC_S21_MATRIX_GEMM_H
+
+#include <cstddef>
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Вычисляет C = alpha * A * B + beta * C
+ *
+ * @param m Количество строк A и C
+ * @param n Количество столбцов B и C
+ * @param k Количество столбцов A и строк B
+ * @param a Указатель на A(0, 0); элемент A(i, p) лежит по адресу
+ * a + i * a_rs + p * a_cs
+ * @param b Указатель на B(0, 0); элемент B(p, j) лежит по адресу
+ * b + p * b_rs + j * b_cs
+ * @param c Указатель на C(0, 0); элемент C(i, j) лежит по адресу
+ * c + i * c_rs + j
+ * @details Произвольные шаги строк и столбцов A и B позволяют передавать
+ * транспонированные операнды без копирования. Если beta == 0, исходное
+ * содержимое C не читается. C не должна пересекаться с A и B. Собрано для
+ * всех типов из S21_ELEMENT_TYPES; для float и double есть векторные
+ * микроядра. Произведения, все размеры которых больше
+ * S21GetStrassenCrossover(), в режиме S21MultiplyMode::kFast считаются
+ * StrassenGemm. При S21Backend::kBlas произведение float и double сначала
+ * предлагается BlasGemm.
+ */
+template <class T>
+void Gemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t a_rs,
+          std::ptrdiff_t a_cs, const T *b, std::ptrdiff_t b_rs,
+          std::ptrdiff_t b_cs, T beta, T *c, std::ptrdiff_t c_rs);
+
+/**
+ * @brief Gemm блочным ядром, без перехода к алгоритму Штрассена
+ */
+template <class T>
+void ClassicGemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t a_rs,
+                 std::ptrdiff_t a_cs, const T *b, std::ptrdiff_t b_rs,
+                 std::ptrdiff_t b_cs, T beta, T *c, std::ptrdiff_t c_rs);
+
+/**
+ * @brief Gemm алгоритмом Штрассена-Винограда: 7 умножений половинного
+ * размера вместо 8 на каждом уровне рекурсии
+ *
+ * @details Рекурсия спускается, пока все размеры больше
+ * S21GetStrassenCrossover(), ниже считает ClassicGemm. Параметры те же,
+ * что у Gemm.
+ */
+template <class T>
+void StrassenGemm(int m, int n, int k, T alpha, const T *a,
+                  std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const T *b,
+                  std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, T beta, T *c,
+                  std::ptrdiff_t c_rs);
+
+/**
+ * @brief Выбирает ли Gemm алгоритм Штрассена для произведения m x k на
+ * k x n при текущих настройках
+ */
+bool UseStrassen(int m, int n, int k);
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_GEMM_H
@@ -0,0 +1,549 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <complex>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+const std::uint16_t kByteOrderMark = 0x0102;
+const std::uint16_t kSwappedByteOrderMark = 0x0201;
+// Положение контрольной суммы в заголовке: Close() дописывает её последней
+const std::size_t kChecksumOffset = 40;
+
+const std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+const std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+const std::uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+const std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+const std::uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t Rotl(std::uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * @brief Читает little-endian число из size байт; на little-endian машине
+ * компилятор сводит цикл к одной загрузке
+ */
+inline std::uint64_t LoadLittleEndian(const unsigned char *p,
+                                      std::size_t size) {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    value |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+  }
+  return value;
+}
+
+inline std::uint64_t Round(std::uint64_t acc, std::uint64_t input) {
+  acc += input * kPrime2;
+  return Rotl(acc, 31) * kPrime1;
+}
+
+inline std::uint64_t MergeRound(std::uint64_t acc, std::uint64_t value) {
+  acc ^= Round(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+/**
+ * @brief Меняет порядок байт в каждом из count слов по width байт
+ */
+void ByteSwap(void *data, std::size_t count, std::size_t width) {
+  unsigned char *bytes = static_cast<unsigned char *>(data);
+  for (std::size_t i = 0; i < count; ++i, bytes += width) {
+    std::reverse(bytes, bytes + width);
+  }
+}
+
+template <class U>
+U ReadField(const unsigned char *header, std::size_t offset, bool swapped) {
+  U value;
+  std::memcpy(&value, header + offset, sizeof(U));
+  if (swapped) {
+    ByteSwap(&value, 1, sizeof(U));
+  }
+  return value;
+}
+
+template <class U>
+void WriteField(unsigned char *header, std::size_t offset, U value) {
+  std::memcpy(header + offset, &value, sizeof(U));
+}
+
+/**
+ * @brief Код типа элементов в заголовке файла
+ */
+template <class T>
+struct ElementCode;
+template <>
+struct ElementCode<float> {
+  static const std::uint8_t kValue = 1;
+};
+template <>
+struct ElementCode<double> {
+  static const std::uint8_t kValue = 2;
+};
+template <>
+struct ElementCode<long double> {
+  static const std::uint8_t kValue = 3;
+};
+template <>
+struct ElementCode<std::complex<double> > {
+  static const std::uint8_t kValue = 4;
+};
+
+/**
+ * @brief Поля заголовка, приведённые к порядку байт этой машины
+ */
+struct Header {
+  bool swapped;
+  int rows, cols;
+  std::uint64_t offset;
+  std::uint64_t checksum;
+};
+
+template <class T>
+void EncodeHeader(int rows, int cols, std::uint64_t checksum,
+                  unsigned char *header) {
+  std::memset(header, 0, S21MatrixFileFormat::kHeaderSize);
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  WriteField<std::uint16_t>(header, 8, kByteOrderMark);
+  WriteField<std::uint16_t>(header, 10, S21MatrixFileFormat::kVersion);
+  WriteField<std::uint8_t>(header, 12, ElementCode<T>::kValue);
+  WriteField<std::uint8_t>(header, 13, sizeof(T));
+  WriteField<std::int64_t>(header, 16, rows);
+  WriteField<std::int64_t>(header, 24, cols);
+  WriteField<std::uint64_t>(header, 32, S21MatrixFileFormat::kHeaderSize);
+  WriteField<std::uint64_t>(header, kChecksumOffset, checksum);
+}
+
+/**
+ * @brief Разбирает и проверяет заголовок файла с элементами типа T
+ *
+ * @param file_size Размер файла в байтах; данные должны в нём поместиться
+ * @throw std::runtime_error если это не файл матрицы, версия формата не
+ * поддерживается, тип элементов не T или файл обрезан
+ */
+template <class T>
+Header DecodeHeader(const unsigned char *header, std::uint64_t file_size) {
+  if (std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("Not a matrix file.");
+  }
+  Header result;
+  const std::uint16_t mark = ReadField<std::uint16_t>(header, 8, false);
+  if (mark != kByteOrderMark && mark != kSwappedByteOrderMark) {
+    throw std::runtime_error("Not a matrix file.");
+  }
+  result.swapped = mark == kSwappedByteOrderMark;
+  const bool swapped = result.swapped;
+  if (ReadField<std::uint16_t>(header, 10, swapped) !=
+      S21MatrixFileFormat::kVersion) {
+    throw std::runtime_error("Unsupported matrix file version.");
+  }
+  if (ReadField<std::uint8_t>(header, 12, swapped) != ElementCode<T>::kValue ||
+      ReadField<std::uint8_t>(header, 13, swapped) != sizeof(T)) {
+    throw std::runtime_error("Matrix file has a different element type.");
+  }
+  const std::int64_t rows = ReadField<std::int64_t>(header, 16, swapped);
+  const std::int64_t cols = ReadField<std::int64_t>(header, 24, swapped);
+  result.offset = ReadField<std::uint64_t>(header, 32, swapped);
+  result.checksum = ReadField<std::uint64_t>(header, kChecksumOffset, swapped);
+  if (rows < 0 || rows > INT_MAX || cols < 0 || cols > INT_MAX ||
+      result.offset < S21MatrixFileFormat::kHeaderSize ||
+      result.offset % S21MatrixFileFormat::kDataAlignment != 0) {
+    throw std::runtime_error("Corrupted matrix file header.");
+  }
+  result.rows = static_cast<int>(rows);
+  result.cols = static_cast<int>(cols);
+  const std::uint64_t elements =
+      static_cast<std::uint64_t>(rows) * static_cast<std::uint64_t>(cols);
+  if (file_size < result.offset ||
+      (file_size - result.offset) / sizeof(T) < elements) {
+    throw std::runtime_error("Matrix file is truncated.");
+  }
+  return result;
+}
+
+}  // namespace
+
+namespace s21 {
+namespace detail {
+
+Checksum64::Checksum64()
+    : state_{kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1},
+      tail_(),
+      tail_size_(0),
+      total_(0) {}
+
+/**
+ * @brief Добавляет size байт к хешируемым данным
+ *
+ * @details Данные обрабатываются полосами по 32 байта в четыре
+ * независимых аккумулятора; неполная полоса ждёт следующего вызова.
+ */
+void Checksum64::Update(const void *data, std::size_t size) {
+  if (size == 0) {
+    return;
+  }
+  const unsigned char *p = static_cast<const unsigned char *>(data);
+  total_ += size;
+  if (tail_size_ + size < sizeof(tail_)) {
+    std::memcpy(tail_ + tail_size_, p, size);
+    tail_size_ += size;
+    return;
+  }
+  if (tail_size_ > 0) {
+    const std::size_t fill = sizeof(tail_) - tail_size_;
+    std::memcpy(tail_ + tail_size_, p, fill);
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = Round(state_[i], LoadLittleEndian(tail_ + 8 * i, 8));
+    }
+    p += fill;
+    size -= fill;
+    tail_size_ = 0;
+  }
+  for (; size >= sizeof(tail_); p += sizeof(tail_), size -= sizeof(tail_)) {
+    for (int i = 0; i < 4; ++i) {
+      state_[i] = Round(state_[i], LoadLittleEndian(p + 8 * i, 8));
+    }
+  }
+  std::memcpy(tail_, p, size);
+  tail_size_ = size;
+}
+
+/**
+ * @brief Хеш всех добавленных данных; Update можно вызывать и дальше
+ */
+std::uint64_t Checksum64::Value() const {
+  std::uint64_t h;
+  if (total_ >= sizeof(tail_)) {
+    h = Rotl(state_[0], 1) + Rotl(state_[1], 7) + Rotl(state_[2], 12) +
+        Rotl(state_[3], 18);
+    for (int i = 0; i < 4; ++i) {
+      h = MergeRound(h, state_[i]);
+    }
+  } else {
+    h = state_[2] + kPrime5;
+  }
+  h += total_;
+
+  const unsigned char *p = tail_;
+  std::size_t size = tail_size_;
+  for (; size >= 8; p += 8, size -= 8) {
+    h ^= Round(0, LoadLittleEndian(p, 8));
+    h = Rotl(h, 27) * kPrime1 + kPrime4;
+  }
+  if (size >= 4) {
+    h ^= LoadLittleEndian(p, 4) * kPrime1;
+    h = Rotl(h, 23) * kPrime2 + kPrime3;
+    p += 4;
+    size -= 4;
+  }
+  for (; size > 0; ++p, --size) {
+    h ^= *p * kPrime5;
+    h = Rotl(h, 11) * kPrime1;
+  }
+
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief Создаёт файл и записывает заголовок матрицы rows x cols
+ *
+ * @throw std::invalid_argument если размерность отрицательна
+ * @throw std::runtime_error если файл не удалось создать
+ */
+template <class T>
+S21BasicMatrixWriter<T>::S21BasicMatrixWriter(const std::string &path,
+                                              int rows, int cols)
+    : rows_(rows), cols_(cols), written_(0) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Matrix dimensions must be positive.");
+  }
+  stream_.open(path, std::ios::binary | std::ios::trunc);
+  if (!stream_) {
+    throw std::runtime_error("Cannot open matrix file for writing.");
+  }
+  unsigned char header[S21MatrixFileFormat::kHeaderSize];
+  EncodeHeader<T>(rows, cols, 0, header);
+  stream_.write(reinterpret_cast<const char *>(header), sizeof(header));
+  CheckStream();
+}
+
+/**
+ * @brief Дописывает очередную строку из Cols() элементов
+ *
+ * @throw std::out_of_range если все строки уже записаны
+ * @throw std::runtime_error при ошибке записи
+ */
+template <class T>
+void S21BasicMatrixWriter<T>::WriteRow(const T *row) {
+  if (written_ >= rows_) {
+    throw std::out_of_range("All matrix rows are already written.");
+  }
+  Write(row, cols_);
+  ++written_;
+}
+
+/**
+ * @brief Дописывает строки представления
+ *
+ * @details Строки с единичным шагом столбцов пишутся прямо из памяти
+ * источника, остальные сначала собираются в буфер строки.
+ * @throw std::invalid_argument если длина строк не равна Cols()
+ * @throw std::out_of_range если строк больше, чем осталось записать
+ * @throw std::runtime_error при ошибке записи
+ */
+template <class T>
+void S21BasicMatrixWriter<T>::WriteRows(const S21BasicMatrixView<T> &rows) {
+  if (rows.Cols() != cols_) {
+    throw std::invalid_argument("Row length does not match the matrix file.");
+  }
+  if (rows.Rows() > rows_ - written_) {
+    throw std::out_of_range("All matrix rows are already written.");
+  }
+  buffer_.resize(rows.ColStride() == 1 ? 0 : cols_);
+  for (int i = 0; i < rows.Rows(); ++i) {
+    const T *row = rows.Data() + i * rows.RowStride();
+    if (rows.ColStride() != 1) {
+      for (int j = 0; j < cols_; ++j) {
+        buffer_[j] = rows.Coeff(i, j);
+      }
+      row = buffer_.data();
+    }
+    Write(row, cols_);
+    ++written_;
+  }
+}
+
+/**
+ * @brief Вписывает контрольную сумму в заголовок и закрывает файл
+ *
+ * @details Повторный вызов ничего не делает.
+ * @throw std::runtime_error если записаны не все строки или при ошибке
+ * записи
+ */
+template <class T>
+void S21BasicMatrixWriter<T>::Close() {
+  if (!stream_.is_open()) {
+    return;
+  }
+  if (written_ != rows_) {
+    throw std::runtime_error("Matrix file is incomplete.");
+  }
+  const std::uint64_t checksum = checksum_.Value();
+  stream_.seekp(kChecksumOffset);
+  stream_.write(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+  stream_.close();
+  CheckStream();
+}
+
+template <class T>
+void S21BasicMatrixWriter<T>::Write(const T *data, std::size_t count) {
+  const std::size_t bytes = count * sizeof(T);
+  checksum_.Update(data, bytes);
+  stream_.write(reinterpret_cast<const char *>(data), bytes);
+  CheckStream();
+}
+
+template <class T>
+void S21BasicMatrixWriter<T>::CheckStream() const {
+  if (!stream_) {
+    throw std::runtime_error("Cannot write matrix file.");
+  }
+}
+
+/**
+ * @brief Отображает файл в память и проверяет заголовок
+ *
+ * @throw std::runtime_error если файл не открывается или не отображается,
+ * заголовок не прошёл проверку (см. S21LoadMatrix) или порядок байт файла
+ * отличается от порядка байт машины
+ */
+template <class T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(const std::string &path)
+    : mapping_(nullptr),
+      size_(0),
+      data_(nullptr),
+      rows_(0),
+      cols_(0),
+      checksum_(0) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open matrix file.");
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) <
+          S21MatrixFileFormat::kHeaderSize) {
+    close(fd);
+    throw std::runtime_error("Matrix file is truncated.");
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Cannot map matrix file.");
+  }
+  mapping_ = mapping;
+
+  const unsigned char *bytes = static_cast<const unsigned char *>(mapping_);
+  try {
+    const Header header = DecodeHeader<T>(bytes, size_);
+    if (header.swapped) {
+      throw std::runtime_error("Matrix file byte order differs from host.");
+    }
+    rows_ = header.rows;
+    cols_ = header.cols;
+    checksum_ = header.checksum;
+    data_ = reinterpret_cast<const T *>(bytes + header.offset);
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+}
+
+template <class T>
+S21BasicMappedMatrix<T>::S21BasicMappedMatrix(
+    S21BasicMappedMatrix &&other) noexcept
+    : mapping_(other.mapping_),
+      size_(other.size_),
+      data_(other.data_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      checksum_(other.checksum_) {
+  other.mapping_ = nullptr;
+  other.data_ = nullptr;
+  other.rows_ = other.cols_ = 0;
+}
+
+template <class T>
+S21BasicMappedMatrix<T> &S21BasicMappedMatrix<T>::operator=(
+    S21BasicMappedMatrix &&other) noexcept {
+  if (this != &other) {
+    Unmap();
+    std::swap(mapping_, other.mapping_);
+    std::swap(size_, other.size_);
+    std::swap(data_, other.data_);
+    std::swap(rows_, other.rows_);
+    std::swap(cols_, other.cols_);
+    std::swap(checksum_, other.checksum_);
+  }
+  return *this;
+}
+
+template <class T>
+S21BasicMappedMatrix<T>::~S21BasicMappedMatrix() {
+  Unmap();
+}
+
+/**
+ * @brief Сверяет данные с контрольной суммой из заголовка
+ *
+ * @details Читает весь файл, поэтому стоит столько же, сколько его
+ * загрузка.
+ */
+template <class T>
+bool S21BasicMappedMatrix<T>::VerifyChecksum() const {
+  s21::detail::Checksum64 checksum;
+  checksum.Update(data_, static_cast<std::size_t>(rows_) * cols_ * sizeof(T));
+  return checksum.Value() == checksum_;
+}
+
+template <class T>
+void S21BasicMappedMatrix<T>::Unmap() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, size_);
+    mapping_ = nullptr;
+    data_ = nullptr;
+    rows_ = cols_ = 0;
+  }
+}
+
+/**
+ * @brief Записывает представление в файл
+ *
+ * @throw std::runtime_error при ошибке записи
+ */
+template <class T>
+void S21SaveMatrix(const std::string &path, const S21BasicMatrixView<T> &view) {
+  S21BasicMatrixWriter<T> writer(path, view.Rows(), view.Cols());
+  writer.WriteRows(view);
+  writer.Close();
+}
+
+template <class T>
+void S21SaveMatrix(const std::string &path, const S21BasicMatrix<T> &matrix) {
+  S21SaveMatrix(path, S21BasicMatrixView<T>(matrix));
+}
+
+/**
+ * @brief Читает матрицу из файла в новую матрицу
+ *
+ * @details Строки читаются прямо на свои места в матрице, контрольная
+ * сумма считается по ходу чтения. Файл с другим порядком байт читается с
+ * перестановкой байт в каждом числе (у комплексных - в каждой части).
+ * @throw std::runtime_error если файл не открывается, это не файл матрицы,
+ * версия формата не поддерживается, тип элементов не T, файл обрезан или
+ * контрольная сумма не сходится
+ */
+template <class T>
+S21BasicMatrix<T> S21LoadMatrix(const std::string &path) {
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  if (!stream) {
+    throw std::runtime_error("Cannot open matrix file.");
+  }
+  const std::uint64_t file_size = static_cast<std::uint64_t>(stream.tellg());
+  unsigned char bytes[S21MatrixFileFormat::kHeaderSize];
+  stream.seekg(0);
+  if (!stream.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+    throw std::runtime_error("Matrix file is truncated.");
+  }
+  const Header header = DecodeHeader<T>(bytes, file_size);
+
+  S21BasicMatrix<T> result(header.rows, header.cols);
+  s21::detail::Checksum64 checksum;
+  typedef typename S21MatrixTraits<T>::Real Real;
+  const std::size_t row_bytes = sizeof(T) * header.cols;
+  stream.seekg(header.offset);
+  for (int i = 0; i < header.rows; ++i) {
+    T *row = result.Data() + static_cast<std::size_t>(i) * result.Stride();
+    if (!stream.read(reinterpret_cast<char *>(row), row_bytes)) {
+      throw std::runtime_error("Matrix file is truncated.");
+    }
+    checksum.Update(row, row_bytes);
+    if (header.swapped) {
+      ByteSwap(row, row_bytes / sizeof(Real), sizeof(Real));
+    }
+  }
+  if (checksum.Value() != header.checksum) {
+    throw std::runtime_error("Matrix file checksum mismatch.");
+  }
+  return result;
+}
+
+#define S21_INSTANTIATE(T)                                    \
+  template class S21BasicMatrixWriter<T>;                     \
+  template class S21BasicMappedMatrix<T>;                     \
+  template void S21SaveMatrix(const std::string &,            \
+                              const S21BasicMatrixView<T> &); \
+  template void S21SaveMatrix(const std::string &,            \
+                              const S21BasicMatrix<T> &);     \
+  template S21BasicMatrix<T> S21LoadMatrix<T>(const std::string &);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
@@ -0,0 +1,522 @@
+#include "s21_matrix_oop.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+
+#include "s21_matrix_blas.h"
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace detail {
+namespace {
+// Ширина панели блочного разложения: обновление остатка матрицы
+// выполняется ядром GEMM
+const int kLUBlock = 64;
+
+/**
+ * @brief Раскладывает панель из kb столбцов, начиная со столбца k0
+ *
+ * @details Перестановки строк применяются к строкам целиком, поэтому
+ * уже вычисленная часть L и ещё не обработанные столбцы остаются
+ * согласованными.
+ */
+template <class T>
+int FactorizePanel(T *a, int n, std::ptrdiff_t s, int k0, int kb,
+                   int *pivots) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  int sign = 1;
+  for (int k = k0; k < k0 + kb; ++k) {
+    int pivot_row = k;
+    Real pivot_abs = std::abs(a[k * s + k]);
+    for (int i = k + 1; i < n; ++i) {
+      const Real value = std::abs(a[i * s + k]);
+      if (value > pivot_abs) {
+        pivot_abs = value;
+        pivot_row = i;
+      }
+    }
+
+    pivots[k] = pivot_row;
+    if (pivot_row != k) {
+      std::swap_ranges(a + k * s, a + k * s + n, a + pivot_row * s);
+      sign = -sign;
+    }
+    if (pivot_abs == Real()) {
+      continue;
+    }
+
+    const T *u_row = a + k * s;
+    const T inv_pivot = T(1) / u_row[k];
+    const long long work = static_cast<long long>(n - k) * (k0 + kb - k);
+    ParallelFor(k + 1, n, work, [&](int first, int last) {
+      for (int i = first; i < last; ++i) {
+        T *row = a + i * s;
+        const T l_ik = row[k] * inv_pivot;
+        row[k] = l_ik;
+        for (int j = k + 1; j < k0 + kb; ++j) {
+          row[j] -= l_ik * u_row[j];
+        }
+      }
+    });
+  }
+  return sign;
+}
+
+}  // namespace
+
+/**
+ * @details Разложение блочное, по схеме right-looking: панель из kLUBlock
+ * столбцов раскладывается построчно, затем вычисляется блок строк U справа
+ * от панели и остаток матрицы обновляется одним вызовом GEMM:
+ * A22 -= L21 * U12.
+ */
+template <class T>
+int LuFactor(T *a, int n, std::ptrdiff_t s, int *pivots) {
+  int sign = 1;
+  if (BlasLuFactor(a, n, s, pivots, &sign)) {
+    return sign;
+  }
+  for (int k0 = 0; k0 < n; k0 += kLUBlock) {
+    const int kb = std::min(kLUBlock, n - k0);
+    const int rest = n - k0 - kb;
+    sign *= FactorizePanel(a, n, s, k0, kb, pivots);
+    if (rest == 0) {
+      continue;
+    }
+
+    // U12 = L11^-1 * A12, столбцы U12 независимы
+    const long long work = static_cast<long long>(kb) * kb * rest / 2;
+    ParallelFor(0, rest, work, [&](int first, int last) {
+      for (int k = k0; k < k0 + kb; ++k) {
+        const T *u_row = a + k * s + k0 + kb;
+        for (int i = k + 1; i < k0 + kb; ++i) {
+          const T l_ik = a[i * s + k];
+          T *row = a + i * s + k0 + kb;
+          for (int j = first; j < last; ++j) {
+            row[j] -= l_ik * u_row[j];
+          }
+        }
+      }
+    });
+
+    // A22 -= L21 * U12
+    Gemm(rest, rest, kb, T(-1), a + (k0 + kb) * s + k0, s, 1,
+         a + k0 * s + k0 + kb, s, 1, T(1), a + (k0 + kb) * s + k0 + kb, s);
+  }
+  return sign;
+}
+
+/**
+ * @details Строка i обратной матрицы выражается через уже обращённые
+ * строки i+1..n-1: inv(U)(i, i+1:) = -U(i, i+1:) * inv(U)(i+1:, i+1:) / u_ii.
+ * Исходная строка копируется в work, после чего части строки результата
+ * считаются независимо (и параллельно); вклады строк добавляются справа
+ * налево.
+ */
+template <class T>
+void InvertUpper(T *a, int n, std::ptrdiff_t s, T *work) {
+  for (int i = n - 1; i >= 0; --i) {
+    T *row = a + i * s;
+    const T inv_diag = T(1) / row[i];
+    row[i] = inv_diag;
+    std::copy(row + i + 1, row + n, work + i + 1);
+    const long long volume = static_cast<long long>(n - i) * (n - i) / 2;
+    ParallelFor(i + 1, n, volume, [&](int first, int last) {
+      std::fill(row + first, row + last, T());
+      for (int k = last - 1; k > i; --k) {
+        const T t = work[k];
+        const T *w = a + k * s;
+        for (int j = std::max(k, first); j < last; ++j) {
+          row[j] += t * w[j];
+        }
+      }
+      for (int j = first; j < last; ++j) {
+        row[j] *= -inv_diag;
+      }
+    });
+  }
+}
+
+template <class T>
+typename S21MatrixTraits<T>::Real LuTolerance(const T *a, int n,
+                                              std::ptrdiff_t s) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  Real max_abs = Real();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      max_abs = std::max(max_abs, Real(std::abs(a[i * s + j])));
+    }
+  }
+  return n * std::numeric_limits<Real>::epsilon() * max_abs;
+}
+
+template <class T>
+typename S21MatrixTraits<T>::Real TriangularTolerance(const T *a, int n,
+                                                      std::ptrdiff_t s,
+                                                      bool lower) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  Real max_abs = Real();
+  for (int i = 0; i < n; ++i) {
+    const int first = lower ? 0 : i;
+    const int last = lower ? i + 1 : n;
+    for (int j = first; j < last; ++j) {
+      max_abs = std::max(max_abs, Real(std::abs(a[i * s + j])));
+    }
+  }
+  return n * std::numeric_limits<Real>::epsilon() * max_abs;
+}
+
+template <class T>
+bool LuIsSingular(const T *a, int n, std::ptrdiff_t s,
+                  typename S21MatrixTraits<T>::Real tolerance) {
+  for (int i = 0; i < n; ++i) {
+    if (std::abs(a[i * s + i]) <= tolerance) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @details A = P^T * L * U, поэтому inv(A) = inv(U) * inv(L) * P. Сначала
+ * на месте обращается U, затем столбцы справа налево решается
+ * Y * L = inv(U) (столбец j множителей L сохраняется в work и больше не
+ * нужен), в конце перестановки применяются к столбцам в обратном порядке.
+ */
+template <class T>
+void LuInvert(T *a, int n, std::ptrdiff_t s, const int *pivots, T *work) {
+  if (BlasLuInvert(a, n, s, pivots)) {
+    return;
+  }
+  InvertUpper(a, n, s, work);
+
+  for (int j = n - 2; j >= 0; --j) {
+    for (int i = j + 1; i < n; ++i) {
+      work[i] = a[i * s + j];
+      a[i * s + j] = T();
+    }
+    const long long volume = static_cast<long long>(n) * (n - j);
+    ParallelFor(0, n, volume, [&](int first, int last) {
+      for (int r = first; r < last; ++r) {
+        const T *row = a + r * s;
+        T sum = T();
+        for (int i = j + 1; i < n; ++i) {
+          sum += row[i] * work[i];
+        }
+        a[r * s + j] -= sum;
+      }
+    });
+  }
+
+  ParallelFor(0, n, static_cast<long long>(n) * n, [&](int first, int last) {
+    for (int r = first; r < last; ++r) {
+      T *row = a + r * s;
+      for (int j = n - 2; j >= 0; --j) {
+        std::swap(row[j], row[pivots[j]]);
+      }
+    }
+  });
+}
+
+template <class T>
+void SolveLower(const T *a, int n, std::ptrdiff_t s, bool unit_diagonal, T *x,
+                int m, std::ptrdiff_t xs) {
+  if (BlasSolveTriangular(a, n, s, true, unit_diagonal, x, m, xs)) {
+    return;
+  }
+  const long long work = static_cast<long long>(n) * n * m / 2;
+  ParallelFor(0, m, work, [&](int first, int last) {
+    for (int i = 0; i < n; ++i) {
+      T *x_row = x + i * xs;
+      for (int k = 0; k < i; ++k) {
+        const T l_ik = a[i * s + k];
+        const T *y_row = x + k * xs;
+        for (int j = first; j < last; ++j) {
+          x_row[j] -= l_ik * y_row[j];
+        }
+      }
+      if (!unit_diagonal) {
+        const T inv_diag = T(1) / a[i * s + i];
+        for (int j = first; j < last; ++j) {
+          x_row[j] *= inv_diag;
+        }
+      }
+    }
+  });
+}
+
+template <class T>
+void SolveUpper(const T *a, int n, std::ptrdiff_t s, T *x, int m,
+                std::ptrdiff_t xs) {
+  if (BlasSolveTriangular(a, n, s, false, false, x, m, xs)) {
+    return;
+  }
+  const long long work = static_cast<long long>(n) * n * m / 2;
+  ParallelFor(0, m, work, [&](int first, int last) {
+    for (int i = n - 1; i >= 0; --i) {
+      T *x_row = x + i * xs;
+      for (int k = i + 1; k < n; ++k) {
+        const T u_ik = a[i * s + k];
+        const T *z_row = x + k * xs;
+        for (int j = first; j < last; ++j) {
+          x_row[j] -= u_ik * z_row[j];
+        }
+      }
+      const T inv_diag = T(1) / a[i * s + i];
+      for (int j = first; j < last; ++j) {
+        x_row[j] *= inv_diag;
+      }
+    }
+  });
+}
+
+#define S21_INSTANTIATE(T)                                                    \
+  template int LuFactor<T>(T *, int, std::ptrdiff_t, int *);                  \
+  template S21MatrixTraits<T>::Real LuTolerance<T>(const T *, int,            \
+                                                   std::ptrdiff_t);           \
+  template S21MatrixTraits<T>::Real TriangularTolerance<T>(                    \
+      const T *, int, std::ptrdiff_t, bool);                                  \
+  template bool LuIsSingular<T>(const T *, int, std::ptrdiff_t,               \
+                                S21MatrixTraits<T>::Real);                    \
+  template void LuInvert<T>(T *, int, std::ptrdiff_t, const int *, T *);      \
+  template void SolveLower<T>(const T *, int, std::ptrdiff_t, bool, T *, int, \
+                              std::ptrdiff_t);                                \
+  template void SolveUpper<T>(const T *, int, std::ptrdiff_t, T *, int,       \
+                              std::ptrdiff_t);                                \
+  template void InvertUpper<T>(T *, int, std::ptrdiff_t, T *);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
+
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief LU-разложение матрицы
+ *
+ * @throw std::invalid_argument если матрица не квадратная
+ */
+template <class T>
+S21BasicLU<T> S21BasicMatrix<T>::LU() const {
+  return S21BasicLU<T>(*this);
+}
+
+/**
+ * @brief Раскладывает матрицу: P * A = L * U
+ *
+ * @param matrix Квадратная матрица
+ * @throw std::invalid_argument если матрица не квадратная
+ * @details Вырожденная матрица раскладывается без ошибки, IsSingular()
+ * при этом возвращает true. Матрица считается вырожденной, если модуль
+ * какого-либо ведущего элемента не превосходит n * eps * max|a_ij|.
+ */
+template <class T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T> &matrix)
+    : S21BasicLU(matrix.View()) {}
+
+/**
+ * @brief Раскладывает матрицу, заданную представлением
+ *
+ * @details Элементы копируются один раз - в хранилище множителей.
+ */
+template <class T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrixView<T> &matrix)
+    : lu_(), permutation_(), sign_(1), singular_(false) {
+  if (!matrix.IsSquare()) {
+    throw std::invalid_argument(
+        "LU decomposition is only defined for square matrices.");
+  }
+  const int n = matrix.Rows();
+  lu_ = S21BasicMatrix<T>(matrix);
+  permutation_.resize(n);
+  for (int i = 0; i < n; ++i) {
+    permutation_[i] = i;
+  }
+  if (n == 0) {
+    return;
+  }
+
+  const typename S21MatrixTraits<T>::Real tolerance =
+      s21::detail::LuTolerance(lu_.Data(), n, lu_.Stride());
+  std::vector<int> pivots(n);
+  sign_ = s21::detail::LuFactor(lu_.Data(), n, lu_.Stride(), pivots.data());
+  for (int k = 0; k < n; ++k) {
+    std::swap(permutation_[k], permutation_[pivots[k]]);
+  }
+  singular_ =
+      s21::detail::LuIsSingular(lu_.Data(), n, lu_.Stride(), tolerance);
+}
+
+/**
+ * @brief Определитель исходной матрицы: знак перестановки, умноженный на
+ * произведение диагональных элементов U
+ */
+template <class T>
+T S21BasicLU<T>::Determinant() const {
+  T det = T(sign_);
+  for (int i = 0; i < Size(); ++i) {
+    det *= lu_.At(i, i);
+  }
+  return det;
+}
+
+/**
+ * @brief Решает систему A * X = rhs для всех столбцов rhs
+ *
+ * @param rhs Матрица правых частей с Size() строками
+ * @return Матрица решений той же размерности, что и rhs
+ * @throw std::invalid_argument если число строк rhs не совпадает с
+ * порядком матрицы или матрица вырождена
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T> &rhs) const {
+  const int n = Size();
+  if (rhs.Rows() != n) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  if (singular_) {
+    throw std::invalid_argument(
+        "Matrix is singular; the system has no unique solution.");
+  }
+
+  const int m = rhs.Cols();
+  S21BasicMatrix<T> x(n, m);
+  if (m == 0 || n == 0) {
+    return x;
+  }
+  for (int i = 0; i < n; ++i) {
+    const T *src = rhs.Data() +
+                   static_cast<std::size_t>(permutation_[i]) * rhs.Stride();
+    std::copy(src, src + m,
+              x.Data() + static_cast<std::size_t>(i) * x.Stride());
+  }
+  s21::detail::SolveLower(lu_.Data(), n, lu_.Stride(), true, x.Data(), m,
+                          x.Stride());
+  s21::detail::SolveUpper(lu_.Data(), n, lu_.Stride(), x.Data(), m,
+                          x.Stride());
+  return x;
+}
+
+/**
+ * @brief Определяет, является ли матрица треугольной или симметричной
+ * (эрмитовой)
+ *
+ * @details Проверки прекращаются на первом ненулевом элементе по обе
+ * стороны от диагонали и на первой несимметричной паре элементов, поэтому
+ * для матриц общего вида они дешёвые. Диагональная матрица, в том числе
+ * нулевая, считается верхнетреугольной: Solve для неё идёт по треугольному
+ * пути и для нулевой матрицы сообщает о вырожденности.
+ */
+template <class T>
+S21MatrixStructure S21BasicMatrix<T>::DetectStructure() const {
+  if (data_ == nullptr) {
+    return S21MatrixStructure::kGeneral;
+  }
+  bool lower = true;
+  bool upper = true;
+  for (int i = 0; i < Rows() && (lower || upper); ++i) {
+    const T *row = data_ + static_cast<std::size_t>(i) * Stride();
+    for (int j = 0; j < std::min(i, Cols()) && upper; ++j) {
+      upper = (row[j] == T());
+    }
+    for (int j = i + 1; j < Cols() && lower; ++j) {
+      lower = (row[j] == T());
+    }
+  }
+  if (upper) {
+    return S21MatrixStructure::kUpperTriangular;
+  }
+  if (lower) {
+    return S21MatrixStructure::kLowerTriangular;
+  }
+  if (IsSquare() && s21::detail::IsHermitian(data_, Rows(), Stride(), 1)) {
+    return S21MatrixStructure::kSymmetric;
+  }
+  return S21MatrixStructure::kGeneral;
+}
+
+/**
+ * @brief Решает систему A * X = rhs, не вычисляя обратную матрицу
+ *
+ * @param rhs Матрица правых частей: по одному столбцу на каждую систему
+ * @param structure Строение матрицы. kAuto определяет треугольную и
+ * симметричную матрицу автоматически; для kLowerTriangular и
+ * kUpperTriangular элементы по другую сторону от диагонали не читаются, для
+ * kPositiveDefinite не читаются элементы ниже диагонали.
+ * @return Матрица решений той же размерности, что и rhs
+ * @throw std::invalid_argument если матрица не квадратная, число строк rhs
+ * не совпадает с её порядком, матрица вырождена или для kPositiveDefinite
+ * не положительно определена
+ * @details Треугольные системы решаются прямой или обратной подстановкой за
+ * O(n^2 * m), симметричные положительно определённые - разложением
+ * Холецкого, остальные - через LU-разложение. Чтобы решить несколько систем
+ * с одной матрицей, разложение можно сохранить: S21LU lu = A.LU(), и затем
+ * вызывать lu.Solve().
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(
+    const S21BasicMatrix &rhs, S21MatrixStructure structure) const {
+  if (!IsSquare()) {
+    throw std::invalid_argument(
+        "Linear systems can only be solved for square matrices.");
+  }
+  if (rhs.Rows() != Rows()) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  if (structure == S21MatrixStructure::kAuto) {
+    structure = DetectStructure();
+  }
+  if (structure == S21MatrixStructure::kPositiveDefinite) {
+    return Cholesky().Solve(rhs);
+  }
+  if (structure == S21MatrixStructure::kSymmetric) {
+    const S21BasicCholesky<T> cholesky(*this);
+    if (cholesky.IsPositiveDefinite()) {
+      return cholesky.Solve(rhs);
+    }
+    structure = S21MatrixStructure::kGeneral;
+  }
+  if (structure == S21MatrixStructure::kGeneral) {
+    return LU().Solve(rhs);
+  }
+
+  const int n = Rows();
+  if (n == 0) {
+    return S21BasicMatrix(rhs);
+  }
+  const bool lower = structure == S21MatrixStructure::kLowerTriangular;
+  const Real tolerance =
+      s21::detail::TriangularTolerance(Data(), n, Stride(), lower);
+  if (s21::detail::LuIsSingular(Data(), n, Stride(), tolerance)) {
+    throw std::invalid_argument(
+        "Matrix is singular; the system has no unique solution.");
+  }
+
+  S21BasicMatrix x(rhs);
+  if (x.Data() == nullptr) {
+    return x;
+  }
+  if (lower) {
+    s21::detail::SolveLower(Data(), n, Stride(), false, x.Data(), x.Cols(),
+                            x.Stride());
+  } else {
+    s21::detail::SolveUpper(Data(), n, Stride(), x.Data(), x.Cols(),
+                            x.Stride());
+  }
+  return x;
+}
+
+#define S21_INSTANTIATE(T)                                                \
+  template class S21BasicLU<T>;                                           \
+  template S21BasicLU<T> S21BasicMatrix<T>::LU() const;                   \
+  template S21MatrixStructure S21BasicMatrix<T>::DetectStructure() const; \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::Solve(                    \
+      const S21BasicMatrix<T> &, S21MatrixStructure) const;
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
@@ -0,0 +1,108 @@
+#ifndef SRC_S21_MATRIX_LU_H
+#define SRC_S21_MATRIX_LU_H
+
+#include <cstddef>
+
+#include "s21_matrix_traits.h"
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief LU-разложение квадратной матрицы на месте: P * A = L * U
+ *
+ * @param a Матрица порядка n, строки идут с шагом s
+ * @param pivots Массив из n элементов: на шаге k строка k была переставлена
+ * со строкой pivots[k] (pivots[k] >= k)
+ * @return Знак перестановки: +1 или -1
+ * @details L с единичной диагональю записывается ниже главной диагонали,
+ * U - на ней и выше. Нулевой ведущий элемент не прерывает разложение.
+ * Ведущий элемент выбирается по модулю (std::abs), в том числе для
+ * комплексных матриц. Большие матрицы float и double при
+ * S21Backend::kBlas раскладывает BlasLuFactor.
+ */
+template <class T>
+int LuFactor(T *a, int n, std::ptrdiff_t s, int *pivots);
+
+/**
+ * @brief Порог вырожденности для ведущих элементов U: n * eps * max|a_ij|
+ */
+template <class T>
+typename S21MatrixTraits<T>::Real LuTolerance(const T *a, int n,
+                                              std::ptrdiff_t s);
+
+/**
+ * @brief Порог вырожденности треугольной матрицы: n * eps * max|a_ij| по
+ * элементам её треугольника
+ *
+ * @param lower Читать главную диагональ и элементы ниже неё, иначе -
+ * диагональ и элементы выше
+ */
+template <class T>
+typename S21MatrixTraits<T>::Real TriangularTolerance(const T *a, int n,
+                                                      std::ptrdiff_t s,
+                                                      bool lower);
+
+/**
+ * @brief Проверяет, есть ли среди ведущих элементов U не превосходящие
+ * tolerance по модулю
+ */
+template <class T>
+bool LuIsSingular(const T *a, int n, std::ptrdiff_t s,
+                  typename S21MatrixTraits<T>::Real tolerance);
+
+/**
+ * @brief Обращает матрицу на месте по её LU-разложению
+ *
+ * @param a Результат LuFactor, заменяется на обратную матрицу
+ * @param pivots Перестановки, полученные от LuFactor
+ * @param work Рабочий массив из n элементов
+ * @pre Разложение не вырождено
+ * @details Большие матрицы float и double при S21Backend::kBlas обращает
+ * BlasLuInvert.
+ */
+template <class T>
+void LuInvert(T *a, int n, std::ptrdiff_t s, const int *pivots, T *work);
+
+/**
+ * @brief Обращает верхнетреугольную матрицу на месте
+ *
+ * @param a Матрица порядка n; элементы ниже главной диагонали не читаются
+ * и не изменяются
+ * @param work Рабочий массив из n элементов
+ * @pre Диагональные элементы не равны нулю
+ */
+template <class T>
+void InvertUpper(T *a, int n, std::ptrdiff_t s, T *work);
+
+/**
+ * @brief Решает L * X = B на месте для нижнетреугольной L
+ *
+ * @param a Матрица порядка n; элементы выше главной диагонали не читаются
+ * @param unit_diagonal Считать диагональ L единичной (диагональ не читается)
+ * @param x Матрица B из n строк и m столбцов с шагом строк xs, заменяется
+ * решением
+ * @details Большие системы float и double при S21Backend::kBlas решает
+ * BlasSolveTriangular.
+ */
+template <class T>
+void SolveLower(const T *a, int n, std::ptrdiff_t s, bool unit_diagonal, T *x,
+                int m, std::ptrdiff_t xs);
+
+/**
+ * @brief Решает U * X = B на месте для верхнетреугольной U
+ *
+ * @param a Матрица порядка n; элементы ниже главной диагонали не читаются
+ * @param x Матрица B из n строк и m столбцов с шагом строк xs, заменяется
+ * решением
+ * @details Как и SolveLower, при S21Backend::kBlas может передаваться
+ * BlasSolveTriangular.
+ */
+template <class T>
+void SolveUpper(const T *a, int n, std::ptrdiff_t s, T *x, int m,
+                std::ptrdiff_t xs);
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_LU_H
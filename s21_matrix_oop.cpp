@@ -1,26 +1,47 @@
 #include "s21_matrix_oop.h"
 
-const double S21Matrix::kEpsilon = 1.0e-6;
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#ifdef DEBUG
+#include <cstdio>
+#endif
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_pool.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_transpose.h"
+#include "s21_thread_pool.h"
+
+template <class T>
+constexpr typename S21BasicMatrix<T>::Real S21BasicMatrix<T>::kEpsilon;
+template <class T>
+const std::size_t S21BasicMatrix<T>::kAlignment;
+
+/**
+ * @brief Возвращает шаг строки (в элементах), выровненный так, чтобы каждая
+ * строка начиналась на границе kAlignment байт
+ */
+template <class T>
+int S21BasicMatrix<T>::PaddedStride(int cols) {
+  const int per_line = static_cast<int>(kAlignment / sizeof(T));
+  return (cols + per_line - 1) / per_line * per_line;
+}
 
 /**
  * @brief Выделяет память для матрицы
  *
+ * @details Все элементы хранятся в одном непрерывном буфере, выровненном по
+ * kAlignment байт, построчно с шагом stride_. Если на потоке действует
+ * S21MatrixPoolScope, буфер берётся из пула.
  * @throw std::bad_alloc если не удалось выделить память
  */
-void S21Matrix::AllocateMatrix() {
-  matrix_ = new double *[Rows()];
-  for (int i = 0; i < Rows(); ++i) {
-    matrix_[i] = nullptr;
-  }
-
-  try {
-    for (int i = 0; i < Rows(); ++i) {
-      matrix_[i] = new double[Cols()];
-    }
-  } catch (const std::bad_alloc &e) {
-    DeallocateMatrix();
-    throw;
-  }
+template <class T>
+void S21BasicMatrix<T>::AllocateMatrix() {
+  stride_ = PaddedStride(Cols());
+  data_ = static_cast<T *>(s21::detail::AllocateBuffer(
+      static_cast<std::size_t>(Rows()) * stride_, sizeof(T)));
 }
 
 /**
@@ -33,17 +54,18 @@ void S21Matrix::AllocateMatrix() {
  * размерности S21Matrix
  * @details Если array == nullptr, все элементы матрицы инициализируются нулями.
  */
-void S21Matrix::InitializeMatrix(const double *array) {
-  if (matrix_ == nullptr) {
+template <class T>
+void S21BasicMatrix<T>::InitializeMatrix(const T *array) {
+  if (data_ == nullptr) {
     return;
   }
   for (int i = 0; i < Rows(); ++i) {
-    for (int j = 0; j < Cols(); ++j) {
-      if (array) {
-        (*this)(i, j) = array[i * Cols() + j];
-      } else {
-        (*this)(i, j) = 0.0;
-      }
+    T *row = data_ + static_cast<std::size_t>(i) * Stride();
+    if (array) {
+      std::copy(array + static_cast<std::size_t>(i) * Cols(),
+                array + static_cast<std::size_t>(i + 1) * Cols(), row);
+    } else {
+      std::fill(row, row + Cols(), T());
     }
   }
 }
@@ -51,18 +73,10 @@ void S21Matrix::InitializeMatrix(const double *array) {
 /**
  * @brief Освобождает память выделенную для матрицы
  */
-void S21Matrix::DeallocateMatrix() {
-  if (matrix_ == nullptr) {
-    return;
-  }
-
-  for (int i = 0; i < Rows(); ++i) {
-    if (matrix_[i] != nullptr) {
-      delete[] matrix_[i];
-    }
-  }
-  delete[] matrix_;
-  matrix_ = nullptr;
+template <class T>
+void S21BasicMatrix<T>::DeallocateMatrix() {
+  s21::detail::FreeBuffer(data_);
+  data_ = nullptr;
 }
 
 /**
@@ -75,8 +89,9 @@ void S21Matrix::DeallocateMatrix() {
  *          Выделяет память для матрицы и инициализирует все элементы.
  *          Элементы матрицы инициализируются нулями.
  */
-S21Matrix::S21Matrix(int rows, int cols)
-    : rows_(rows), cols_(cols), matrix_(nullptr) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols), stride_(0), data_(nullptr) {
   if (rows < 0 || cols < 0) {
     throw std::invalid_argument("Matrix dimensions must be positive.");
   }
@@ -98,8 +113,9 @@ S21Matrix::S21Matrix(int rows, int cols)
  *          Выделяет память для матрицы и инициализирует все элементы
  *          Элементы матрицы инициализируются массивом.
  */
-S21Matrix::S21Matrix(int rows, int cols, const double *array)
-    : S21Matrix(rows, cols) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols, const T *array)
+    : S21BasicMatrix(rows, cols) {
   InitializeMatrix(array);
 }
 
@@ -108,21 +124,17 @@ S21Matrix::S21Matrix(int rows, int cols, const double *array)
  *
  * @param other ссылка на исходный объект S21Matrix для перемещения
  */
-S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(0), cols_(0), matrix_(nullptr) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
+    : rows_(0), cols_(0), stride_(0), data_(nullptr) {
   rows_ = other.Rows();
   cols_ = other.Cols();
-  if (other.matrix_ == nullptr) {
-    matrix_ = nullptr;
+  if (other.data_ == nullptr) {
     return;
   }
 
   AllocateMatrix();
-  for (int i = 0; i < other.Rows(); ++i) {
-    for (int j = 0; j < other.Cols(); ++j) {
-      (*this)(i, j) = other(i, j);
-    }
-  }
+  CopyElements(other);
 }
 
 /**
@@ -130,17 +142,25 @@ S21Matrix::S21Matrix(const S21Matrix &other)
  *
  * @param other R-value ссылка на исходный объект S21Matrix для перемещения
  */
-S21Matrix::S21Matrix(S21Matrix &&other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      data_(other.data_) {
   other.rows_ = 0;
   other.cols_ = 0;
-  other.matrix_ = nullptr;
+  other.stride_ = 0;
+  other.data_ = nullptr;
 }
 
 /**
  * @brief Деструктор объекта S21Matrix
  */
-S21Matrix::~S21Matrix() { DeallocateMatrix(); }
+template <class T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
+  DeallocateMatrix();
+}
 
 /**
  * @brief Перегруженный оператор () для доступа к элементам матрицы
@@ -151,13 +171,14 @@ S21Matrix::~S21Matrix() { DeallocateMatrix(); }
  * @throw std::out_of_range если индексы выходят за пределы или матрица не
  выделена
  */
-double &S21Matrix::operator()(int row, int col) {
-  if (matrix_ == nullptr || row < 0 || row >= Rows() || col < 0 ||
+template <class T>
+T &S21BasicMatrix<T>::operator()(int row, int col) {
+  if (data_ == nullptr || row < 0 || row >= Rows() || col < 0 ||
       col >= Cols()) {
     throw std::out_of_range(
         "Matrix index out of range or matrix not allocated.");
   }
-  return matrix_[row][col];
+  return data_[static_cast<std::size_t>(row) * Stride() + col];
 }
 
 /**
@@ -170,13 +191,14 @@ double &S21Matrix::operator()(int row, int col) {
  * @throw std::out_of_range если индексы выходят за пределы или матрица не
  выделена
  */
-const double &S21Matrix::operator()(int row, int col) const {
-  if (matrix_ == nullptr || row < 0 || row >= Rows() || col < 0 ||
+template <class T>
+const T &S21BasicMatrix<T>::operator()(int row, int col) const {
+  if (data_ == nullptr || row < 0 || row >= Rows() || col < 0 ||
       col >= Cols()) {
     throw std::out_of_range(
         "Matrix index out of range or matrix not allocated.");
   }
-  return matrix_[row][col];
+  return data_[static_cast<std::size_t>(row) * Stride() + col];
 }
 
 /**
@@ -185,24 +207,23 @@ const double &S21Matrix::operator()(int row, int col) const {
  * @param other ссылка на исходный объект S21Matrix для перемещения
  * @return Ссылка на скопированный объект
  */
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21BasicMatrix &other) {
   if (this == &other) {
     return *this;
   }
 
-  DeallocateMatrix();
-  rows_ = other.Rows();
-  cols_ = other.Cols();
-  matrix_ = nullptr;
-
-  if (Cols() > 0 && Cols() > 0) {
-    AllocateMatrix();
-    for (int i = 0; i < Rows(); ++i) {
-      for (int j = 0; j < Cols(); ++j) {
-        (*this)(i, j) = other(i, j);
-      }
+  const bool same_shape = Rows() == other.Rows() && Cols() == other.Cols();
+  if (!same_shape || data_ == nullptr) {
+    DeallocateMatrix();
+    rows_ = other.Rows();
+    cols_ = other.Cols();
+    stride_ = 0;
+    if (other.data_ != nullptr) {
+      AllocateMatrix();
     }
   }
+  CopyElements(other);
   return *this;
 }
 
@@ -212,19 +233,56 @@ S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
  * @param other R-value ссылка на исходный объект S21Matrix для перемещения
  * @return Ссылка на скопированный объект
  */
-S21Matrix &S21Matrix::operator=(S21Matrix &&other) {
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    S21BasicMatrix &&other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
   DeallocateMatrix();
 
   rows_ = other.Rows();
   cols_ = other.Cols();
-  matrix_ = other.matrix_;
+  stride_ = other.Stride();
+  data_ = other.data_;
 
-  other.matrix_ = nullptr;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.data_ = nullptr;
   return *this;
 }
 
+/**
+ * @brief Копирует элементы матрицы такой же размерности построчно
+ *
+ * @pre Размерности *this и other совпадают, память *this выделена
+ */
+template <class T>
+void S21BasicMatrix<T>::CopyElements(const S21BasicMatrix &other) {
+  if (data_ == nullptr || other.data_ == nullptr) {
+    return;
+  }
+  for (int i = 0; i < Rows(); ++i) {
+    const T *src =
+        other.data_ + static_cast<std::size_t>(i) * other.Stride();
+    std::copy(src, src + Cols(),
+              data_ + static_cast<std::size_t>(i) * Stride());
+  }
+}
+
 #ifdef DEBUG
-void S21Matrix::Print() const {
+namespace {
+void PrintElement(float value) { printf("%f", value); }
+void PrintElement(double value) { printf("%lf", value); }
+void PrintElement(long double value) { printf("%Lf", value); }
+void PrintElement(std::complex<double> value) {
+  printf("(%lf,%lf)", value.real(), value.imag());
+}
+}  // namespace
+
+template <class T>
+void S21BasicMatrix<T>::Print() const {
   for (int i = 0; i < this->Rows(); ++i) {
     if (i != 0) {
       printf("\n");
@@ -233,16 +291,17 @@ void S21Matrix::Print() const {
       if (j != 0) {
         printf(" ");
       }
-      printf("%lf", (*this)(i, j));
+      PrintElement(At(i, j));
     }
   }
 }
 #endif
 
-S21Matrix S21Matrix::Submatrix(int row, int col) const {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Submatrix(int row, int col) const {
   bool row_passed = false;
   bool column_passed = false;
-  S21Matrix submatrix(this->Rows() - 1, this->Rows() - 1);
+  S21BasicMatrix submatrix(this->Rows() - 1, this->Rows() - 1);
 
   for (int i = 0; i < this->Rows(); ++i) {
     if (i == row) {
@@ -254,204 +313,256 @@ S21Matrix S21Matrix::Submatrix(int row, int col) const {
         continue;
       }
       column_passed = (j > col);
-      submatrix(i - row_passed, j - column_passed) = (*this)(i, j);
+      submatrix.At(i - row_passed, j - column_passed) = At(i, j);
     }
   }
   return submatrix;
 }
 
-double S21Matrix::DetRecursive() const {
-  double det = 0.0;
-  if (Rows() == 1) {
-    return (*this)(0, 0);
-  }
-  if (Rows() == 2) {
-    return (*this)(0, 0) * (*this)(1, 1) - (*this)(0, 1) * (*this)(1, 0);
-  }
-  // https://ru.onlinemschool.com/math/library/matrix/minors/#h2
-  // разложение по первой строке
-  int sign = +1;
-  for (int k = 0; k < Rows(); ++k) {
-    S21Matrix submatrix = this->Submatrix(0, k);
-    det += sign * (*this)(0, k) * submatrix.DetRecursive();
-    sign = -sign;
-  }
-
-  return det;
+/**
+ * @brief Определитель матрицы
+ *
+ * @details Для порядка не выше 3 используются явные формулы, для больших
+ * матриц - LU-разложение за O(n^3).
+ * @throw std::invalid_argument если матрица не квадратная
+ */
+template <class T>
+T S21BasicMatrix<T>::Determinant() const {
+  return View().Determinant();
 }
 
-double S21Matrix::Determinant() const {
-  if (!IsSquare()) {
-    throw std::invalid_argument(
-        "Determinant is only defined for square matrices.");
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  S21BasicMatrix transpose(Cols(), Rows());
+  if (data_ != nullptr) {
+    s21::detail::Transpose(Rows(), Cols(), data_, Stride(), transpose.data_,
+                           transpose.Stride());
   }
-
-  return this->DetRecursive();
+  return transpose;
 }
 
-S21Matrix S21Matrix::Transpose() const {
-  S21Matrix transpose(Cols(), Rows());
-  for (int i = 0; i < Rows(); ++i) {
-    for (int j = 0; j < Cols(); ++j) {
-      transpose(j, i) = (*this)(i, j);
-    }
+/**
+ * @brief Транспонирует матрицу без выделения второй матрицы
+ *
+ * @details Квадратная матрица транспонируется блоками на месте. Строки
+ * прямоугольной матрицы сначала уплотняются (шаг строки становится равен
+ * числу столбцов), затем перестановка элементов обходится по циклам; из
+ * дополнительной памяти нужна только битовая маска (1 бит на элемент).
+ * Если строкам результата с выравниванием не хватает прежнего буфера, он
+ * заранее расширяется через s21::detail::GrowBuffer до нужного размера:
+ * вторая копия матрицы не создаётся, а шаг строки остаётся выровненным.
+ * @throw std::bad_alloc если буфер не удалось расширить; матрица при этом
+ * не меняется
+ */
+template <class T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (data_ == nullptr) {
+    std::swap(rows_, cols_);
+    return;
   }
-  return transpose;
+  if (IsSquare()) {
+    s21::detail::TransposeSquareInPlace(data_, Rows(), Stride());
+    return;
+  }
+
+  const int padded = PaddedStride(Rows());
+  data_ = static_cast<T *>(s21::detail::GrowBuffer(
+      data_, static_cast<std::size_t>(Cols()) * padded, sizeof(T)));
+  for (int i = 1; i < Rows(); ++i) {
+    std::copy(RowData(i), RowData(i) + Cols(),
+              data_ + static_cast<std::size_t>(i) * Cols());
+  }
+  s21::detail::TransposeCompactInPlace(data_, Rows(), Cols());
+  std::swap(rows_, cols_);
+  for (int i = Rows() - 1; i > 0; --i) {
+    const T *row = data_ + static_cast<std::size_t>(i) * Cols();
+    std::copy_backward(row, row + Cols(),
+                       data_ + static_cast<std::size_t>(i) * padded + Cols());
+  }
+  stride_ = padded;
 }
 
-S21Matrix S21Matrix::MinorMatrix() const {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::MinorMatrix() const {
   if (!IsSquare()) {
     throw std::invalid_argument(
         "Minor matrix is only defined for square matrices.");
   }
 
-  S21Matrix M(Cols(), Rows());
+  S21BasicMatrix M(Cols(), Rows());
   for (int i = 0; i < Rows(); ++i) {
     for (int j = 0; j < Cols(); ++j) {
-      S21Matrix submatrix = Submatrix(i, j);
-      M(i, j) = submatrix.Determinant();
+      S21BasicMatrix submatrix = Submatrix(i, j);
+      M.At(i, j) = submatrix.Determinant();
     }
   }
 
   return M;
 }
 
-S21Matrix S21Matrix::CalcComplements() const {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   if (!IsSquare()) {
     throw std::invalid_argument(
         "Minor matrix is only defined for square matrices.");
   }
 
-  S21Matrix result = this->MinorMatrix();
+  S21BasicMatrix result = this->MinorMatrix();
   for (int i = 0; i < Rows(); ++i) {
     for (int j = 0; j < Cols(); ++j) {
-      int sign = pow(-1, i + j);
-      result(i, j) = sign * result(i, j);
+      if ((i + j) % 2 != 0) {
+        result.At(i, j) = -result.At(i, j);
+      }
     }
   }
   return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
-  if (!IsSquare()) {
-    throw std::invalid_argument(
-        "Determinant is only defined for square matrices.");
-  }
-
-  double det = Determinant();
-  if (det == 0) {
-    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
-  }
-
-  S21Matrix M = CalcComplements();
-  S21Matrix MT = M.Transpose();
-  return MT * (1.0 / det);
+/**
+ * @brief Обратная матрица
+ *
+ * @throw std::invalid_argument если матрица не квадратная или вырождена
+ * @see S21MatrixView::InverseMatrix
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const {
+  return View().InverseMatrix();
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) const {
+template <class T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix &other) const {
   if (this->Cols() != other.Cols() || this->Rows() != other.Rows()) {
     return false;
   }
 
-  for (int i = 0; i < this->Rows(); ++i) {
-    for (int j = 0; j < this->Cols(); ++j) {
-      if (fabs((*this)(i, j) - other(i, j)) > kEpsilon) {
-        return false;
+  if (data_ == nullptr || other.data_ == nullptr) {
+    return true;
+  }
+  const s21::detail::ElementwiseKernels<T> &kernels =
+      s21::detail::Kernels<T>();
+  std::atomic<bool> equal(true);
+  s21::detail::ParallelFor(0, Rows(), Length(), [&](int first, int last) {
+    for (int i = first; i < last && equal.load(std::memory_order_relaxed);
+         ++i) {
+      if (!kernels.equal(RowData(i), other.RowData(i), Cols(), kEpsilon)) {
+        equal.store(false, std::memory_order_relaxed);
       }
     }
-  }
-  return true;
+  });
+  return equal.load();
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other) const {
   return *this == other;
 }
 
-S21Matrix &S21Matrix::operator+=(const S21Matrix &other) {
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(const S21BasicMatrix &other) {
   const bool is_equeal_size =
       (this->Rows() == other.Rows() && this->Cols() == other.Cols());
   if (!is_equeal_size) {
-    throw std::invalid_argument(
-        "Matrices must have the same dimensions for addition.");
+    throw std::invalid_argument(S21AddOp::DimensionError());
   }
-  for (int i = 0; i < this->Rows(); ++i) {
-    for (int j = 0; j < this->Cols(); ++j) {
-      (*this)(i, j) = (*this)(i, j) + other(i, j);
-    }
+  if (data_ == nullptr) {
+    return *this;
   }
+  const s21::detail::ElementwiseKernels<T> &kernels =
+      s21::detail::Kernels<T>();
+  s21::detail::ParallelFor(0, Rows(), Length(), [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      kernels.add(RowData(i), other.RowData(i), Cols());
+    }
+  });
   return *this;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) { *this += other; }
-
-S21Matrix S21Matrix::operator+(const S21Matrix &other) const {
-  S21Matrix result(*this);
-  result += other;
-  return result;
+template <class T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix &other) {
+  *this += other;
 }
 
-S21Matrix &S21Matrix::operator-=(const S21Matrix &other) {
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(const S21BasicMatrix &other) {
   const bool is_equeal_size =
       (this->Rows() == other.Rows() && this->Cols() == other.Cols());
   if (!is_equeal_size) {
-    throw std::invalid_argument(
-        "Matrices must have the same dimensions for addition.");
+    throw std::invalid_argument(S21SubOp::DimensionError());
   }
-  for (int i = 0; i < this->Rows(); ++i) {
-    for (int j = 0; j < this->Cols(); ++j) {
-      (*this)(i, j) = (*this)(i, j) - other(i, j);
-    }
+  if (data_ == nullptr) {
+    return *this;
   }
+  const s21::detail::ElementwiseKernels<T> &kernels =
+      s21::detail::Kernels<T>();
+  s21::detail::ParallelFor(0, Rows(), Length(), [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      kernels.sub(RowData(i), other.RowData(i), Cols());
+    }
+  });
   return *this;
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) { *this -= other; }
-
-S21Matrix S21Matrix::operator-(const S21Matrix &other) const {
-  S21Matrix result(*this);
-  result -= other;
-  return result;
+template <class T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix &other) {
+  *this -= other;
 }
 
-S21Matrix &S21Matrix::operator*=(const double number) {
-  for (int i = 0; i < this->Rows(); ++i) {
-    for (int j = 0; j < this->Cols(); ++j) {
-      (*this)(i, j) = (*this)(i, j) * number;
-    }
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const T number) {
+  if (data_ == nullptr) {
+    return *this;
   }
+  const s21::detail::ElementwiseKernels<T> &kernels =
+      s21::detail::Kernels<T>();
+  s21::detail::ParallelFor(0, Rows(), Length(), [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      kernels.scale(RowData(i), number, Cols());
+    }
+  });
   return *this;
 }
 
-void S21Matrix::MulNumber(const double number) { *this *= number; }
+template <class T>
+void S21BasicMatrix<T>::MulNumber(const T number) {
+  *this *= number;
+}
 
-S21Matrix S21Matrix::operator*(const double number) const {
-  S21Matrix result(*this);
-  result *= number;
-  return result;
+template <class T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const S21BasicMatrix &other) {
+  *this = *this * other;
+  return *this;
+}
+
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix &other) {
+  *this *= other;
 }
 
-S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
+/**
+ * @brief Произведение матриц
+ *
+ * @details Считается блочным ядром GEMM с упаковкой панелей, результат
+ * записывается сразу в новую матрицу без промежуточных копий.
+ * @throw std::invalid_argument если число столбцов *this не равно числу
+ * строк other
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix &other) const {
   if (this->Cols() != other.Rows()) {
     throw std::invalid_argument(
         "Matrices must have compatible dimensions for multiplication.");
   }
 
-  S21Matrix result(this->Rows(), other.Cols());
-  for (int i = 0; i < result.Rows(); ++i) {
-    for (int j = 0; j < result.Cols(); ++j) {
-      for (int k = 0; k < this->Cols(); ++k) {
-        result(i, j) += (*this)(i, k) * other(k, j);
-      }
-    }
+  S21BasicMatrix result(this->Rows(), other.Cols());
+  if (result.data_ != nullptr && data_ != nullptr) {
+    s21::detail::Gemm(Rows(), other.Cols(), Cols(), T(1), data_, Stride(), 1,
+                      other.data_, other.Stride(), 1, T(), result.data_,
+                      result.Stride());
   }
-  *this = std::move(result);
-  return *this;
-}
-
-void S21Matrix::MulMatrix(const S21Matrix &other) { *this *= other; }
-
-S21Matrix S21Matrix::operator*(const S21Matrix &other) const {
-  S21Matrix result(*this);
-  result *= other;
   return result;
 }
+
+#define S21_INSTANTIATE(T) template class S21BasicMatrix<T>;
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
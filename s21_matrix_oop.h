@@ -2,64 +2,855 @@
 #define SRC_S21_MATRIX_OOP_H
 
 #include <cmath>
+#include <cstddef>
 #ifdef DEBUG
 #include <cstdio>
 #endif
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-class S21Matrix {
+#include "s21_matrix_expr.h"
+#include "s21_matrix_pool.h"
+#include "s21_matrix_traits.h"
+#include "s21_thread_pool.h"
+
+template <class T>
+class S21BasicLU;
+template <class T>
+class S21BasicCholesky;
+template <class T>
+class S21BasicQR;
+template <class T>
+class S21BasicMatrixView;
+
+template <class T>
+struct S21ExprScalar<S21BasicMatrix<T> > {
+  typedef T type;
+};
+template <class T>
+struct S21ExprScalar<S21BasicMatrixView<T> > {
+  typedef T type;
+};
+
+typedef S21BasicMatrix<double> S21Matrix;
+typedef S21BasicMatrixView<double> S21MatrixView;
+typedef S21BasicLU<double> S21LU;
+typedef S21BasicCholesky<double> S21Cholesky;
+typedef S21BasicQR<double> S21QR;
+
+/**
+ * @brief Набор векторных инструкций для вычислительных ядер
+ */
+enum class S21SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+S21SimdLevel S21DetectSimdLevel();
+S21SimdLevel S21GetSimdLevel();
+void S21SetSimdLevel(S21SimdLevel level);
+
+/**
+ * @brief Алгоритм умножения больших матриц
+ *
+ * @details kFast - алгоритм Штрассена-Винограда для произведений, все
+ * размеры которых больше S21GetStrassenCrossover(): он выполняет меньше
+ * операций, но ошибка округления у него растёт с глубиной рекурсии.
+ * kAccurate - всегда обычное блочное произведение.
+ */
+enum class S21MultiplyMode { kAccurate, kFast };
+
+S21MultiplyMode S21GetMultiplyMode();
+void S21SetMultiplyMode(S21MultiplyMode mode);
+int S21GetStrassenCrossover();
+void S21SetStrassenCrossover(int size);
+
+/**
+ * @brief Реализация умножения, LU-разложения, обращения и треугольных
+ * решений для float и double
+ *
+ * @details kBlas - внешние CBLAS (gemm, trsm) и LAPACK (getrf, getri),
+ * доступные при сборке с make BLAS=openblas или BLAS=generic; малые
+ * матрицы и операнды с неподходящими шагами и тогда считаются
+ * собственными ядрами. kNative - всегда собственные ядра.
+ */
+enum class S21Backend { kNative, kBlas };
+
+bool S21HasBlas();
+S21Backend S21GetBackend();
+void S21SetBackend(S21Backend backend);
+
+/**
+ * @brief Строение матрицы системы для S21Matrix::Solve
+ *
+ * @details kSymmetric - симметричная (эрмитова) матрица: сначала
+ * пробуется разложение Холецкого, для неположительно определённой
+ * матрицы используется LU. kPositiveDefinite - только Холецкий.
+ */
+enum class S21MatrixStructure {
+  kAuto,
+  kGeneral,
+  kLowerTriangular,
+  kUpperTriangular,
+  kSymmetric,
+  kPositiveDefinite
+};
+
+/**
+ * @brief Невладеющее представление строки матрицы: указатель и длина
+ *
+ * @details Индексы проверяются только в отладочной сборке (-DDEBUG).
+ * Представление действительно, пока матрица не перевыделила память.
+ */
+template <class T>
+class S21RowSpan {
+ public:
+  S21RowSpan(T *data, int size) : data_(data), size_(size) {}
+
+  inline T *data() const { return data_; }
+  inline int size() const { return size_; }
+  inline T *begin() const { return data_; }
+  inline T *end() const { return data_ + size_; }
+  inline T &operator[](int index) const {
+#ifdef DEBUG
+    if (index < 0 || index >= size_) {
+      throw std::out_of_range("Row index out of range.");
+    }
+#endif
+    return data_[index];
+  }
+
+ private:
+  T *data_;
+  int size_;
+};
+
+typedef S21RowSpan<double> S21MatrixRow;
+typedef S21RowSpan<const double> S21ConstMatrixRow;
+
+/**
+ * @brief Плотная матрица с элементами типа T
+ *
+ * @details S21Matrix - матрица чисел double. Функции, определённые вне
+ * заголовка, собраны для типов из S21_ELEMENT_TYPES; точность сравнения
+ * kEpsilon задаётся S21MatrixTraits<T>.
+ */
+template <class T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T> > {
   int rows_, cols_;
-  double **matrix_;
+  int stride_;
+  T *data_;
 
  public:
-  static const double kEpsilon;
-  S21Matrix() : rows_(0), cols_(0), matrix_(nullptr){};
-  S21Matrix(int rows, int cols);
-  S21Matrix(int rows, int cols, const double array[]);
-  S21Matrix(const S21Matrix &other);
-  S21Matrix(S21Matrix &&other);
-  ~S21Matrix();
+  typedef T Scalar;
+  typedef typename S21MatrixTraits<T>::Real Real;
+  typedef S21RowSpan<T> RowType;
+  typedef S21RowSpan<const T> ConstRowType;
+
+  static constexpr Real kEpsilon = S21MatrixTraits<T>::kEpsilon;
+  static const std::size_t kAlignment = 64;
+  S21BasicMatrix() : rows_(0), cols_(0), stride_(0), data_(nullptr){};
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(int rows, int cols, const T array[]);
+  S21BasicMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix(S21BasicMatrix &&other) noexcept;
+  template <class E>
+  S21BasicMatrix(const S21MatrixExpr<E> &expr);
+  S21BasicMatrix(const S21BasicMatrixView<T> &view);
+  ~S21BasicMatrix();
 
   inline int Rows() const { return rows_; }
   inline int Cols() const { return cols_; }
-  inline double Epsilon() const { return kEpsilon; }
+  inline Real Epsilon() const { return kEpsilon; }
   inline int Length() const { return Rows() * Cols(); }
   inline bool IsSquare() const { return Rows() == Cols(); }
+  inline int Stride() const { return stride_; }
+  inline T *Data() { return data_; }
+  inline const T *Data() const { return data_; }
+  inline T Coeff(int row, int col) const {
+    return data_[static_cast<std::size_t>(row) * stride_ + col];
+  }
   void Print() const;
 
-  bool EqMatrix(const S21Matrix &other) const;
-  bool operator==(const S21Matrix &other) const;
-  void SumMatrix(const S21Matrix &other);
-  S21Matrix &operator+=(const S21Matrix &other);
-  S21Matrix operator+(const S21Matrix &other) const;
-  void SubMatrix(const S21Matrix &other);
-  S21Matrix &operator-=(const S21Matrix &other);
-  S21Matrix operator-(const S21Matrix &other) const;
-  void MulNumber(const double number);
-  S21Matrix &operator*=(const double number);
-  S21Matrix operator*(const double number) const;
-  void MulMatrix(const S21Matrix &other);
-  S21Matrix &operator*=(const S21Matrix &other);
-  S21Matrix operator*(const S21Matrix &other) const;
-
-  S21Matrix Transpose() const;
-  S21Matrix CalcComplements() const;
-  double Determinant() const;
-  S21Matrix InverseMatrix() const;
-
-  S21Matrix &operator=(const S21Matrix &other);
-  S21Matrix &operator=(S21Matrix &&other);
-  double &operator()(int row, int col);
-  const double &operator()(int row, int col) const;
+  bool EqMatrix(const S21BasicMatrix &other) const;
+  bool operator==(const S21BasicMatrix &other) const;
+  void SumMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix &operator+=(const S21BasicMatrix &other);
+  template <class E>
+  S21BasicMatrix &operator+=(const S21MatrixExpr<E> &expr);
+  void SubMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &other);
+  template <class E>
+  S21BasicMatrix &operator-=(const S21MatrixExpr<E> &expr);
+  void MulNumber(const T number);
+  S21BasicMatrix &operator*=(const T number);
+  void MulMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const S21BasicMatrix &other);
+  S21BasicMatrix operator*(const S21BasicMatrix &other) const;
+
+  S21BasicMatrix Transpose() const;
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements() const;
+  T Determinant() const;
+  S21BasicLU<T> LU() const;
+  S21BasicCholesky<T> Cholesky() const;
+  S21BasicQR<T> QR() const;
+  S21BasicMatrix Solve(
+      const S21BasicMatrix &rhs,
+      S21MatrixStructure structure = S21MatrixStructure::kAuto) const;
+  S21MatrixStructure DetectStructure() const;
+  S21BasicMatrix LeastSquares(const S21BasicMatrix &rhs) const;
+  S21BasicMatrix InverseMatrix() const;
+
+  S21BasicMatrixView<T> View() const;
+  S21BasicMatrixView<T> TransposedView() const;
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView<T> Slice(int row, int col, int rows, int cols,
+                              int row_step, int col_step) const;
+
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator=(S21BasicMatrix &&other) noexcept;
+  template <class E>
+  S21BasicMatrix &operator=(const S21MatrixExpr<E> &expr);
+  T &operator()(int row, int col);
+  const T &operator()(int row, int col) const;
+
+  inline T &At(int row, int col) {
+    CheckIndexDebug(row, col);
+    return RowData(row)[col];
+  }
+  inline const T &At(int row, int col) const {
+    CheckIndexDebug(row, col);
+    return RowData(row)[col];
+  }
+  inline T *operator[](int row) {
+    CheckIndexDebug(row, 0);
+    return RowData(row);
+  }
+  inline const T *operator[](int row) const {
+    CheckIndexDebug(row, 0);
+    return RowData(row);
+  }
+  inline RowType Row(int row) {
+    CheckIndexDebug(row, 0);
+    return RowType(RowData(row), Cols());
+  }
+  inline ConstRowType Row(int row) const {
+    CheckIndexDebug(row, 0);
+    return ConstRowType(RowData(row), Cols());
+  }
 
  private:
   void AllocateMatrix();
-  void InitializeMatrix(const double *);
+  void InitializeMatrix(const T *);
+  void CopyElements(const S21BasicMatrix &other);
   void DeallocateMatrix();
+  static int PaddedStride(int cols);
+  inline void CheckIndexDebug(int row, int col) const {
+#ifdef DEBUG
+    if (data_ == nullptr || row < 0 || row >= Rows() || col < 0 ||
+        col >= Cols()) {
+      throw std::out_of_range(
+          "Matrix index out of range or matrix not allocated.");
+    }
+#else
+    (void)row;
+    (void)col;
+#endif
+  }
+  inline T *RowData(int row) {
+    return data_ + static_cast<std::size_t>(row) * stride_;
+  }
+  inline const T *RowData(int row) const {
+    return data_ + static_cast<std::size_t>(row) * stride_;
+  }
+  template <class E, class Op>
+  void AssignExpr(const S21MatrixExpr<E> &expr);
+
+  template <class U, class L>
+  friend S21BasicMatrix<U> operator-(const S21MatrixExpr<L> &lhs,
+                                     S21BasicMatrix<U> &&rhs);
+
+  S21BasicMatrix Submatrix(int row, int col) const;
+  S21BasicMatrix MinorMatrix() const;
+};
+
+/**
+ * @brief Невладеющее представление матрицы: указатель, размерность и шаги
+ * строки и столбца
+ *
+ * @details Элемент (i, j) лежит по адресу Data() + i * RowStride() +
+ * j * ColStride(), поэтому транспонирование, выделение блока и
+ * прореживание строк и столбцов не копируют элементы. Представление
+ * участвует в поэлементных выражениях наравне с S21Matrix и действительно,
+ * пока матрица-источник жива и не перевыделила память.
+ */
+template <class T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T> > {
+ public:
+  typedef T Scalar;
+
+  S21BasicMatrixView()
+      : data_(nullptr), rows_(0), cols_(0), row_stride_(0), col_stride_(0) {}
+  S21BasicMatrixView(const T *data, int rows, int cols,
+                     std::ptrdiff_t row_stride, std::ptrdiff_t col_stride);
+  explicit S21BasicMatrixView(const S21BasicMatrix<T> &matrix);
+
+  inline int Rows() const { return rows_; }
+  inline int Cols() const { return cols_; }
+  inline bool IsSquare() const { return Rows() == Cols(); }
+  inline const T *Data() const { return data_; }
+  inline std::ptrdiff_t RowStride() const { return row_stride_; }
+  inline std::ptrdiff_t ColStride() const { return col_stride_; }
+  inline T Coeff(int row, int col) const {
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+  inline const T &At(int row, int col) const {
+#ifdef DEBUG
+    CheckIndex(row, col);
+#endif
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+  const T &operator()(int row, int col) const;
+
+  S21BasicMatrixView Transpose() const;
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView Slice(int row, int col, int rows, int cols, int row_step,
+                           int col_step) const;
+
+  bool EqMatrix(const S21BasicMatrixView &other) const;
+  /**
+   * @brief Пересекается ли память представления с памятью матрицы
+   */
+  bool Overlaps(const S21BasicMatrix<T> &matrix) const;
+  T Determinant() const;
+  S21BasicLU<T> LU() const;
+  S21BasicMatrix<T> InverseMatrix() const;
+
+ private:
+  void CheckIndex(int row, int col) const;
+  T DetSmall() const;
+
+  const T *data_;
+  int rows_, cols_;
+  std::ptrdiff_t row_stride_, col_stride_;
+};
+
+/**
+ * @brief Сравнение и произведение с представлениями работают прямо с
+ * памятью источников, без копирования операндов
+ */
+template <class T>
+bool operator==(const S21BasicMatrixView<T> &lhs,
+                const S21BasicMatrixView<T> &rhs);
+template <class T>
+bool operator==(const S21BasicMatrix<T> &lhs,
+                const S21BasicMatrixView<T> &rhs);
+template <class T>
+bool operator==(const S21BasicMatrixView<T> &lhs,
+                const S21BasicMatrix<T> &rhs);
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &lhs,
+                            const S21BasicMatrixView<T> &rhs);
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &lhs,
+                            const S21BasicMatrixView<T> &rhs);
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &lhs,
+                            const S21BasicMatrix<T> &rhs);
+
+/**
+ * @brief Используется ли операнд S21Gemm как есть или транспонированным
+ */
+enum class S21Transpose { kNoTrans, kTrans };
+
+/**
+ * @brief Вычисляет C = alpha * op(A) * op(B) + beta * C
+ *
+ * @details op(X) - это X или X^T в зависимости от trans_a и trans_b;
+ * транспонирование только меняет шаги, операнды не копируются, а
+ * результат накапливается прямо в C без временных матриц. Если beta == 0,
+ * исходное содержимое C не читается, и C получает размерность
+ * произведения. Если C занимает ту же память, что и A или B, произведение
+ * считается во временный буфер.
+ * @throw std::invalid_argument если число столбцов op(A) не равно числу
+ * строк op(B) или, при beta != 0, размерность C не совпадает с размерностью
+ * произведения
+ */
+template <class T>
+void S21Gemm(T alpha, const S21BasicMatrixView<T> &a, S21Transpose trans_a,
+             const S21BasicMatrixView<T> &b, S21Transpose trans_b, T beta,
+             S21BasicMatrix<T> *c);
+
+template <class T>
+inline void S21Gemm(T alpha, const S21BasicMatrix<T> &a, S21Transpose trans_a,
+                    const S21BasicMatrix<T> &b, S21Transpose trans_b, T beta,
+                    S21BasicMatrix<T> *c) {
+  S21Gemm(alpha, a.View(), trans_a, b.View(), trans_b, beta, c);
+}
+
+template <class T>
+inline void S21Gemm(T alpha, const S21BasicMatrix<T> &a, S21Transpose trans_a,
+                    const S21BasicMatrixView<T> &b, S21Transpose trans_b,
+                    T beta, S21BasicMatrix<T> *c) {
+  S21Gemm(alpha, a.View(), trans_a, b, trans_b, beta, c);
+}
+
+template <class T>
+inline void S21Gemm(T alpha, const S21BasicMatrixView<T> &a,
+                    S21Transpose trans_a, const S21BasicMatrix<T> &b,
+                    S21Transpose trans_b, T beta, S21BasicMatrix<T> *c) {
+  S21Gemm(alpha, a, trans_a, b.View(), trans_b, beta, c);
+}
+
+/**
+ * @brief Читает ли выражение память матрицы по другим индексам
+ *
+ * @details Матрица-операнд читается только по тем же индексам, по которым
+ * пишется результат, поэтому даже совпадение с приёмником безопасно.
+ * Представление может читать приёмник по чужим индексам, и его пересечение
+ * с приёмником проверяется по адресам.
+ */
+template <class T>
+inline bool S21ExprOverlaps(const S21BasicMatrix<T> &,
+                            const S21BasicMatrix<T> &) {
+  return false;
+}
+
+template <class T>
+inline bool S21ExprOverlaps(const S21BasicMatrixView<T> &view,
+                            const S21BasicMatrix<T> &matrix) {
+  return view.Overlaps(matrix);
+}
+
+/**
+ * @brief Поэлементно записывает значение выражения в матрицу одним проходом
+ *
+ * @details Op задаёт способ записи: присваивание, добавление или вычитание.
+ * Матрица может быть и операндом выражения: каждый элемент результата
+ * зависит только от элемента операнда с теми же индексами, поэтому строки
+ * можно считать в разных потоках. Если же представление-операнд
+ * пересекается с матрицей, выражение сначала вычисляется во временную
+ * матрицу.
+ */
+template <class T>
+template <class E, class Op>
+void S21BasicMatrix<T>::AssignExpr(const S21MatrixExpr<E> &expr) {
+  static_assert(std::is_same<typename S21ExprScalar<E>::type, T>::value,
+                "Expression must have the matrix element type.");
+  const E &e = expr.Derived();
+  if (S21ExprOverlaps(e, *this)) {
+    const S21BasicMatrix evaluated(e);
+    AssignExpr<S21BasicMatrix, Op>(evaluated);
+    return;
+  }
+  s21::detail::ParallelFor(0, Rows(), Length(), [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      T *row = data_ + static_cast<std::size_t>(i) * stride_;
+      for (int j = 0; j < Cols(); ++j) {
+        row[j] = Op::Apply(row[j], e.Coeff(i, j));
+      }
+    }
+  });
+}
 
-  double DetRecursive() const;
-  S21Matrix Submatrix(int row, int col) const;
-  S21Matrix MinorMatrix() const;
+struct S21AssignOp {
+  template <class T>
+  static inline T Apply(T, T value) {
+    return value;
+  }
 };
 
+/**
+ * @brief Создаёт матрицу из значения выражения, выделяя память один раз
+ */
+template <class T>
+template <class E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E> &expr)
+    : S21BasicMatrix(expr.Rows(), expr.Cols()) {
+  AssignExpr<E, S21AssignOp>(expr);
+}
+
+/**
+ * @brief Присваивает матрице значение выражения
+ *
+ * @details Память перевыделяется только при изменении размерности или
+ * пересечении представления-операнда с матрицей; в обоих случаях выражение
+ * вычисляется до освобождения старого буфера.
+ */
+template <class T>
+template <class E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21MatrixExpr<E> &expr) {
+  if (Rows() != expr.Rows() || Cols() != expr.Cols() ||
+      S21ExprOverlaps(expr.Derived(), *this)) {
+    *this = S21BasicMatrix(expr);
+  } else {
+    AssignExpr<E, S21AssignOp>(expr);
+  }
+  return *this;
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpr<E> &expr) {
+  if (Rows() != expr.Rows() || Cols() != expr.Cols()) {
+    throw std::invalid_argument(S21AddOp::DimensionError());
+  }
+  AssignExpr<E, S21AddOp>(expr);
+  return *this;
+}
+
+template <class T>
+template <class E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpr<E> &expr) {
+  if (Rows() != expr.Rows() || Cols() != expr.Cols()) {
+    throw std::invalid_argument(S21SubOp::DimensionError());
+  }
+  AssignExpr<E, S21SubOp>(expr);
+  return *this;
+}
+
+/**
+ * @brief Арифметика с истекающим операндом: результат записывается в буфер
+ * операнда-rvalue, новая память не выделяется
+ *
+ * @throw std::invalid_argument если размерности операндов не совпадают
+ */
+template <class T, class R>
+inline S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs,
+                                   const S21MatrixExpr<R> &rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <class L, class T>
+inline S21BasicMatrix<T> operator+(const S21MatrixExpr<L> &lhs,
+                                   S21BasicMatrix<T> &&rhs) {
+  rhs += lhs;
+  return std::move(rhs);
+}
+
+template <class T>
+inline S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs,
+                                   S21BasicMatrix<T> &&rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <class T, class R>
+inline S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs,
+                                   const S21MatrixExpr<R> &rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <class T, class L>
+S21BasicMatrix<T> operator-(const S21MatrixExpr<L> &lhs,
+                            S21BasicMatrix<T> &&rhs) {
+  if (lhs.Rows() != rhs.Rows() || lhs.Cols() != rhs.Cols()) {
+    throw std::invalid_argument(S21SubOp::DimensionError());
+  }
+  rhs.template AssignExpr<L, S21ReverseSubOp>(lhs);
+  return std::move(rhs);
+}
+
+template <class T>
+inline S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs,
+                                   S21BasicMatrix<T> &&rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <class T>
+inline S21BasicMatrix<T> operator*(
+    S21BasicMatrix<T> &&matrix,
+    const typename S21BasicMatrix<T>::Scalar number) {
+  matrix *= number;
+  return std::move(matrix);
+}
+
+template <class T>
+inline S21BasicMatrix<T> operator*(
+    const typename S21BasicMatrix<T>::Scalar number,
+    S21BasicMatrix<T> &&matrix) {
+  matrix *= number;
+  return std::move(matrix);
+}
+
+/**
+ * @brief Произведения, в которых хотя бы один из операндов - выражение
+ *
+ * @details Выражения вычисляются в матрицы, матрицы-операнды не копируются.
+ */
+template <class E>
+struct S21IsMatrix : std::false_type {};
+template <class T>
+struct S21IsMatrix<S21BasicMatrix<T> > : std::true_type {};
+
+template <class T, class R>
+inline typename std::enable_if<!S21IsMatrix<R>::value,
+                               S21BasicMatrix<T> >::type
+operator*(const S21BasicMatrix<T> &lhs, const S21MatrixExpr<R> &rhs) {
+  return lhs * S21BasicMatrix<T>(rhs);
+}
+
+template <class L, class T>
+inline typename std::enable_if<!S21IsMatrix<L>::value,
+                               S21BasicMatrix<T> >::type
+operator*(const S21MatrixExpr<L> &lhs, const S21BasicMatrix<T> &rhs) {
+  return S21BasicMatrix<T>(lhs) * rhs;
+}
+
+template <class L, class R>
+inline typename std::enable_if<
+    !S21IsMatrix<L>::value && !S21IsMatrix<R>::value,
+    S21BasicMatrix<typename S21ExprScalar<L>::type> >::type
+operator*(const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  typedef S21BasicMatrix<typename S21ExprScalar<L>::type> Matrix;
+  return Matrix(lhs) * Matrix(rhs);
+}
+
+/**
+ * @brief Сравнивает значения выражений поэлементно с точностью kEpsilon
+ * типа элементов, не создавая промежуточных матриц
+ */
+template <class L, class R>
+bool S21ExprEqual(const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  typedef S21MatrixTraits<typename S21ExprScalar<L>::type> Traits;
+  if (lhs.Rows() != rhs.Rows() || lhs.Cols() != rhs.Cols()) {
+    return false;
+  }
+  for (int i = 0; i < lhs.Rows(); ++i) {
+    for (int j = 0; j < lhs.Cols(); ++j) {
+      if (std::abs(lhs.Coeff(i, j) - rhs.Coeff(i, j)) > Traits::kEpsilon) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class T, class R>
+inline typename std::enable_if<!S21IsMatrix<R>::value, bool>::type operator==(
+    const S21BasicMatrix<T> &lhs, const S21MatrixExpr<R> &rhs) {
+  return S21ExprEqual(lhs, rhs);
+}
+
+template <class L, class T>
+inline typename std::enable_if<!S21IsMatrix<L>::value, bool>::type operator==(
+    const S21MatrixExpr<L> &lhs, const S21BasicMatrix<T> &rhs) {
+  return S21ExprEqual(lhs, rhs);
+}
+
+template <class L, class R>
+inline typename std::enable_if<
+    !S21IsMatrix<L>::value && !S21IsMatrix<R>::value, bool>::type
+operator==(const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  return S21ExprEqual(lhs, rhs);
+}
+
+/**
+ * @brief LU-разложение квадратной матрицы с частичным выбором ведущего
+ * элемента: P * A = L * U
+ *
+ * @details L (с единичной диагональю) и U хранятся упакованными в одной
+ * матрице Factors(): L ниже главной диагонали, U на ней и выше. Строка i
+ * матрицы P * A совпадает со строкой Permutation()[i] исходной матрицы.
+ * Одно разложение можно переиспользовать для нескольких решений систем.
+ */
+template <class T>
+class S21BasicLU {
+ public:
+  explicit S21BasicLU(const S21BasicMatrix<T> &matrix);
+  explicit S21BasicLU(const S21BasicMatrixView<T> &matrix);
+
+  inline int Size() const { return lu_.Rows(); }
+  inline const S21BasicMatrix<T> &Factors() const { return lu_; }
+  inline const std::vector<int> &Permutation() const { return permutation_; }
+  inline int Sign() const { return sign_; }
+  inline bool IsSingular() const { return singular_; }
+
+  T Determinant() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &rhs) const;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::vector<int> permutation_;
+  int sign_;
+  bool singular_;
+};
+
+/**
+ * @brief Разложение Холецкого эрмитовой (вещественной симметричной)
+ * матрицы: A = L * L^H
+ *
+ * @details Factors() хранит L на главной диагонали и ниже, L^H - выше неё.
+ * Для положительно определённой матрицы определитель, решение систем и
+ * обратная матрица стоят примерно вдвое меньше операций, чем через
+ * S21BasicLU; иначе эти функции выбрасывают исключение. Update и Downdate
+ * пересчитывают разложение после изменения матрицы на X * X^H за
+ * O(n^2) операций на столбец X.
+ */
+template <class T>
+class S21BasicCholesky {
+ public:
+  explicit S21BasicCholesky(const S21BasicMatrix<T> &matrix);
+  explicit S21BasicCholesky(const S21BasicMatrixView<T> &matrix);
+
+  inline int Size() const { return factors_.Rows(); }
+  inline const S21BasicMatrix<T> &Factors() const { return factors_; }
+  inline bool IsPositiveDefinite() const { return positive_definite_; }
+
+  S21BasicMatrix<T> L() const;
+  T Determinant() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &rhs) const;
+  S21BasicMatrix<T> InverseMatrix() const;
+  void Update(const S21BasicMatrix<T> &x);
+  void Downdate(const S21BasicMatrix<T> &x);
+
+ private:
+  void CheckPositiveDefinite() const;
+  void CheckUpdate(const S21BasicMatrix<T> &x) const;
+
+  S21BasicMatrix<T> factors_;
+  bool positive_definite_;
+};
+
+/**
+ * @brief QR-разложение матрицы m x n отражениями Хаусхолдера: A = Q * R
+ *
+ * @details Как в LAPACK xGEQRF: R хранится в Factors() на главной
+ * диагонали и выше, векторы отражений - ниже неё, их коэффициенты - в
+ * Tau(). Q = H_0 * ... * H_k, H_i = I - tau_i * v_i * v_i^H.
+ */
+template <class T>
+class S21BasicQR {
+ public:
+  explicit S21BasicQR(const S21BasicMatrix<T> &matrix);
+  explicit S21BasicQR(const S21BasicMatrixView<T> &matrix);
+
+  inline int Rows() const { return qr_.Rows(); }
+  inline int Cols() const { return qr_.Cols(); }
+  inline const S21BasicMatrix<T> &Factors() const { return qr_; }
+  inline const std::vector<T> &Tau() const { return tau_; }
+  inline bool IsFullRank() const { return full_rank_; }
+
+  S21BasicMatrix<T> Q() const;
+  S21BasicMatrix<T> R() const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &rhs) const;
+
+ private:
+  S21BasicMatrix<T> qr_;
+  std::vector<T> tau_;
+  bool full_rank_;
+};
+
+/**
+ * @brief Элемент значения выражения; остальные элементы не вычисляются
+ *
+ * @throw std::out_of_range если индексы выходят за пределы матрицы
+ */
+template <class E>
+typename S21MatrixExprNode<E>::Scalar S21MatrixExprNode<E>::operator()(
+    int row, int col) const {
+  if (row < 0 || row >= this->Rows() || col < 0 || col >= this->Cols()) {
+    throw std::out_of_range(
+        "Matrix index out of range or matrix not allocated.");
+  }
+  return this->Coeff(row, col);
+}
+
+/**
+ * @brief Вычисляет выражение в новую матрицу
+ */
+template <class E>
+typename S21MatrixExprNode<E>::Matrix S21MatrixExprNode<E>::Eval() const {
+  return Matrix(*this);
+}
+
+template <class E>
+void S21MatrixExprNode<E>::Print() const {
+  Eval().Print();
+}
+
+template <class E>
+bool S21MatrixExprNode<E>::EqMatrix(const Matrix &other) const {
+  return S21ExprEqual(*this, other);
+}
+
+template <class E>
+typename S21MatrixExprNode<E>::Matrix S21MatrixExprNode<E>::Transpose()
+    const {
+  return Eval().Transpose();
+}
+
+template <class E>
+typename S21MatrixExprNode<E>::Matrix S21MatrixExprNode<E>::CalcComplements()
+    const {
+  return Eval().CalcComplements();
+}
+
+template <class E>
+typename S21MatrixExprNode<E>::Scalar S21MatrixExprNode<E>::Determinant()
+    const {
+  return Eval().Determinant();
+}
+
+template <class E>
+S21BasicLU<typename S21MatrixExprNode<E>::Scalar> S21MatrixExprNode<E>::LU()
+    const {
+  return Eval().LU();
+}
+
+template <class E>
+S21BasicCholesky<typename S21MatrixExprNode<E>::Scalar>
+S21MatrixExprNode<E>::Cholesky() const {
+  return Eval().Cholesky();
+}
+
+template <class E>
+S21BasicQR<typename S21MatrixExprNode<E>::Scalar> S21MatrixExprNode<E>::QR()
+    const {
+  return Eval().QR();
+}
+
+template <class E>
+typename S21MatrixExprNode<E>::Matrix S21MatrixExprNode<E>::Solve(
+    const Matrix &rhs) const {
+  return Eval().Solve(rhs);
+}
+
+template <class E>
+typename S21MatrixExprNode<E>::Matrix S21MatrixExprNode<E>::Solve(
+    const Matrix &rhs, S21MatrixStructure structure) const {
+  return Eval().Solve(rhs, structure);
+}
+
+template <class E>
+S21MatrixStructure S21MatrixExprNode<E>::DetectStructure() const {
+  return Eval().DetectStructure();
+}
+
+template <class E>
+typename S21MatrixExprNode<E>::Matrix S21MatrixExprNode<E>::LeastSquares(
+    const Matrix &rhs) const {
+  return Eval().LeastSquares(rhs);
+}
+
+template <class E>
+typename S21MatrixExprNode<E>::Matrix S21MatrixExprNode<E>::InverseMatrix()
+    const {
+  return Eval().InverseMatrix();
+}
+
+#define S21_DECLARE_INSTANTIATION(T)           \
+  extern template class S21BasicMatrix<T>;     \
+  extern template class S21BasicMatrixView<T>; \
+  extern template class S21BasicLU<T>;         \
+  extern template class S21BasicCholesky<T>;   \
+  extern template class S21BasicQR<T>;
+S21_ELEMENT_TYPES(S21_DECLARE_INSTANTIATION)
+#undef S21_DECLARE_INSTANTIATION
+
 #endif  // SRC_S21_MATRIX_OOP_H
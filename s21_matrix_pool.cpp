@@ -0,0 +1,260 @@
+#include "s21_matrix_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Общее состояние пула: списки свободных буферов по классам
+ *
+ * @details Состояние живёт, пока существует S21MatrixPool или хотя бы один
+ * выделенный из пула буфер: refs считает владельца и все буферы пула, в
+ * том числе лежащие в списках.
+ */
+struct PoolState {
+  std::mutex mutex;
+  std::unordered_map<std::size_t, std::vector<void *> > free_lists;
+  std::size_t capacity;
+  S21MatrixPoolStats stats;
+  bool closed;
+  std::atomic<std::size_t> refs;
+};
+
+namespace {
+
+// Заголовок перед данными занимает целую кэш-линию, чтобы данные
+// оставались выровненными
+const std::size_t kHeaderSize = 64;
+
+// raw - адрес, который вернул распределитель: после GrowBuffer он может
+// не совпадать с началом заголовка
+struct BufferHeader {
+  PoolState *pool;
+  std::size_t bytes;
+  void *raw;
+};
+
+thread_local S21MatrixPool *t_current_pool = nullptr;
+thread_local PoolState *t_current_state = nullptr;
+
+/**
+ * @brief Округляет размер вверх до класса: четыре класса на каждое
+ * удвоение, то есть потери не больше четверти буфера
+ */
+std::size_t ClassSize(std::size_t bytes) {
+  if (bytes <= kHeaderSize) {
+    return kHeaderSize;
+  }
+  int log2 = 0;
+  while ((bytes - 1) >> (log2 + 1)) {
+    ++log2;
+  }
+  const std::size_t step = std::size_t(1) << (log2 - 2);
+  return (bytes + step - 1) & ~(step - 1);
+}
+
+void *RawAllocate(std::size_t bytes) {
+  void *base = nullptr;
+  if (posix_memalign(&base, kHeaderSize, kHeaderSize + bytes) != 0) {
+    throw std::bad_alloc();
+  }
+  return base;
+}
+
+void ReleaseRef(PoolState *state) {
+  if (state->refs.fetch_sub(1) == 1) {
+    delete state;
+  }
+}
+
+/**
+ * @brief Освобождает закэшированные буферы; вызывается под mutex
+ *
+ * @return Число освобождённых буферов, ссылки которых нужно снять
+ */
+std::size_t DropCached(PoolState *state) {
+  std::size_t dropped = 0;
+  for (auto &entry : state->free_lists) {
+    for (void *base : entry.second) {
+      free(base);
+      ++dropped;
+    }
+    entry.second.clear();
+  }
+  state->stats.cached_bytes = 0;
+  return dropped;
+}
+
+}  // namespace
+
+void *AllocateBuffer(std::size_t count, std::size_t size) {
+  if (size != 0 && count > (SIZE_MAX - 2 * kHeaderSize) / size) {
+    throw std::bad_alloc();
+  }
+  std::size_t bytes = count * size;
+  PoolState *pool = t_current_state;
+  void *base = nullptr;
+  if (pool != nullptr) {
+    bytes = ClassSize(bytes);
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    std::vector<void *> &list = pool->free_lists[bytes];
+    if (!list.empty()) {
+      base = list.back();
+      list.pop_back();
+      pool->stats.cached_bytes -= bytes;
+      ++pool->stats.hits;
+    } else {
+      ++pool->stats.misses;
+    }
+  }
+  if (base == nullptr) {
+    base = RawAllocate(bytes);
+    if (pool != nullptr) {
+      pool->refs.fetch_add(1);
+    }
+  }
+  BufferHeader *header = static_cast<BufferHeader *>(base);
+  header->pool = pool;
+  header->bytes = bytes;
+  header->raw = base;
+  return static_cast<char *>(base) + kHeaderSize;
+}
+
+void *GrowBuffer(void *buffer, std::size_t count, std::size_t size) {
+  if (size != 0 && count > (SIZE_MAX - 2 * kHeaderSize) / size) {
+    throw std::bad_alloc();
+  }
+  const std::size_t bytes = count * size;
+  char *old_base = static_cast<char *>(buffer) - kHeaderSize;
+  BufferHeader *header = reinterpret_cast<BufferHeader *>(old_base);
+  if (header->bytes >= bytes) {
+    return buffer;
+  }
+  if (header->pool != nullptr) {
+    void *grown = AllocateBuffer(count, size);
+    std::memcpy(grown, buffer, header->bytes);
+    FreeBuffer(buffer);
+    return grown;
+  }
+
+  // Запас в kHeaderSize байт позволяет выровнять начало заголовка, если
+  // realloc вернёт адрес, не кратный kHeaderSize
+  const std::size_t offset = old_base - static_cast<char *>(header->raw);
+  const std::size_t used = kHeaderSize + header->bytes;
+  char *raw =
+      static_cast<char *>(realloc(header->raw, 2 * kHeaderSize + bytes));
+  if (raw == nullptr) {
+    throw std::bad_alloc();
+  }
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+  char *base = raw + ((kHeaderSize - address % kHeaderSize) % kHeaderSize);
+  if (base != raw + offset) {
+    std::memmove(base, raw + offset, used);
+  }
+  header = reinterpret_cast<BufferHeader *>(base);
+  header->bytes = bytes;
+  header->raw = raw;
+  return base + kHeaderSize;
+}
+
+void FreeBuffer(void *buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  void *base = static_cast<char *>(buffer) - kHeaderSize;
+  const BufferHeader *header = static_cast<const BufferHeader *>(base);
+  PoolState *pool = header->pool;
+  if (pool == nullptr) {
+    free(header->raw);
+    return;
+  }
+
+  const std::size_t bytes = header->bytes;
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    if (!pool->closed && pool->stats.cached_bytes + bytes <= pool->capacity) {
+      pool->free_lists[bytes].push_back(base);
+      pool->stats.cached_bytes += bytes;
+      ++pool->stats.recycled;
+      return;
+    }
+    ++pool->stats.released;
+  }
+  free(base);
+  ReleaseRef(pool);
+}
+
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @param capacity Наибольший суммарный объём буферов (в байтах), которые
+ * пул держит для повторной выдачи; лишние буферы освобождаются сразу
+ */
+S21MatrixPool::S21MatrixPool(std::size_t capacity)
+    : state_(new s21::detail::PoolState()) {
+  state_->capacity = capacity;
+  state_->stats = S21MatrixPoolStats();
+  state_->closed = false;
+  state_->refs.store(1);
+}
+
+/**
+ * @details Закэшированные буферы освобождаются; буферы живых матриц
+ * освободятся при уничтожении матриц.
+ */
+S21MatrixPool::~S21MatrixPool() {
+  std::size_t dropped = 0;
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->closed = true;
+    dropped = s21::detail::DropCached(state_);
+  }
+  state_->refs.fetch_sub(dropped);
+  s21::detail::ReleaseRef(state_);
+}
+
+std::size_t S21MatrixPool::Capacity() const { return state_->capacity; }
+
+S21MatrixPoolStats S21MatrixPool::Stats() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->stats;
+}
+
+/**
+ * @brief Освобождает все буферы, ожидающие повторной выдачи
+ */
+void S21MatrixPool::Clear() {
+  std::size_t dropped = 0;
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    dropped = s21::detail::DropCached(state_);
+  }
+  state_->refs.fetch_sub(dropped);
+}
+
+/**
+ * @brief Пул, действующий на текущем потоке, или nullptr
+ */
+S21MatrixPool *S21MatrixPool::Current() {
+  return s21::detail::t_current_pool;
+}
+
+S21MatrixPoolScope::S21MatrixPoolScope(S21MatrixPool &pool)
+    : previous_(s21::detail::t_current_pool) {
+  s21::detail::t_current_pool = &pool;
+  s21::detail::t_current_state = pool.state_;
+}
+
+S21MatrixPoolScope::~S21MatrixPoolScope() {
+  s21::detail::t_current_pool = previous_;
+  s21::detail::t_current_state = previous_ ? previous_->state_ : nullptr;
+}
@@ -0,0 +1,104 @@
+#ifndef SRC_S21_MATRIX_POOL_H
+#define SRC_S21_MATRIX_POOL_H
+
+#include <cstddef>
+
+namespace s21 {
+namespace detail {
+struct PoolState;
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief Статистика пула буферов матриц
+ */
+struct S21MatrixPoolStats {
+  std::size_t hits;          ///< выделения, обслуженные из пула
+  std::size_t misses;        ///< выделения, ушедшие в malloc
+  std::size_t recycled;      ///< освобождённые буферы, оставленные в пуле
+  std::size_t released;      ///< освобождённые буферы, возвращённые в malloc
+  std::size_t cached_bytes;  ///< объём буферов, ожидающих повторной выдачи
+};
+
+/**
+ * @brief Пул буферов матриц по классам размеров
+ *
+ * @details Пока на потоке действует S21MatrixPoolScope, память для новых
+ * матриц берётся из пула, а освобождённые буферы возвращаются в него
+ * вместо free. Размер буфера округляется вверх до класса (четыре класса
+ * на каждое удвоение размера), поэтому матрицы близких размеров тоже
+ * переиспользуют буферы друг друга. Буфер помнит свой пул: матрицу можно
+ * освободить после выхода из области или в другом потоке, а пережившие
+ * пул буферы освобождаются обычным образом.
+ */
+class S21MatrixPool {
+ public:
+  static const std::size_t kDefaultCapacity = std::size_t(256) << 20;
+
+  explicit S21MatrixPool(std::size_t capacity = kDefaultCapacity);
+  ~S21MatrixPool();
+  S21MatrixPool(const S21MatrixPool &) = delete;
+  S21MatrixPool &operator=(const S21MatrixPool &) = delete;
+
+  std::size_t Capacity() const;
+  S21MatrixPoolStats Stats() const;
+  void Clear();
+
+  static S21MatrixPool *Current();
+
+ private:
+  friend class S21MatrixPoolScope;
+  s21::detail::PoolState *state_;
+};
+
+/**
+ * @brief Делает пул текущим для матриц, создаваемых в этом потоке, до
+ * конца области видимости; вложенные области восстанавливают предыдущий
+ * пул
+ */
+class S21MatrixPoolScope {
+ public:
+  explicit S21MatrixPoolScope(S21MatrixPool &pool);
+  ~S21MatrixPoolScope();
+  S21MatrixPoolScope(const S21MatrixPoolScope &) = delete;
+  S21MatrixPoolScope &operator=(const S21MatrixPoolScope &) = delete;
+
+ private:
+  S21MatrixPool *previous_;
+};
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Выделяет буфер из count элементов по size байт, выровненный по
+ * 64 байтам, из текущего пула потока или, если пула нет, через
+ * posix_memalign
+ *
+ * @throw std::bad_alloc если не удалось выделить память
+ */
+void *AllocateBuffer(std::size_t count, std::size_t size);
+
+/**
+ * @brief Увеличивает буфер до count элементов по size байт, сохраняя
+ * содержимое
+ *
+ * @details Буфер вне пула расширяется через realloc: большие блоки
+ * растут переназначением страниц, без второй копии данных. Буфер из пула
+ * заменяется новым буфером текущего пула с копированием. Если буфер уже
+ * достаточно велик, он возвращается как есть.
+ * @return Новый адрес данных; старый адрес больше недействителен
+ * @throw std::bad_alloc если не удалось выделить память; исходный буфер
+ * при этом не меняется
+ */
+void *GrowBuffer(void *buffer, std::size_t count, std::size_t size);
+
+/**
+ * @brief Возвращает буфер в пул, из которого он выделен, или освобождает
+ */
+void FreeBuffer(void *buffer);
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_POOL_H
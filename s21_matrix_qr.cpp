@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace detail {
+namespace {
+// Ширина панели: отражения панели применяются к остатку матрицы блоком
+// I - V * T * V^H, то есть двумя вызовами GEMM
+const int kQrBlock = 32;
+
+/**
+ * @brief C = (I - tau * v * v^H) * C для rows x cols блока C
+ *
+ * @param v Вектор отражения с шагом vs; v[0] считается равным 1 и не
+ * читается
+ * @param w Рабочий массив из cols элементов
+ * @details Сначала w = v^H * C, затем C -= tau * v * w. Столбцы C
+ * независимы и делятся между потоками.
+ */
+template <class T>
+void ApplyReflector(const T *v, std::ptrdiff_t vs, int rows, T tau, T *c,
+                    int cols, std::ptrdiff_t cs, T *w) {
+  if (tau == T() || cols == 0) {
+    return;
+  }
+  const long long work = 4LL * rows * cols;
+  ParallelFor(0, cols, work, [&](int first, int last) {
+    std::copy(c + first, c + last, w + first);
+    for (int i = 1; i < rows; ++i) {
+      const T vi = S21MatrixTraits<T>::Conj(v[i * vs]);
+      const T *row = c + i * cs;
+      for (int j = first; j < last; ++j) {
+        w[j] += vi * row[j];
+      }
+    }
+    for (int j = first; j < last; ++j) {
+      w[j] *= tau;
+      c[j] -= w[j];
+    }
+    for (int i = 1; i < rows; ++i) {
+      const T vi = v[i * vs];
+      T *row = c + i * cs;
+      for (int j = first; j < last; ++j) {
+        row[j] -= vi * w[j];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Строит отражение, обнуляющее столбец k ниже диагонали
+ *
+ * @details Как в LAPACK xLARFG: H^H * (alpha, x) = (beta, 0) для
+ * H = I - tau * v * v^H, beta вещественно и противоположно по знаку
+ * Re(alpha). Вектор v (без единичного первого элемента) записывается на
+ * место x, beta - на место alpha.
+ */
+template <class T>
+T MakeReflector(T *a, int m, std::ptrdiff_t s, int k) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  T *alpha = a + k * s + k;
+  Real x_norm2 = Real();
+  for (int i = k + 1; i < m; ++i) {
+    x_norm2 += std::norm(a[i * s + k]);
+  }
+  if (x_norm2 == Real() && *alpha == S21MatrixTraits<T>::Conj(*alpha)) {
+    return T();
+  }
+  const Real beta =
+      -std::copysign(std::sqrt(std::norm(*alpha) + x_norm2), std::real(*alpha));
+  const T tau = (T(beta) - *alpha) / T(beta);
+  const T scale = T(1) / (*alpha - T(beta));
+  for (int i = k + 1; i < m; ++i) {
+    a[i * s + k] *= scale;
+  }
+  *alpha = T(beta);
+  return tau;
+}
+
+/**
+ * @brief Применяет H_k^H ... H_0^H панели k0..k0+kb-1 к остальным
+ * столбцам
+ *
+ * @details Панель V (единицы на диагонали, нули выше) копируется явно,
+ * T - верхнетреугольная матрица блочного отражения
+ * H_0 * ... * H_kb-1 = I - V * T * V^H (LAPACK xLARFT). Тогда
+ * C -= V * (T^H * (V^H * C)): оба больших произведения считает GEMM, а
+ * умножение на T^H - маленькое (kb x kb на kb x cols).
+ */
+template <class T>
+void ApplyBlockReflector(T *a, int m, int n, std::ptrdiff_t s, int k0,
+                         int kb, const T *tau) {
+  const int rows = m - k0;
+  const int cols = n - k0 - kb;
+  std::vector<T> v(static_cast<std::size_t>(rows) * kb, T());
+  std::vector<T> v_conj(v.size(), T());
+  for (int i = 0; i < rows; ++i) {
+    for (int p = 0; p < std::min(i + 1, kb); ++p) {
+      const T value = i == p ? T(1) : a[(k0 + i) * s + k0 + p];
+      v[i * kb + p] = value;
+      v_conj[i * kb + p] = S21MatrixTraits<T>::Conj(value);
+    }
+  }
+
+  // T(0:p, p) = -tau_p * T(0:p, 0:p) * V(:, 0:p)^H * v_p
+  std::vector<T> t(static_cast<std::size_t>(kb) * kb, T());
+  std::vector<T> column(kb);
+  for (int p = 0; p < kb; ++p) {
+    for (int q = 0; q < p; ++q) {
+      T sum = T();
+      for (int i = p; i < rows; ++i) {
+        sum += v_conj[i * kb + q] * v[i * kb + p];
+      }
+      column[q] = -tau[k0 + p] * sum;
+    }
+    for (int q = 0; q < p; ++q) {
+      T sum = T();
+      for (int r = q; r < p; ++r) {
+        sum += t[q * kb + r] * column[r];
+      }
+      t[q * kb + p] = sum;
+    }
+    t[p * kb + p] = tau[k0 + p];
+  }
+
+  // W = V^H * C
+  T *c = a + k0 * s + k0 + kb;
+  std::vector<T> w(static_cast<std::size_t>(kb) * cols);
+  Gemm(kb, cols, rows, T(1), v_conj.data(), 1, kb, c, s, 1, T(), w.data(),
+       cols);
+  // W = T^H * W снизу вверх: строка p зависит от строк q <= p
+  for (int p = kb - 1; p >= 0; --p) {
+    T *w_row = w.data() + p * cols;
+    const T t_pp = S21MatrixTraits<T>::Conj(t[p * kb + p]);
+    for (int j = 0; j < cols; ++j) {
+      w_row[j] *= t_pp;
+    }
+    for (int q = 0; q < p; ++q) {
+      const T t_qp = S21MatrixTraits<T>::Conj(t[q * kb + p]);
+      const T *w_q = w.data() + q * cols;
+      for (int j = 0; j < cols; ++j) {
+        w_row[j] += t_qp * w_q[j];
+      }
+    }
+  }
+  // C -= V * W
+  Gemm(rows, cols, kb, T(-1), v.data(), kb, 1, w.data(), cols, 1, T(1), c, s);
+}
+
+/**
+ * @brief QR-разложение на месте: A = Q * R, Q = H_0 * ... * H_r-1
+ *
+ * @details R записывается на главной диагонали и выше, векторы отражений -
+ * ниже неё. Панели из kQrBlock столбцов раскладываются по одному
+ * отражению, остаток обновляется ApplyBlockReflector.
+ */
+template <class T>
+void QrFactor(T *a, int m, int n, std::ptrdiff_t s, T *tau) {
+  const int r = std::min(m, n);
+  std::vector<T> w(n);
+  for (int k0 = 0; k0 < r; k0 += kQrBlock) {
+    const int kb = std::min(kQrBlock, r - k0);
+    for (int k = k0; k < k0 + kb; ++k) {
+      tau[k] = MakeReflector(a, m, s, k);
+      ApplyReflector(a + k * s + k, s, m - k,
+                     S21MatrixTraits<T>::Conj(tau[k]), a + k * s + k + 1,
+                     k0 + kb - k - 1, s, w.data());
+    }
+    if (k0 + kb < n) {
+      ApplyBlockReflector(a, m, n, s, k0, kb, tau);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief QR-разложение
+ */
+template <class T>
+S21BasicQR<T> S21BasicMatrix<T>::QR() const {
+  return S21BasicQR<T>(*this);
+}
+
+/**
+ * @brief Решение переопределённой системы методом наименьших квадратов
+ *
+ * @param rhs Матрица правых частей с Rows() строками
+ * @return Матрица Cols() x rhs.Cols(), минимизирующая
+ * ||*this * X - rhs|| для каждого столбца
+ * @throw std::invalid_argument если строк меньше, чем столбцов, число
+ * строк rhs не совпадает с числом строк матрицы или столбцы матрицы
+ * линейно зависимы
+ * @details Считается через QR-разложение: X = R^-1 * Q^H * rhs. В отличие
+ * от нормальных уравнений A^H * A * X = A^H * rhs, число обусловленности
+ * не возводится в квадрат.
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::LeastSquares(
+    const S21BasicMatrix &rhs) const {
+  if (Rows() < Cols()) {
+    throw std::invalid_argument(
+        "Least squares requires at least as many rows as columns.");
+  }
+  return QR().Solve(rhs);
+}
+
+/**
+ * @brief Раскладывает матрицу m x n отражениями Хаусхолдера: A = Q * R
+ *
+ * @details Матрица с линейно зависимыми столбцами (строками при m < n)
+ * раскладывается без ошибки, IsFullRank() при этом возвращает false: для
+ * этого модуль какого-либо из диагональных элементов R не превосходит
+ * max(m, n) * eps * max|a_ij|.
+ */
+template <class T>
+S21BasicQR<T>::S21BasicQR(const S21BasicMatrix<T> &matrix)
+    : S21BasicQR(matrix.View()) {}
+
+/**
+ * @brief Раскладывает матрицу, заданную представлением
+ *
+ * @details Элементы копируются один раз - в хранилище множителей.
+ */
+template <class T>
+S21BasicQR<T>::S21BasicQR(const S21BasicMatrixView<T> &matrix)
+    : qr_(matrix),
+      tau_(std::min(matrix.Rows(), matrix.Cols())),
+      full_rank_(true) {
+  typedef typename S21MatrixTraits<T>::Real Real;
+  const int m = Rows(), n = Cols();
+  if (qr_.Data() == nullptr) {
+    return;
+  }
+  Real max_abs = Real();
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      max_abs = std::max(max_abs, Real(std::abs(qr_.At(i, j))));
+    }
+  }
+  const Real tolerance =
+      std::max(m, n) * std::numeric_limits<Real>::epsilon() * max_abs;
+  s21::detail::QrFactor(qr_.Data(), m, n, qr_.Stride(), tau_.data());
+  for (int k = 0; k < std::min(m, n) && full_rank_; ++k) {
+    full_rank_ = std::abs(qr_.At(k, k)) > tolerance;
+  }
+}
+
+/**
+ * @brief Первые min(m, n) столбцов ортогональной (унитарной) матрицы Q
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicQR<T>::Q() const {
+  const int m = Rows(), r = static_cast<int>(tau_.size());
+  S21BasicMatrix<T> q(m, r);
+  for (int i = 0; i < r; ++i) {
+    q.At(i, i) = T(1);
+  }
+  std::vector<T> w(r);
+  for (int k = r - 1; k >= 0; --k) {
+    s21::detail::ApplyReflector(
+        qr_.Data() + static_cast<std::size_t>(k) * qr_.Stride() + k,
+        qr_.Stride(), m - k, tau_[k],
+        q.Data() + static_cast<std::size_t>(k) * q.Stride() + k, r - k,
+        q.Stride(), w.data());
+  }
+  return q;
+}
+
+/**
+ * @brief Верхнетрапециевидная матрица R размерности min(m, n) x n
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicQR<T>::R() const {
+  const int r = static_cast<int>(tau_.size());
+  S21BasicMatrix<T> result(r, Cols());
+  for (int i = 0; i < r; ++i) {
+    const T *src = qr_.Data() + static_cast<std::size_t>(i) * qr_.Stride();
+    T *dst = result.Data() + static_cast<std::size_t>(i) * result.Stride();
+    std::copy(src + i, src + Cols(), dst + i);
+  }
+  return result;
+}
+
+/**
+ * @brief Решает задачу наименьших квадратов min ||A * X - rhs||
+ *
+ * @param rhs Матрица правых частей с Rows() строками
+ * @return Матрица решений Cols() x rhs.Cols()
+ * @throw std::invalid_argument если строк меньше, чем столбцов, число
+ * строк rhs не совпадает с Rows() или столбцы A линейно зависимы
+ * @details К rhs применяется Q^H (по одному отражению за раз, без
+ * построения Q), затем верхние Cols() строк решаются с R обратной
+ * подстановкой.
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicQR<T>::Solve(const S21BasicMatrix<T> &rhs) const {
+  const int m = Rows(), n = Cols();
+  if (m < n) {
+    throw std::invalid_argument(
+        "Least squares requires at least as many rows as columns.");
+  }
+  if (rhs.Rows() != m) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  if (!full_rank_) {
+    throw std::invalid_argument("Matrix is rank deficient.");
+  }
+
+  S21BasicMatrix<T> y(rhs);
+  S21BasicMatrix<T> x(n, rhs.Cols());
+  if (x.Data() == nullptr) {
+    return x;
+  }
+  std::vector<T> w(y.Cols());
+  for (int k = 0; k < n; ++k) {
+    s21::detail::ApplyReflector(
+        qr_.Data() + static_cast<std::size_t>(k) * qr_.Stride() + k,
+        qr_.Stride(), m - k, S21MatrixTraits<T>::Conj(tau_[k]),
+        y.Data() + static_cast<std::size_t>(k) * y.Stride(), y.Cols(),
+        y.Stride(), w.data());
+  }
+  for (int i = 0; i < n; ++i) {
+    const T *src = y.Data() + static_cast<std::size_t>(i) * y.Stride();
+    std::copy(src, src + y.Cols(),
+              x.Data() + static_cast<std::size_t>(i) * x.Stride());
+  }
+  s21::detail::SolveUpper(qr_.Data(), n, qr_.Stride(), x.Data(), x.Cols(),
+                          x.Stride());
+  return x;
+}
+
+#define S21_INSTANTIATE(T)                                                  \
+  template class S21BasicQR<T>;                                             \
+  template S21BasicQR<T> S21BasicMatrix<T>::QR() const;                     \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::LeastSquares(               \
+      const S21BasicMatrix<T> &) const;
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
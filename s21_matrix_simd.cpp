@@ -0,0 +1,486 @@
+#include "s21_matrix_simd.h"
+
+#include <atomic>
+#include <cmath>
+#include <complex>
+
+#include "s21_matrix_oop.h"
+
+#ifdef S21_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+namespace detail {
+namespace {
+
+template <class T>
+void AddScalar(T *dst, const T *src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = dst[i] + src[i];
+  }
+}
+
+template <class T>
+void SubScalar(T *dst, const T *src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = dst[i] - src[i];
+  }
+}
+
+template <class T>
+void ScaleScalar(T *dst, T number, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = dst[i] * number;
+  }
+}
+
+template <class T>
+bool EqualScalar(const T *lhs, const T *rhs, std::size_t n,
+                 typename S21MatrixTraits<T>::Real epsilon) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (std::abs(lhs[i] - rhs[i]) > epsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#ifdef S21_SIMD_X86
+// --- SSE2: 2 элемента за инструкцию ---
+S21_TARGET("sse2")
+void AddSse2(double *dst, const double *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("sse2")
+void SubSse2(double *dst, const double *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_sub_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("sse2")
+void ScaleSse2(double *dst, double number, std::size_t n) {
+  const __m128d factor = _mm_set1_pd(number);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, number, n - i);
+}
+
+S21_TARGET("sse2")
+bool EqualSse2(const double *lhs, const double *rhs, std::size_t n,
+               double epsilon) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d eps = _mm_set1_pd(epsilon);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d diff =
+        _mm_sub_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i));
+    if (_mm_movemask_pd(_mm_cmpgt_pd(_mm_andnot_pd(sign, diff), eps)) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(lhs + i, rhs + i, n - i, epsilon);
+}
+
+// --- AVX2: 4 элемента за инструкцию ---
+S21_TARGET("avx2")
+void AddAvx2(double *dst, const double *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("avx2")
+void SubAvx2(double *dst, const double *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("avx2")
+void ScaleAvx2(double *dst, double number, std::size_t n) {
+  const __m256d factor = _mm256_set1_pd(number);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, number, n - i);
+}
+
+S21_TARGET("avx2")
+bool EqualAvx2(const double *lhs, const double *rhs, std::size_t n,
+               double epsilon) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d eps = _mm256_set1_pd(epsilon);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d diff =
+        _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i));
+    const __m256d greater =
+        _mm256_cmp_pd(_mm256_andnot_pd(sign, diff), eps, _CMP_GT_OQ);
+    if (_mm256_movemask_pd(greater) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(lhs + i, rhs + i, n - i, epsilon);
+}
+
+// --- AVX-512: 8 элементов за инструкцию, хвост обрабатывается маской ---
+S21_TARGET("avx512f")
+void AddAvx512(double *dst, const double *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_add_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                                      _mm512_maskz_loadu_pd(tail, src + i)));
+}
+
+S21_TARGET("avx512f")
+void SubAvx512(double *dst, const double *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_sub_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                                      _mm512_maskz_loadu_pd(tail, src + i)));
+}
+
+S21_TARGET("avx512f")
+void ScaleAvx512(double *dst, double number, std::size_t n) {
+  const __m512d factor = _mm512_set1_pd(number);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), factor));
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(
+      dst + i, tail,
+      _mm512_mul_pd(_mm512_maskz_loadu_pd(tail, dst + i), factor));
+}
+
+S21_TARGET("avx512f")
+bool EqualAvx512(const double *lhs, const double *rhs, std::size_t n,
+                 double epsilon) {
+  const __m512d eps = _mm512_set1_pd(epsilon);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d diff =
+        _mm512_sub_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i));
+    if (_mm512_cmp_pd_mask(_mm512_abs_pd(diff), eps, _CMP_GT_OQ) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(lhs + i, rhs + i, n - i, epsilon);
+}
+
+// --- float: вдвое больше элементов на регистр ---
+S21_TARGET("sse2")
+void AddSse2(float *dst, const float *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("sse2")
+void SubSse2(float *dst, const float *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_sub_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("sse2")
+void ScaleSse2(float *dst, float number, std::size_t n) {
+  const __m128 factor = _mm_set1_ps(number);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, number, n - i);
+}
+
+S21_TARGET("sse2")
+bool EqualSse2(const float *lhs, const float *rhs, std::size_t n,
+               float epsilon) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 eps = _mm_set1_ps(epsilon);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 diff =
+        _mm_sub_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i));
+    if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_andnot_ps(sign, diff), eps)) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(lhs + i, rhs + i, n - i, epsilon);
+}
+
+S21_TARGET("avx2")
+void AddAvx2(float *dst, const float *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i),
+                                            _mm256_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("avx2")
+void SubAvx2(float *dst, const float *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_sub_ps(_mm256_loadu_ps(dst + i),
+                                            _mm256_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+S21_TARGET("avx2")
+void ScaleAvx2(float *dst, float number, std::size_t n) {
+  const __m256 factor = _mm256_set1_ps(number);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, number, n - i);
+}
+
+S21_TARGET("avx2")
+bool EqualAvx2(const float *lhs, const float *rhs, std::size_t n,
+               float epsilon) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 eps = _mm256_set1_ps(epsilon);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 diff =
+        _mm256_sub_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i));
+    const __m256 greater =
+        _mm256_cmp_ps(_mm256_andnot_ps(sign, diff), eps, _CMP_GT_OQ);
+    if (_mm256_movemask_ps(greater) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(lhs + i, rhs + i, n - i, epsilon);
+}
+
+S21_TARGET("avx512f")
+void AddAvx512(float *dst, const float *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  }
+  const __mmask16 tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_ps(dst + i, tail,
+                        _mm512_add_ps(_mm512_maskz_loadu_ps(tail, dst + i),
+                                      _mm512_maskz_loadu_ps(tail, src + i)));
+}
+
+S21_TARGET("avx512f")
+void SubAvx512(float *dst, const float *src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_sub_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  }
+  const __mmask16 tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_ps(dst + i, tail,
+                        _mm512_sub_ps(_mm512_maskz_loadu_ps(tail, dst + i),
+                                      _mm512_maskz_loadu_ps(tail, src + i)));
+}
+
+S21_TARGET("avx512f")
+void ScaleAvx512(float *dst, float number, std::size_t n) {
+  const __m512 factor = _mm512_set1_ps(number);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(dst + i), factor));
+  }
+  const __mmask16 tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_ps(
+      dst + i, tail,
+      _mm512_mul_ps(_mm512_maskz_loadu_ps(tail, dst + i), factor));
+}
+
+S21_TARGET("avx512f")
+bool EqualAvx512(const float *lhs, const float *rhs, std::size_t n,
+                 float epsilon) {
+  const __m512 eps = _mm512_set1_ps(epsilon);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 diff =
+        _mm512_sub_ps(_mm512_loadu_ps(lhs + i), _mm512_loadu_ps(rhs + i));
+    if (_mm512_cmp_ps_mask(_mm512_abs_ps(diff), eps, _CMP_GT_OQ) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(lhs + i, rhs + i, n - i, epsilon);
+}
+#endif  // S21_SIMD_X86
+
+// --- std::complex<double>: массив комплексных чисел - это массив пар
+// double (вещественная и мнимая части), поэтому сложение, вычитание и
+// умножение на вещественное число выполняются ядрами double ---
+typedef std::complex<double> Complex;
+
+void AddComplex(Complex *dst, const Complex *src, std::size_t n) {
+  Kernels<double>().add(reinterpret_cast<double *>(dst),
+                        reinterpret_cast<const double *>(src), 2 * n);
+}
+
+void SubComplex(Complex *dst, const Complex *src, std::size_t n) {
+  Kernels<double>().sub(reinterpret_cast<double *>(dst),
+                        reinterpret_cast<const double *>(src), 2 * n);
+}
+
+void ScaleComplex(Complex *dst, Complex number, std::size_t n) {
+  if (number.imag() == 0.0) {
+    Kernels<double>().scale(reinterpret_cast<double *>(dst), number.real(),
+                            2 * n);
+  } else {
+    ScaleScalar(dst, number, n);
+  }
+}
+
+template <class T>
+const ElementwiseKernels<T> kScalarKernels = {AddScalar<T>, SubScalar<T>,
+                                              ScaleScalar<T>, EqualScalar<T>};
+#ifdef S21_SIMD_X86
+template <class T>
+const ElementwiseKernels<T> kSse2Kernels = {AddSse2, SubSse2, ScaleSse2,
+                                            EqualSse2};
+template <class T>
+const ElementwiseKernels<T> kAvx2Kernels = {AddAvx2, SubAvx2, ScaleAvx2,
+                                            EqualAvx2};
+template <class T>
+const ElementwiseKernels<T> kAvx512Kernels = {AddAvx512, SubAvx512,
+                                              ScaleAvx512, EqualAvx512};
+#endif
+const ElementwiseKernels<Complex> kComplexKernels = {
+    AddComplex, SubComplex, ScaleComplex, EqualScalar<Complex>};
+
+/**
+ * @brief Лучший набор инструкций, поддерживаемый процессором и ОС
+ */
+S21SimdLevel DetectLevel() {
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return S21SimdLevel::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return S21SimdLevel::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return S21SimdLevel::kSse2;
+  }
+#endif
+  return S21SimdLevel::kScalar;
+}
+
+std::atomic<int> &ActiveLevel() {
+  static std::atomic<int> level(static_cast<int>(S21DetectSimdLevel()));
+  return level;
+}
+
+/**
+ * @brief Таблица ядер для типа с векторными ядрами на каждом уровне
+ */
+template <class T>
+const ElementwiseKernels<T> &VectorKernels() {
+  switch (static_cast<S21SimdLevel>(ActiveLevel().load())) {
+#ifdef S21_SIMD_X86
+    case S21SimdLevel::kAvx512:
+      return kAvx512Kernels<T>;
+    case S21SimdLevel::kAvx2:
+      return kAvx2Kernels<T>;
+    case S21SimdLevel::kSse2:
+      return kSse2Kernels<T>;
+#endif
+    default:
+      return kScalarKernels<T>;
+  }
+}
+
+}  // namespace
+
+template <>
+const ElementwiseKernels<float> &Kernels<float>() {
+  return VectorKernels<float>();
+}
+
+template <>
+const ElementwiseKernels<double> &Kernels<double>() {
+  return VectorKernels<double>();
+}
+
+template <>
+const ElementwiseKernels<long double> &Kernels<long double>() {
+  return kScalarKernels<long double>;
+}
+
+template <>
+const ElementwiseKernels<Complex> &Kernels<Complex>() {
+  return kComplexKernels;
+}
+
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief Лучший набор векторных инструкций, доступный на этом процессоре
+ */
+S21SimdLevel S21DetectSimdLevel() {
+  static const S21SimdLevel level = s21::detail::DetectLevel();
+  return level;
+}
+
+/**
+ * @brief Набор инструкций, которым сейчас пользуются вычислительные ядра
+ */
+S21SimdLevel S21GetSimdLevel() {
+  return static_cast<S21SimdLevel>(s21::detail::ActiveLevel().load());
+}
+
+/**
+ * @brief Выбирает набор инструкций для вычислительных ядер
+ *
+ * @details Уровень выше поддерживаемого процессором понижается до
+ * S21DetectSimdLevel(). Используется для тестов и сравнения производительности.
+ */
+void S21SetSimdLevel(S21SimdLevel level) {
+  if (static_cast<int>(level) > static_cast<int>(S21DetectSimdLevel())) {
+    level = S21DetectSimdLevel();
+  }
+  s21::detail::ActiveLevel().store(static_cast<int>(level));
+}
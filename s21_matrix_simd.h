@@ -0,0 +1,57 @@
+#ifndef SRC_S21_MATRIX_SIMD_H
+#define SRC_S21_MATRIX_SIMD_H
+
+#include <cstddef>
+
+#include "s21_matrix_traits.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define S21_SIMD_X86 1
+#define S21_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Таблица поэлементных ядер для одного набора инструкций и типа
+ * элементов T
+ *
+ * @details Ядра работают с непрерывным отрезком из n элементов (одной
+ * строкой матрицы) и не требуют выравнивания указателей.
+ */
+template <class T>
+struct ElementwiseKernels {
+  typedef typename S21MatrixTraits<T>::Real Real;
+
+  void (*add)(T *dst, const T *src, std::size_t n);
+  void (*sub)(T *dst, const T *src, std::size_t n);
+  void (*scale)(T *dst, T number, std::size_t n);
+  bool (*equal)(const T *lhs, const T *rhs, std::size_t n, Real epsilon);
+};
+
+/**
+ * @brief Ядра типа T для набора инструкций, выбранного S21SetSimdLevel
+ * или определённого по CPUID при первом обращении
+ *
+ * @details Для float и double есть векторные ядра на каждом уровне, для
+ * std::complex<double> сложение и вычитание выполняются ядрами double
+ * над вещественными и мнимыми частями, long double считается скалярно.
+ */
+template <class T>
+const ElementwiseKernels<T> &Kernels();
+
+template <>
+const ElementwiseKernels<float> &Kernels<float>();
+template <>
+const ElementwiseKernels<double> &Kernels<double>();
+template <>
+const ElementwiseKernels<long double> &Kernels<long double>();
+template <>
+const ElementwiseKernels<std::complex<double> >
+    &Kernels<std::complex<double> >();
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_SIMD_H
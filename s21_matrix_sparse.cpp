@@ -0,0 +1,596 @@
+#include "s21_matrix_sparse.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Строка произведения, занимающая больше 1/kDenseRowRatio столбцов,
+// упорядочивается проходом по всем столбцам, а не сортировкой: проход
+// стоит cols сравнений, сортировка - порядка count * log2(count)
+const int kDenseRowRatio = 8;
+
+/**
+ * @brief Устойчиво раскладывает count элементов по корзинам key[p]
+ *
+ * @details Сортировка подсчётом: элементы одной корзины сохраняют исходный
+ * порядок, поэтому если вход упорядочен по other, то и внутри каждой
+ * корзины other идёт по возрастанию.
+ * @param offsets Начала корзин, buckets + 1 элементов
+ * @param indices other[p] в порядке корзин
+ * @param sorted values[p] в порядке корзин
+ */
+template <class T>
+void BucketSort(int buckets, int count, const int *key, const int *other,
+                const T *values, std::vector<int> &offsets,
+                std::vector<int> &indices, std::vector<T> &sorted) {
+  offsets.assign(buckets + 1, 0);
+  for (int p = 0; p < count; ++p) {
+    ++offsets[key[p] + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  indices.resize(count);
+  sorted.resize(count);
+  std::vector<int> next(offsets.begin(), offsets.end() - 1);
+  for (int p = 0; p < count; ++p) {
+    const int position = next[key[p]]++;
+    indices[position] = other[p];
+    sorted[position] = values[p];
+  }
+}
+
+/**
+ * @brief Внешний индекс каждого ненулевого элемента по массиву offsets
+ */
+std::vector<int> ExpandOffsets(const std::vector<int> &offsets) {
+  std::vector<int> outer(offsets.back());
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    std::fill(outer.begin() + offsets[i], outer.begin() + offsets[i + 1],
+              static_cast<int>(i));
+  }
+  return outer;
+}
+
+void CheckDimensions(int rows, int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Matrix dimensions must be positive.");
+  }
+}
+
+template <class Real>
+void CheckTolerance(Real tolerance) {
+  if (!(tolerance >= Real())) {
+    throw std::invalid_argument("Drop tolerance must be non-negative.");
+  }
+}
+
+/**
+ * @brief Произведение разреженных матриц, хранящихся по строкам, по схеме
+ * Густавсона
+ *
+ * @details Строка i результата - сумма строк b, взятых с весами из строки
+ * i матрицы a. Первый проход считает число ненулевых элементов в каждой
+ * строке результата, второй накапливает значения в плотном массиве
+ * длины cols и переписывает их в порядке возрастания столбцов (см.
+ * kDenseRowRatio). Строки результата независимы и делятся между потоками,
+ * у каждой части свои рабочие массивы.
+ * @param a,b Массивы CSR; столбцы b лежат в [0, cols)
+ */
+template <class T>
+void MultiplyRows(int rows, int cols, const S21BasicSparseMatrix<T> &a,
+                  const S21BasicSparseMatrix<T> &b, std::vector<int> &offsets,
+                  std::vector<int> &indices, std::vector<T> &values) {
+  const int *a_offsets = a.Offsets().data();
+  const int *a_indices = a.Indices().data();
+  const T *a_values = a.Values().data();
+  const int *b_offsets = b.Offsets().data();
+  const int *b_indices = b.Indices().data();
+  const T *b_values = b.Values().data();
+
+  long long work = 0;
+  for (int p = 0; p < a.NonZeros(); ++p) {
+    work += b_offsets[a_indices[p] + 1] - b_offsets[a_indices[p]];
+  }
+  work *= 2;
+
+  offsets.assign(rows + 1, 0);
+  s21::detail::ParallelFor(0, rows, work, [&](int first, int last) {
+    std::vector<int> marker(cols, -1);
+    for (int i = first; i < last; ++i) {
+      int count = 0;
+      for (int p = a_offsets[i]; p < a_offsets[i + 1]; ++p) {
+        const int k = a_indices[p];
+        for (int q = b_offsets[k]; q < b_offsets[k + 1]; ++q) {
+          if (marker[b_indices[q]] != i) {
+            marker[b_indices[q]] = i;
+            ++count;
+          }
+        }
+      }
+      offsets[i + 1] = count;
+    }
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  indices.resize(offsets[rows]);
+  values.resize(offsets[rows]);
+  s21::detail::ParallelFor(0, rows, work, [&](int first, int last) {
+    std::vector<int> marker(cols, -1);
+    std::vector<T> accumulator(cols);
+    for (int i = first; i < last; ++i) {
+      int *row_indices = indices.data() + offsets[i];
+      int count = 0;
+      for (int p = a_offsets[i]; p < a_offsets[i + 1]; ++p) {
+        const int k = a_indices[p];
+        const T a_ik = a_values[p];
+        for (int q = b_offsets[k]; q < b_offsets[k + 1]; ++q) {
+          const int j = b_indices[q];
+          if (marker[j] != i) {
+            marker[j] = i;
+            row_indices[count++] = j;
+            accumulator[j] = a_ik * b_values[q];
+          } else {
+            accumulator[j] += a_ik * b_values[q];
+          }
+        }
+      }
+      if (static_cast<long long>(count) * kDenseRowRatio > cols) {
+        count = 0;
+        for (int j = 0; j < cols; ++j) {
+          if (marker[j] == i) {
+            row_indices[count++] = j;
+          }
+        }
+      } else {
+        std::sort(row_indices, row_indices + count);
+      }
+      T *row_values = values.data() + offsets[i];
+      for (int t = 0; t < count; ++t) {
+        row_values[t] = accumulator[row_indices[t]];
+      }
+    }
+  });
+}
+
+}  // namespace
+
+/**
+ * @brief Пустая матрица 0 x 0 в формате CSR
+ */
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix()
+    : rows_(0), cols_(0), format_(S21SparseFormat::kCsr), offsets_(1, 0) {}
+
+/**
+ * @brief Нулевая матрица rows x cols без ненулевых элементов
+ *
+ * @throw std::invalid_argument если размерность отрицательна
+ */
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  CheckDimensions(rows, cols);
+  offsets_.assign(Outer() + 1, 0);
+}
+
+/**
+ * @brief Матрица из списка ненулевых элементов в произвольном порядке
+ *
+ * @details Элементы с совпадающими индексами складываются. Список
+ * раскладывается дважды сортировкой подсчётом - по внутреннему индексу,
+ * затем по внешнему, - поэтому построение занимает O(nnz + rows + cols).
+ * @throw std::invalid_argument если размерность отрицательна
+ * @throw std::out_of_range если индекс элемента выходит за границы
+ */
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, const std::vector<Triplet> &triplets,
+    S21SparseFormat format)
+    : S21BasicSparseMatrix(rows, cols, format) {
+  const int count = static_cast<int>(triplets.size());
+  std::vector<int> outer(count), inner(count);
+  std::vector<T> values(count);
+  const bool csr = format == S21SparseFormat::kCsr;
+  for (int p = 0; p < count; ++p) {
+    const Triplet &t = triplets[p];
+    if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols) {
+      throw std::out_of_range("Sparse matrix index out of range.");
+    }
+    outer[p] = csr ? t.row : t.col;
+    inner[p] = csr ? t.col : t.row;
+    values[p] = t.value;
+  }
+
+  std::vector<int> by_inner_offsets, by_inner_outer;
+  std::vector<T> by_inner_values;
+  BucketSort(Inner(), count, inner.data(), outer.data(), values.data(),
+             by_inner_offsets, by_inner_outer, by_inner_values);
+  const std::vector<int> sorted_inner = ExpandOffsets(by_inner_offsets);
+  BucketSort(Outer(), count, by_inner_outer.data(), sorted_inner.data(),
+             by_inner_values.data(), offsets_, indices_, values_);
+
+  int size = 0;
+  for (int i = 0; i < Outer(); ++i) {
+    const int begin = offsets_[i];
+    offsets_[i] = size;
+    for (int p = begin; p < offsets_[i + 1]; ++p) {
+      if (p > begin && indices_[p] == indices_[size - 1]) {
+        values_[size - 1] += values_[p];
+      } else {
+        indices_[size] = indices_[p];
+        values_[size] = values_[p];
+        ++size;
+      }
+    }
+  }
+  offsets_[Outer()] = size;
+  indices_.resize(size);
+  values_.resize(size);
+}
+
+/**
+ * @brief Матрица из готовых массивов CSR или CSC
+ *
+ * @details Массивы перемещаются в матрицу без копирования после проверки
+ * структуры за O(nnz + rows + cols).
+ * @throw std::invalid_argument если размерность отрицательна, offsets не
+ * начинается с нуля или убывает, размеры массивов не согласованы или
+ * индексы внутри строки (столбца) не возрастают строго
+ */
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              S21SparseFormat format,
+                                              std::vector<int> offsets,
+                                              std::vector<int> indices,
+                                              std::vector<T> values)
+    : rows_(rows),
+      cols_(cols),
+      format_(format),
+      offsets_(std::move(offsets)),
+      indices_(std::move(indices)),
+      values_(std::move(values)) {
+  CheckDimensions(rows, cols);
+  bool valid = offsets_.size() == static_cast<std::size_t>(Outer()) + 1 &&
+               offsets_.front() == 0 &&
+               static_cast<std::size_t>(offsets_.back()) == indices_.size() &&
+               indices_.size() == values_.size();
+  for (int i = 0; valid && i < Outer(); ++i) {
+    valid = offsets_[i] <= offsets_[i + 1];
+    for (int p = offsets_[i]; valid && p < offsets_[i + 1]; ++p) {
+      valid = indices_[p] >= 0 && indices_[p] < Inner() &&
+              (p == offsets_[i] || indices_[p - 1] < indices_[p]);
+    }
+  }
+  if (!valid) {
+    throw std::invalid_argument("Invalid sparse matrix structure.");
+  }
+}
+
+/**
+ * @brief Разреженная копия плотной матрицы
+ *
+ * @param tolerance Порог отбрасывания: элементы с |a_ij| <= tolerance не
+ * хранятся; при нулевом пороге отбрасываются только точные нули
+ * @throw std::invalid_argument если порог отрицателен
+ */
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T> &dense,
+                                              Real tolerance,
+                                              S21SparseFormat format)
+    : S21BasicSparseMatrix(S21BasicMatrixView<T>(dense), tolerance, format) {}
+
+/**
+ * @brief Разреженная копия плотного представления
+ *
+ * @details Строки просматриваются дважды: сначала считается число
+ * сохраняемых элементов в каждой, затем они переписываются на свои места.
+ * Оба прохода делятся между потоками по строкам. Формат CSC получается
+ * перестановкой готового CSR.
+ * @throw std::invalid_argument если порог отрицателен
+ */
+template <class T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    const S21BasicMatrixView<T> &dense, Real tolerance, S21SparseFormat format)
+    : S21BasicSparseMatrix(dense.Rows(), dense.Cols()) {
+  CheckTolerance(tolerance);
+  const long long work = static_cast<long long>(Rows()) * Cols();
+  s21::detail::ParallelFor(0, Rows(), work, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      int count = 0;
+      for (int j = 0; j < Cols(); ++j) {
+        count += std::abs(dense.Coeff(i, j)) > tolerance;
+      }
+      offsets_[i + 1] = count;
+    }
+  });
+  std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+  indices_.resize(offsets_.back());
+  values_.resize(offsets_.back());
+  s21::detail::ParallelFor(0, Rows(), work, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      int p = offsets_[i];
+      for (int j = 0; j < Cols(); ++j) {
+        const T value = dense.Coeff(i, j);
+        if (std::abs(value) > tolerance) {
+          indices_[p] = j;
+          values_[p] = value;
+          ++p;
+        }
+      }
+    }
+  });
+
+  if (format == S21SparseFormat::kCsc) {
+    *this = ToFormat(format);
+  }
+}
+
+/**
+ * @brief Элемент (row, col) без проверки индексов; отсутствующий - ноль
+ *
+ * @details Двоичный поиск по строке (столбцу): O(log nnz_i).
+ */
+template <class T>
+T S21BasicSparseMatrix<T>::Coeff(int row, int col) const {
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  const int outer = csr ? row : col;
+  const int inner = csr ? col : row;
+  const int *begin = indices_.data() + offsets_[outer];
+  const int *end = indices_.data() + offsets_[outer + 1];
+  const int *found = std::lower_bound(begin, end, inner);
+  if (found == end || *found != inner) {
+    return T();
+  }
+  return values_[found - indices_.data()];
+}
+
+/**
+ * @brief Элемент (row, col) с проверкой индексов
+ *
+ * @throw std::out_of_range если индексы выходят за пределы
+ */
+template <class T>
+T S21BasicSparseMatrix<T>::operator()(int row, int col) const {
+  if (row < 0 || row >= Rows() || col < 0 || col >= Cols()) {
+    throw std::out_of_range("Matrix index out of range.");
+  }
+  return Coeff(row, col);
+}
+
+/**
+ * @brief Плотная копия матрицы
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(Rows(), Cols());
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  const std::ptrdiff_t outer_stride = csr ? result.Stride() : 1;
+  const std::ptrdiff_t inner_stride = csr ? 1 : result.Stride();
+  for (int i = 0; i < Outer(); ++i) {
+    for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+      result.Data()[i * outer_stride + indices_[p] * inner_stride] =
+          values_[p];
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Та же матрица в формате format
+ *
+ * @details Смена формата - перестановка элементов сортировкой подсчётом
+ * по внутреннему индексу за O(nnz + rows + cols); индексы в новых строках
+ * (столбцах) остаются упорядоченными.
+ */
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    S21SparseFormat format) const {
+  if (format == format_) {
+    return *this;
+  }
+  S21BasicSparseMatrix result;
+  result.rows_ = rows_;
+  result.cols_ = cols_;
+  result.format_ = format;
+  const std::vector<int> outer = ExpandOffsets(offsets_);
+  BucketSort(Inner(), NonZeros(), indices_.data(), outer.data(),
+             values_.data(), result.offsets_, result.indices_,
+             result.values_);
+  return result;
+}
+
+/**
+ * @brief Транспонированная матрица
+ *
+ * @details CSR матрицы A совпадает с CSC матрицы A^T, поэтому массивы
+ * копируются как есть, а формат меняется на противоположный.
+ */
+template <class T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21BasicSparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.format_ = format_ == S21SparseFormat::kCsr ? S21SparseFormat::kCsc
+                                                    : S21SparseFormat::kCsr;
+  return result;
+}
+
+/**
+ * @brief Удаляет элементы с |a_ij| <= tolerance
+ *
+ * @throw std::invalid_argument если порог отрицателен
+ */
+template <class T>
+void S21BasicSparseMatrix<T>::Prune(Real tolerance) {
+  CheckTolerance(tolerance);
+  int size = 0;
+  for (int i = 0; i < Outer(); ++i) {
+    const int begin = offsets_[i];
+    offsets_[i] = size;
+    for (int p = begin; p < offsets_[i + 1]; ++p) {
+      if (std::abs(values_[p]) > tolerance) {
+        indices_[size] = indices_[p];
+        values_[size] = values_[p];
+        ++size;
+      }
+    }
+  }
+  offsets_[Outer()] = size;
+  indices_.resize(size);
+  values_.resize(size);
+}
+
+/**
+ * @brief Произведение разреженной матрицы на плотную
+ *
+ * @details Строка i результата накапливается из строк rhs, взятых с
+ * весами из строки i матрицы lhs; строки делятся между потоками. Матрица
+ * в формате CSC предварительно переводится в CSR: это O(nnz), тогда как
+ * само произведение - O(nnz * rhs.Cols()).
+ * @throw std::invalid_argument если lhs.Cols() != rhs.Rows()
+ */
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicSparseMatrix<T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  if (lhs.Cols() != rhs.Rows()) {
+    throw std::invalid_argument(
+        "Matrices must have compatible dimensions for multiplication.");
+  }
+  if (lhs.Format() != S21SparseFormat::kCsr) {
+    return lhs.ToFormat(S21SparseFormat::kCsr) * rhs;
+  }
+
+  S21BasicMatrix<T> result(lhs.Rows(), rhs.Cols());
+  const int n = rhs.Cols();
+  const int *offsets = lhs.Offsets().data();
+  const int *indices = lhs.Indices().data();
+  const T *values = lhs.Values().data();
+  const T *b = rhs.Data();
+  T *c = result.Data();
+  const std::ptrdiff_t b_stride = rhs.Stride();
+  const std::ptrdiff_t c_stride = result.Stride();
+  const long long work = 2LL * lhs.NonZeros() * n;
+  s21::detail::ParallelFor(0, lhs.Rows(), work, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      T *c_row = c + i * c_stride;
+      for (int p = offsets[i]; p < offsets[i + 1]; ++p) {
+        const T a_ik = values[p];
+        const T *b_row = b + indices[p] * b_stride;
+        for (int j = 0; j < n; ++j) {
+          c_row[j] += a_ik * b_row[j];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+/**
+ * @brief Произведение плотной матрицы на разреженную
+ *
+ * @details Строки результата делятся между потоками. Для CSR строка i
+ * результата - сумма строк rhs с весами из строки i матрицы lhs (нулевые
+ * веса пропускаются), для CSC элемент (i, j) - скалярное произведение
+ * строки i на разреженный столбец j.
+ * @throw std::invalid_argument если lhs.Cols() != rhs.Rows()
+ */
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &lhs,
+                            const S21BasicSparseMatrix<T> &rhs) {
+  if (lhs.Cols() != rhs.Rows()) {
+    throw std::invalid_argument(
+        "Matrices must have compatible dimensions for multiplication.");
+  }
+
+  S21BasicMatrix<T> result(lhs.Rows(), rhs.Cols());
+  const int *offsets = rhs.Offsets().data();
+  const int *indices = rhs.Indices().data();
+  const T *values = rhs.Values().data();
+  const T *a = lhs.Data();
+  T *c = result.Data();
+  const std::ptrdiff_t a_stride = lhs.Stride();
+  const std::ptrdiff_t c_stride = result.Stride();
+  const bool csr = rhs.Format() == S21SparseFormat::kCsr;
+  const int outer = csr ? rhs.Rows() : rhs.Cols();
+  const long long work = 2LL * lhs.Rows() * rhs.NonZeros();
+  s21::detail::ParallelFor(0, lhs.Rows(), work, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      const T *a_row = a + i * a_stride;
+      T *c_row = c + i * c_stride;
+      for (int k = 0; k < outer; ++k) {
+        if (csr) {
+          const T a_ik = a_row[k];
+          if (a_ik == T()) {
+            continue;
+          }
+          for (int p = offsets[k]; p < offsets[k + 1]; ++p) {
+            c_row[indices[p]] += a_ik * values[p];
+          }
+        } else {
+          T sum = T();
+          for (int p = offsets[k]; p < offsets[k + 1]; ++p) {
+            sum += a_row[indices[p]] * values[p];
+          }
+          c_row[k] = sum;
+        }
+      }
+    }
+  });
+  return result;
+}
+
+/**
+ * @brief Произведение разреженных матриц
+ *
+ * @details Если обе матрицы в CSC, произведение считается как
+ * C^T = B^T * A^T над теми же массивами (CSC матрицы - это CSR
+ * транспонированной) и возвращается в CSC. Иначе операнды приводятся к
+ * CSR, и результат тоже в CSR. Индексы в строках результата упорядочены;
+ * нули, получившиеся при сокращении, сохраняются (см. Prune).
+ * @throw std::invalid_argument если lhs.Cols() != rhs.Rows()
+ */
+template <class T>
+S21BasicSparseMatrix<T> operator*(const S21BasicSparseMatrix<T> &lhs,
+                                  const S21BasicSparseMatrix<T> &rhs) {
+  if (lhs.Cols() != rhs.Rows()) {
+    throw std::invalid_argument(
+        "Matrices must have compatible dimensions for multiplication.");
+  }
+
+  std::vector<int> offsets, indices;
+  std::vector<T> values;
+  if (lhs.Format() == S21SparseFormat::kCsc &&
+      rhs.Format() == S21SparseFormat::kCsc) {
+    MultiplyRows(rhs.Cols(), lhs.Rows(), rhs, lhs, offsets, indices, values);
+    return S21BasicSparseMatrix<T>(lhs.Rows(), rhs.Cols(),
+                                   S21SparseFormat::kCsc, std::move(offsets),
+                                   std::move(indices), std::move(values));
+  }
+  if (lhs.Format() != S21SparseFormat::kCsr) {
+    return lhs.ToFormat(S21SparseFormat::kCsr) * rhs;
+  }
+  if (rhs.Format() != S21SparseFormat::kCsr) {
+    return lhs * rhs.ToFormat(S21SparseFormat::kCsr);
+  }
+  MultiplyRows(lhs.Rows(), rhs.Cols(), lhs, rhs, offsets, indices, values);
+  return S21BasicSparseMatrix<T>(lhs.Rows(), rhs.Cols(), S21SparseFormat::kCsr,
+                                 std::move(offsets), std::move(indices),
+                                 std::move(values));
+}
+
+#define S21_INSTANTIATE(T)                                              \
+  template class S21BasicSparseMatrix<T>;                               \
+  template S21BasicMatrix<T> operator*(const S21BasicSparseMatrix<T> &, \
+                                       const S21BasicMatrix<T> &);      \
+  template S21BasicMatrix<T> operator*(                                 \
+      const S21BasicMatrix<T> &, const S21BasicSparseMatrix<T> &);      \
+  template S21BasicSparseMatrix<T> operator*(                           \
+      const S21BasicSparseMatrix<T> &, const S21BasicSparseMatrix<T> &);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
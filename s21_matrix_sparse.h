@@ -0,0 +1,116 @@
+#ifndef SRC_S21_MATRIX_SPARSE_H
+#define SRC_S21_MATRIX_SPARSE_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Порядок хранения разреженной матрицы
+ *
+ * @details kCsr - по строкам (Compressed Sparse Row), kCsc - по столбцам
+ * (Compressed Sparse Column). Внешнее измерение - строки для kCsr и
+ * столбцы для kCsc, внутреннее - наоборот.
+ */
+enum class S21SparseFormat { kCsr, kCsc };
+
+/**
+ * @brief Ненулевой элемент разреженной матрицы: строка, столбец, значение
+ */
+template <class T>
+struct S21SparseTriplet {
+  int row;
+  int col;
+  T value;
+};
+
+template <class T>
+class S21BasicSparseMatrix;
+
+typedef S21BasicSparseMatrix<double> S21SparseMatrix;
+
+/**
+ * @brief Разреженная матрица в формате CSR или CSC
+ *
+ * @details Хранятся только ненулевые элементы: для i-го элемента внешнего
+ * измерения индексы внутреннего измерения лежат в
+ * Indices()[Offsets()[i] .. Offsets()[i + 1]) по возрастанию, значения - в
+ * Values() на тех же позициях. Нулевые значения, появившиеся в результате
+ * вычислений, не удаляются: для этого есть Prune().
+ */
+template <class T>
+class S21BasicSparseMatrix {
+ public:
+  typedef T Scalar;
+  typedef typename S21MatrixTraits<T>::Real Real;
+  typedef S21SparseTriplet<T> Triplet;
+
+  S21BasicSparseMatrix();
+  S21BasicSparseMatrix(int rows, int cols,
+                       S21SparseFormat format = S21SparseFormat::kCsr);
+  S21BasicSparseMatrix(int rows, int cols,
+                       const std::vector<Triplet> &triplets,
+                       S21SparseFormat format = S21SparseFormat::kCsr);
+  S21BasicSparseMatrix(int rows, int cols, S21SparseFormat format,
+                       std::vector<int> offsets, std::vector<int> indices,
+                       std::vector<T> values);
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T> &dense,
+                                Real tolerance = Real(),
+                                S21SparseFormat format = S21SparseFormat::kCsr);
+  explicit S21BasicSparseMatrix(const S21BasicMatrixView<T> &dense,
+                                Real tolerance = Real(),
+                                S21SparseFormat format = S21SparseFormat::kCsr);
+
+  inline int Rows() const { return rows_; }
+  inline int Cols() const { return cols_; }
+  inline int NonZeros() const { return static_cast<int>(values_.size()); }
+  inline S21SparseFormat Format() const { return format_; }
+  inline const std::vector<int> &Offsets() const { return offsets_; }
+  inline const std::vector<int> &Indices() const { return indices_; }
+  inline const std::vector<T> &Values() const { return values_; }
+
+  T Coeff(int row, int col) const;
+  T operator()(int row, int col) const;
+
+  S21BasicMatrix<T> ToDense() const;
+  S21BasicSparseMatrix ToFormat(S21SparseFormat format) const;
+  S21BasicSparseMatrix Transpose() const;
+  void Prune(Real tolerance);
+
+ private:
+  inline int Outer() const {
+    return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+  }
+  inline int Inner() const {
+    return format_ == S21SparseFormat::kCsr ? cols_ : rows_;
+  }
+
+  int rows_, cols_;
+  S21SparseFormat format_;
+  std::vector<int> offsets_;
+  std::vector<int> indices_;
+  std::vector<T> values_;
+};
+
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicSparseMatrix<T> &lhs,
+                            const S21BasicMatrix<T> &rhs);
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &lhs,
+                            const S21BasicSparseMatrix<T> &rhs);
+template <class T>
+S21BasicSparseMatrix<T> operator*(const S21BasicSparseMatrix<T> &lhs,
+                                  const S21BasicSparseMatrix<T> &rhs);
+
+#define S21_DECLARE_INSTANTIATION(T)                               \
+  extern template class S21BasicSparseMatrix<T>;                   \
+  extern template S21BasicMatrix<T> operator*(                     \
+      const S21BasicSparseMatrix<T> &, const S21BasicMatrix<T> &); \
+  extern template S21BasicMatrix<T> operator*(                     \
+      const S21BasicMatrix<T> &, const S21BasicSparseMatrix<T> &); \
+  extern template S21BasicSparseMatrix<T> operator*(               \
+      const S21BasicSparseMatrix<T> &, const S21BasicSparseMatrix<T> &);
+S21_ELEMENT_TYPES(S21_DECLARE_INSTANTIATION)
+#undef S21_DECLARE_INSTANTIATION
+
+#endif  // SRC_S21_MATRIX_SPARSE_H
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_pool.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Размер, до которого произведение выгоднее считать блочным ядром: ниже
+// него экономия одного умножения из восьми не окупает сложения блоков
+const int kDefaultCrossover = 1024;
+
+std::atomic<int> g_multiply_mode(static_cast<int>(S21MultiplyMode::kFast));
+std::atomic<int> g_crossover(kDefaultCrossover);
+}  // namespace
+
+namespace s21 {
+namespace detail {
+namespace {
+
+/**
+ * @brief dst = x + sign * y для блоков rows x cols
+ *
+ * @details dst может совпадать с x. Строки делятся между потоками.
+ */
+template <class T>
+void Combine(int rows, int cols, const T *x, std::ptrdiff_t x_rs,
+             std::ptrdiff_t x_cs, const T *y, std::ptrdiff_t y_rs,
+             std::ptrdiff_t y_cs, T sign, T *dst, std::ptrdiff_t dst_rs) {
+  ParallelFor(0, rows, static_cast<long long>(rows) * cols,
+              [&](int first, int last) {
+                for (int i = first; i < last; ++i) {
+                  const T *x_row = x + i * x_rs;
+                  const T *y_row = y + i * y_rs;
+                  T *dst_row = dst + i * dst_rs;
+                  for (int j = 0; j < cols; ++j) {
+                    dst_row[j] = x_row[j * x_cs] + sign * y_row[j * y_cs];
+                  }
+                }
+              });
+}
+
+/**
+ * @brief Операнд произведения: указатель на элемент (0, 0) и шаги
+ */
+template <class T>
+struct Operand {
+  const T *data;
+  std::ptrdiff_t rs, cs;
+
+  inline Operand Block(int i, int j) const {
+    return {data + i * rs + j * cs, rs, cs};
+  }
+};
+
+/**
+ * @brief Объём рабочей памяти Strassen для произведения m x k на k x n
+ */
+std::size_t WorkspaceSize(int m, int n, int k, int crossover) {
+  std::size_t size = 0;
+  while (std::min(m, std::min(n, k)) > crossover) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    size += static_cast<std::size_t>(m) * std::max(n, k) +
+            static_cast<std::size_t>(k) * n;
+  }
+  return size;
+}
+
+/**
+ * @brief C = A * B, A - m x k, B - k x n
+ *
+ * @details Один уровень Штрассена-Винограда над чётной частью размеров в
+ * порядке из работы Boyer, Dumas, Pernet, Zhou "Memory efficient
+ * scheduling of Strassen-Winograd's matrix multiplication algorithm"
+ * (2009): кроме четвертей C нужны только два временных блока X и Y, и
+ * рабочая память всех уровней вместе меньше 4/3 от первого. Нечётные
+ * последние строка и столбец (и строка B при нечётном k) не дополняются
+ * нулями, а досчитываются блочным ядром.
+ */
+template <class T>
+void Strassen(int m, int n, int k, Operand<T> a, Operand<T> b, T *c,
+              std::ptrdiff_t c_rs, T *work, int crossover) {
+  if (std::min(m, std::min(n, k)) <= crossover) {
+    ClassicGemm(m, n, k, T(1), a.data, a.rs, a.cs, b.data, b.rs, b.cs, T(), c,
+                c_rs);
+    return;
+  }
+  const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const T one(1), minus(-1);
+  const Operand<T> a11 = a, a12 = a.Block(0, k2), a21 = a.Block(m2, 0),
+                   a22 = a.Block(m2, k2);
+  const Operand<T> b11 = b, b12 = b.Block(0, n2), b21 = b.Block(k2, 0),
+                   b22 = b.Block(k2, n2);
+  T *c11 = c, *c12 = c + n2, *c21 = c + m2 * c_rs, *c22 = c21 + n2;
+  // X хранит S_i (m2 x k2), а затем P1 (m2 x n2); Y хранит T_i (k2 x n2)
+  const std::ptrdiff_t x_rs = std::max(n2, k2);
+  T *x = work;
+  T *y = x + m2 * x_rs;
+  T *next = y + static_cast<std::ptrdiff_t>(k2) * n2;
+  const Operand<T> xs = {x, x_rs, 1}, ys = {y, n2, 1};
+  const auto multiply = [&](Operand<T> lhs, Operand<T> rhs, T *dst,
+                            std::ptrdiff_t dst_rs) {
+    Strassen(m2, n2, k2, lhs, rhs, dst, dst_rs, next, crossover);
+  };
+  const auto combine = [&](int rows, int cols, Operand<T> lhs, T sign,
+                           Operand<T> rhs, T *dst, std::ptrdiff_t dst_rs) {
+    Combine(rows, cols, lhs.data, lhs.rs, lhs.cs, rhs.data, rhs.rs, rhs.cs,
+            sign, dst, dst_rs);
+  };
+  const auto c_block = [&](T *block) { return Operand<T>{block, c_rs, 1}; };
+
+  combine(m2, k2, a11, minus, a21, x, x_rs);                      // S3
+  combine(k2, n2, b22, minus, b12, y, n2);                        // T3
+  multiply(xs, ys, c21, c_rs);                                    // P7
+  combine(m2, k2, a21, one, a22, x, x_rs);                        // S1
+  combine(k2, n2, b12, minus, b11, y, n2);                        // T1
+  multiply(xs, ys, c22, c_rs);                                    // P5
+  combine(m2, k2, xs, minus, a11, x, x_rs);                       // S2
+  combine(k2, n2, b22, minus, ys, y, n2);                         // T2
+  multiply(xs, ys, c12, c_rs);                                    // P6
+  combine(m2, k2, a12, minus, xs, x, x_rs);                       // S4
+  multiply(xs, b22, c11, c_rs);                                   // P3
+  multiply(a11, b11, x, x_rs);                                    // P1
+  combine(m2, n2, xs, one, c_block(c12), c12, c_rs);              // U2
+  combine(m2, n2, c_block(c21), one, c_block(c12), c21, c_rs);    // U3
+  combine(m2, n2, c_block(c12), one, c_block(c22), c12, c_rs);    // U4
+  combine(m2, n2, c_block(c21), one, c_block(c22), c22, c_rs);    // U7
+  combine(m2, n2, c_block(c12), one, c_block(c11), c12, c_rs);    // U5
+  combine(k2, n2, ys, minus, b21, y, n2);                         // T4
+  multiply(a22, ys, c11, c_rs);                                   // P4
+  combine(m2, n2, c_block(c21), minus, c_block(c11), c21, c_rs);  // U6
+  multiply(a12, b21, c11, c_rs);                                  // P2
+  combine(m2, n2, xs, one, c_block(c11), c11, c_rs);              // U1
+
+  if (k % 2 != 0) {
+    const Operand<T> a_col = a.Block(0, k - 1), b_row = b.Block(k - 1, 0);
+    ClassicGemm(2 * m2, 2 * n2, 1, one, a_col.data, a_col.rs, a_col.cs,
+                b_row.data, b_row.rs, b_row.cs, one, c, c_rs);
+  }
+  if (n % 2 != 0) {
+    const Operand<T> b_col = b.Block(0, n - 1);
+    ClassicGemm(2 * m2, 1, k, one, a.data, a.rs, a.cs, b_col.data, b_col.rs,
+                b_col.cs, T(), c + n - 1, c_rs);
+  }
+  if (m % 2 != 0) {
+    const Operand<T> a_row = a.Block(m - 1, 0);
+    ClassicGemm(1, n, k, one, a_row.data, a_row.rs, a_row.cs, b.data, b.rs,
+                b.cs, T(), c + (m - 1) * c_rs, c_rs);
+  }
+}
+
+}  // namespace
+
+bool UseStrassen(int m, int n, int k) {
+  return S21GetMultiplyMode() == S21MultiplyMode::kFast &&
+         std::min(m, std::min(n, k)) > S21GetStrassenCrossover();
+}
+
+/**
+ * @details Рабочая память всех уровней выделяется один раз до начала
+ * рекурсии (из пула, если действует S21MatrixPoolScope). При beta != 0
+ * произведение сначала считается в отдельный буфер.
+ */
+template <class T>
+void StrassenGemm(int m, int n, int k, T alpha, const T *a,
+                  std::ptrdiff_t a_rs, std::ptrdiff_t a_cs, const T *b,
+                  std::ptrdiff_t b_rs, std::ptrdiff_t b_cs, T beta, T *c,
+                  std::ptrdiff_t c_rs) {
+  const int crossover = S21GetStrassenCrossover();
+  if (m <= 0 || n <= 0 || k <= 0 || alpha == T() ||
+      std::min(m, std::min(n, k)) <= crossover) {
+    ClassicGemm(m, n, k, alpha, a, a_rs, a_cs, b, b_rs, b_cs, beta, c, c_rs);
+    return;
+  }
+  const std::size_t work_size = WorkspaceSize(m, n, k, crossover);
+  const std::size_t product_size =
+      beta == T() ? 0 : static_cast<std::size_t>(m) * n;
+  std::unique_ptr<T, void (*)(void *)> work(
+      static_cast<T *>(AllocateBuffer(work_size + product_size, sizeof(T))),
+      FreeBuffer);
+  T *product = beta == T() ? c : work.get() + work_size;
+  const std::ptrdiff_t product_rs = beta == T() ? c_rs : n;
+  Strassen(m, n, k, Operand<T>{a, a_rs, a_cs}, Operand<T>{b, b_rs, b_cs},
+           product, product_rs, work.get(), crossover);
+  if (alpha == T(1) && beta == T()) {
+    return;
+  }
+  ParallelFor(0, m, static_cast<long long>(m) * n, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      const T *p_row = product + i * product_rs;
+      T *c_row = c + i * c_rs;
+      for (int j = 0; j < n; ++j) {
+        c_row[j] = beta == T() ? alpha * p_row[j]
+                               : alpha * p_row[j] + beta * c_row[j];
+      }
+    }
+  });
+}
+
+#define S21_INSTANTIATE(T)                                                   \
+  template void StrassenGemm<T>(int, int, int, T, const T *, std::ptrdiff_t, \
+                                std::ptrdiff_t, const T *, std::ptrdiff_t,   \
+                                std::ptrdiff_t, T, T *, std::ptrdiff_t);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
+
+}  // namespace detail
+}  // namespace s21
+
+/**
+ * @brief Алгоритм умножения больших матриц; по умолчанию kFast
+ */
+S21MultiplyMode S21GetMultiplyMode() {
+  return static_cast<S21MultiplyMode>(g_multiply_mode.load());
+}
+
+/**
+ * @brief Выбирает алгоритм умножения больших матриц
+ *
+ * @details kAccurate отключает алгоритм Штрассена, если нужна ошибка
+ * округления обычного произведения.
+ */
+void S21SetMultiplyMode(S21MultiplyMode mode) {
+  g_multiply_mode.store(static_cast<int>(mode));
+}
+
+/**
+ * @brief Наибольший размер, до которого произведение считается блочным
+ * ядром и в режиме kFast
+ */
+int S21GetStrassenCrossover() { return g_crossover.load(); }
+
+/**
+ * @brief Задаёт размер перехода к блочному ядру
+ *
+ * @details Алгоритм Штрассена применяется, если все размеры произведения
+ * больше size, и рекурсия спускается до блоков не больше size. Значения
+ * меньше 16 поднимаются до 16: на меньших блоках сложения стоят дороже
+ * сэкономленных умножений.
+ */
+void S21SetStrassenCrossover(int size) {
+  g_crossover.store(std::max(size, 16));
+}
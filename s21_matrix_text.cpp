@@ -0,0 +1,654 @@
+#include "s21_matrix_text.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Размер порции чтения; строка длиннее порции увеличивает буфер вдвое
+const std::size_t kChunkSize = std::size_t(1) << 20;
+// Число чисел, форматируемых за одну порцию записи
+const long long kWriteBatch = 1 << 16;
+// Оценки объёма работы для ParallelFor: разбор байта и запись числа
+const long long kParseCost = 4;
+const long long kFormatCost = 64;
+
+/**
+ * @brief Строка файла без перевода строки и номер её в файле (с 1)
+ */
+struct Line {
+  const char *begin;
+  const char *end;
+  long long number;
+};
+
+std::runtime_error ParseError(const char *what, long long line) {
+  return std::runtime_error(std::string(what) + " at line " +
+                            std::to_string(line) + ".");
+}
+
+/**
+ * @brief Читает файл порциями по kChunkSize байт и делит их на строки
+ *
+ * @details Строки указывают в буфер читателя и действительны до
+ * следующего вызова Next(). Незаконченная строка в конце порции
+ * переносится в начало буфера и дочитывается следующей порцией. Пустые
+ * строки (в том числе "\r" от переводов строк Windows) пропускаются.
+ */
+class LineReader {
+ public:
+  explicit LineReader(const std::string &path)
+      : stream_(path, std::ios::binary),
+        buffer_(kChunkSize),
+        size_(0),
+        consumed_(0),
+        line_(0),
+        eof_(false) {
+    if (!stream_) {
+      throw std::runtime_error("Cannot open matrix file.");
+    }
+  }
+
+  inline const std::vector<Line> &Lines() const { return lines_; }
+
+  /**
+   * @brief Читает следующую порцию строк; false, когда строк не осталось
+   *
+   * @throw std::runtime_error при ошибке чтения
+   */
+  bool Next() {
+    lines_.clear();
+    while (lines_.empty() && !(eof_ && consumed_ == size_)) {
+      std::memmove(buffer_.data(), buffer_.data() + consumed_,
+                   size_ - consumed_);
+      size_ -= consumed_;
+      consumed_ = 0;
+      if (size_ == buffer_.size()) {
+        buffer_.resize(buffer_.size() * 2);
+      }
+      stream_.read(buffer_.data() + size_, buffer_.size() - size_);
+      if (stream_.bad()) {
+        throw std::runtime_error("Cannot read matrix file.");
+      }
+      size_ += static_cast<std::size_t>(stream_.gcount());
+      eof_ = stream_.eof();
+      Split();
+    }
+    return !lines_.empty();
+  }
+
+ private:
+  void Split() {
+    const char *p = buffer_.data() + consumed_;
+    const char *end = buffer_.data() + size_;
+    while (const char *newline =
+               static_cast<const char *>(std::memchr(p, '\n', end - p))) {
+      Add(p, newline);
+      p = newline + 1;
+    }
+    if (eof_ && p != end) {
+      Add(p, end);
+      p = end;
+    }
+    consumed_ = p - buffer_.data();
+  }
+
+  void Add(const char *begin, const char *end) {
+    ++line_;
+    if (end != begin && end[-1] == '\r') {
+      --end;
+    }
+    if (end != begin) {
+      lines_.push_back({begin, end, line_});
+    }
+  }
+
+  std::ifstream stream_;
+  std::vector<char> buffer_;
+  std::size_t size_;
+  std::size_t consumed_;
+  long long line_;
+  bool eof_;
+  std::vector<Line> lines_;
+};
+
+inline bool IsBlank(char c) { return c == ' ' || c == '\t'; }
+
+inline void SkipBlanks(const char *&p, const char *end) {
+  while (p != end && IsBlank(*p)) {
+    ++p;
+  }
+}
+
+/**
+ * @brief Разбирает число с позиции p, пропустив пробелы перед ним
+ *
+ * @details std::from_chars не принимает знак "+" и не возвращает значение
+ * при выходе за диапазон типа; первый случай обрабатывается здесь, во
+ * втором число разбирается strtold.
+ * @return false, если с позиции p не начинается число
+ */
+template <class T>
+bool ParseNumber(const char *&p, const char *end, T &value) {
+  SkipBlanks(p, end);
+  const char *start = p;
+  if (p != end && *p == '+') {
+    ++p;
+    if (p != end && *p == '-') {
+      return false;
+    }
+  }
+  const std::from_chars_result result = std::from_chars(p, end, value);
+  if (result.ec == std::errc::result_out_of_range) {
+    const std::string token(start, result.ptr);
+    value = static_cast<T>(std::strtold(token.c_str(), nullptr));
+  } else if (result.ec != std::errc()) {
+    return false;
+  }
+  p = result.ptr;
+  return true;
+}
+
+bool ParseInteger(const char *&p, const char *end, long long &value) {
+  SkipBlanks(p, end);
+  const std::from_chars_result result = std::from_chars(p, end, value);
+  p = result.ptr;
+  return result.ec == std::errc();
+}
+
+template <class T>
+void AppendNumber(std::string &out, T value) {
+  char buffer[64];
+  const std::to_chars_result result =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+}
+
+/**
+ * @brief Разбирает строки lines[first..] параллельно: fn(line, t), где t -
+ * номер строки, считая от first
+ */
+template <class Fn>
+void ParseLines(const std::vector<Line> &lines, std::size_t first,
+                const Fn &fn) {
+  if (first >= lines.size()) {
+    return;
+  }
+  const long long work = kParseCost * (lines.back().end - lines[first].begin);
+  s21::detail::ParallelFor(
+      static_cast<int>(first), static_cast<int>(lines.size()), work,
+      [&](int begin, int end) {
+        for (int t = begin; t < end; ++t) {
+          fn(lines[t], t - first);
+        }
+      });
+}
+
+/**
+ * @brief Записывает count элементов порциями: элементы порции
+ * форматируются format(index, text) параллельно и пишутся по порядку
+ *
+ * @param numbers Примерное число чисел в одном элементе
+ * @throw std::runtime_error при ошибке записи в поток
+ */
+template <class Format>
+void WriteBatches(std::ostream &stream, int count, long long numbers,
+                  const Format &format) {
+  numbers = std::max(numbers, 1LL);
+  const int batch = static_cast<int>(
+      std::max(1LL, std::min<long long>(count, kWriteBatch / numbers)));
+  std::vector<std::string> texts(batch);
+  for (int first = 0; first < count; first += batch) {
+    const int size = std::min(batch, count - first);
+    s21::detail::ParallelFor(0, size, kFormatCost * numbers * size,
+                             [&](int begin, int end) {
+                               for (int t = begin; t < end; ++t) {
+                                 texts[t].clear();
+                                 format(first + t, texts[t]);
+                               }
+                             });
+    for (int t = 0; t < size && stream; ++t) {
+      stream.write(texts[t].data(), texts[t].size());
+    }
+    if (!stream) {
+      throw std::runtime_error("Cannot write matrix text.");
+    }
+  }
+}
+
+// --- CSV ---
+
+int CountFields(const Line &line, char delimiter) {
+  if (!IsBlank(delimiter)) {
+    return 1 + static_cast<int>(std::count(line.begin, line.end, delimiter));
+  }
+  int fields = 0;
+  for (const char *p = line.begin; p != line.end; ++p) {
+    fields += !IsBlank(*p) && (p == line.begin || IsBlank(p[-1]));
+  }
+  return fields;
+}
+
+template <class T>
+void ParseCsvRow(const Line &line, char delimiter, T *row, int cols) {
+  const char *p = line.begin;
+  for (int j = 0; j < cols; ++j) {
+    if (j > 0) {
+      if (IsBlank(delimiter)) {
+        if (p == line.end || !IsBlank(*p)) {
+          throw ParseError("Malformed CSV row", line.number);
+        }
+      } else {
+        SkipBlanks(p, line.end);
+        if (p == line.end || *p != delimiter) {
+          throw ParseError("Malformed CSV row", line.number);
+        }
+        ++p;
+      }
+    }
+    if (!ParseNumber(p, line.end, row[j])) {
+      throw ParseError("Malformed number", line.number);
+    }
+  }
+  SkipBlanks(p, line.end);
+  if (p != line.end) {
+    throw ParseError("Malformed CSV row", line.number);
+  }
+}
+
+// --- Matrix Market ---
+
+enum class MarketField { kReal, kInteger, kPattern };
+enum class MarketSymmetry { kGeneral, kSymmetric, kSkewSymmetric };
+
+struct MarketHeader {
+  bool coordinate;
+  MarketField field;
+  MarketSymmetry symmetry;
+  int rows, cols;
+  long long entries;
+};
+
+std::vector<std::string> SplitWords(const Line &line) {
+  std::vector<std::string> words;
+  const char *p = line.begin;
+  while (SkipBlanks(p, line.end), p != line.end) {
+    std::string word;
+    for (; p != line.end && !IsBlank(*p); ++p) {
+      word += static_cast<char>(std::tolower(static_cast<unsigned char>(*p)));
+    }
+    words.push_back(word);
+  }
+  return words;
+}
+
+MarketHeader ParseBanner(const Line &line) {
+  const std::vector<std::string> words = SplitWords(line);
+  MarketHeader header = {};
+  bool valid = words.size() == 5 && words[0] == "%%matrixmarket" &&
+               words[1] == "matrix" &&
+               (words[2] == "array" || words[2] == "coordinate");
+  if (valid) {
+    header.coordinate = words[2] == "coordinate";
+    if (words[3] == "real") {
+      header.field = MarketField::kReal;
+    } else if (words[3] == "integer") {
+      header.field = MarketField::kInteger;
+    } else if (words[3] == "pattern" && header.coordinate) {
+      header.field = MarketField::kPattern;
+    } else {
+      valid = false;
+    }
+    if (words[4] == "general") {
+      header.symmetry = MarketSymmetry::kGeneral;
+    } else if (words[4] == "symmetric") {
+      header.symmetry = MarketSymmetry::kSymmetric;
+    } else if (words[4] == "skew-symmetric") {
+      header.symmetry = MarketSymmetry::kSkewSymmetric;
+    } else {
+      valid = false;
+    }
+  }
+  if (!valid) {
+    throw ParseError("Unsupported Matrix Market header", line.number);
+  }
+  return header;
+}
+
+void ParseSize(const Line &line, MarketHeader &header) {
+  const char *p = line.begin;
+  long long rows = 0, cols = 0, entries = 0;
+  bool valid = ParseInteger(p, line.end, rows) &&
+               ParseInteger(p, line.end, cols) &&
+               (!header.coordinate || ParseInteger(p, line.end, entries));
+  SkipBlanks(p, line.end);
+  valid = valid && p == line.end && rows >= 0 && rows <= INT_MAX &&
+          cols >= 0 && cols <= INT_MAX && entries >= 0 &&
+          (header.symmetry == MarketSymmetry::kGeneral || rows == cols);
+  if (!valid) {
+    throw ParseError("Malformed Matrix Market size", line.number);
+  }
+  header.rows = static_cast<int>(rows);
+  header.cols = static_cast<int>(cols);
+  if (header.coordinate) {
+    header.entries = entries;
+  } else if (header.symmetry == MarketSymmetry::kGeneral) {
+    header.entries = rows * cols;
+  } else if (header.symmetry == MarketSymmetry::kSymmetric) {
+    header.entries = rows * (rows + 1) / 2;
+  } else {
+    header.entries = rows * (rows - 1) / 2;
+  }
+}
+
+/**
+ * @brief Разбирает файл Matrix Market
+ *
+ * @details start(header) вызывается после строки размеров,
+ * entries(lines, first, index) - для каждой порции строк данных:
+ * lines[first] - элемент номер index.
+ */
+template <class Start, class Entries>
+void ReadMarket(const std::string &path, const Start &start,
+                const Entries &entries) {
+  LineReader reader(path);
+  MarketHeader header = {};
+  int stage = 0;
+  long long count = 0;
+  while (reader.Next()) {
+    const std::vector<Line> &lines = reader.Lines();
+    std::size_t t = 0;
+    for (; t < lines.size() && stage < 2; ++t) {
+      if (stage == 0) {
+        if (lines[t].number != 1) {
+          throw ParseError("Missing Matrix Market header", lines[t].number);
+        }
+        header = ParseBanner(lines[t]);
+        stage = 1;
+      } else if (*lines[t].begin != '%') {
+        ParseSize(lines[t], header);
+        start(header);
+        stage = 2;
+      }
+    }
+    if (t < lines.size()) {
+      const long long rest = header.entries - count;
+      if (static_cast<long long>(lines.size() - t) > rest) {
+        throw ParseError("Too many Matrix Market entries",
+                         lines[t + rest].number);
+      }
+      entries(lines, t, count);
+      count += lines.size() - t;
+    }
+  }
+  if (stage < 2 || count != header.entries) {
+    throw std::runtime_error("Matrix Market file is truncated.");
+  }
+}
+
+template <class T>
+void ParseValue(const Line &line, T &value) {
+  const char *p = line.begin;
+  if (!ParseNumber(p, line.end, value)) {
+    throw ParseError("Malformed number", line.number);
+  }
+  SkipBlanks(p, line.end);
+  if (p != line.end) {
+    throw ParseError("Malformed Matrix Market entry", line.number);
+  }
+}
+
+template <class T>
+void ParseCoordinate(const Line &line, const MarketHeader &header,
+                     S21SparseTriplet<T> &entry) {
+  const char *p = line.begin;
+  long long row = 0, col = 0;
+  if (!ParseInteger(p, line.end, row) || !ParseInteger(p, line.end, col) ||
+      row < 1 || row > header.rows || col < 1 || col > header.cols) {
+    throw ParseError("Malformed Matrix Market entry", line.number);
+  }
+  entry.row = static_cast<int>(row - 1);
+  entry.col = static_cast<int>(col - 1);
+  entry.value = T(1);
+  if (header.field != MarketField::kPattern &&
+      !ParseNumber(p, line.end, entry.value)) {
+    throw ParseError("Malformed number", line.number);
+  }
+  SkipBlanks(p, line.end);
+  if (p != line.end) {
+    throw ParseError("Malformed Matrix Market entry", line.number);
+  }
+}
+
+/**
+ * @brief Читает файл Matrix Market: array - прямо в dense, coordinate - в
+ * triplets; симметричная половина не достраивается, кроме array
+ */
+template <class T>
+MarketHeader ReadMarketEntries(const std::string &path,
+                               S21BasicMatrix<T> &dense,
+                               std::vector<S21SparseTriplet<T> > &triplets) {
+  MarketHeader header = {};
+  // Позиция следующего элемента треугольника для симметричного array
+  int row = 0, col = 0;
+  const auto start = [&](const MarketHeader &parsed) {
+    header = parsed;
+    if (header.coordinate) {
+      triplets.resize(header.entries);
+    } else {
+      dense = S21BasicMatrix<T>(header.rows, header.cols);
+      row = header.symmetry == MarketSymmetry::kSkewSymmetric ? 1 : 0;
+    }
+  };
+  const auto entries = [&](const std::vector<Line> &lines, std::size_t first,
+                           long long index) {
+    if (header.coordinate) {
+      ParseLines(lines, first, [&](const Line &line, std::size_t t) {
+        ParseCoordinate(line, header, triplets[index + t]);
+      });
+    } else if (header.symmetry == MarketSymmetry::kGeneral) {
+      T *data = dense.Data();
+      const std::ptrdiff_t stride = dense.Stride();
+      ParseLines(lines, first, [&](const Line &line, std::size_t t) {
+        const long long k = index + t;
+        ParseValue(line, data[k % header.rows * stride + k / header.rows]);
+      });
+    } else {
+      const bool skew = header.symmetry == MarketSymmetry::kSkewSymmetric;
+      for (std::size_t t = first; t < lines.size(); ++t) {
+        T value;
+        ParseValue(lines[t], value);
+        dense(row, col) = value;
+        dense(col, row) = skew ? -value : value;
+        if (++row == header.rows) {
+          ++col;
+          row = skew ? col + 1 : col;
+        }
+      }
+    }
+  };
+  ReadMarket(path, start, entries);
+  return header;
+}
+
+/**
+ * @brief Дописывает к triplets отражения элементов вне диагонали
+ */
+template <class T>
+void MirrorTriplets(const MarketHeader &header,
+                    std::vector<S21SparseTriplet<T> > &triplets) {
+  if (header.symmetry == MarketSymmetry::kGeneral) {
+    return;
+  }
+  const bool skew = header.symmetry == MarketSymmetry::kSkewSymmetric;
+  const std::size_t size = triplets.size();
+  for (std::size_t p = 0; p < size; ++p) {
+    const S21SparseTriplet<T> entry = triplets[p];
+    if (entry.row != entry.col) {
+      triplets.push_back(
+          {entry.col, entry.row, skew ? -entry.value : entry.value});
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+S21BasicMatrix<T> S21ReadCsv(const std::string &path, char delimiter) {
+  int rows = 0, cols = 0;
+  {
+    LineReader reader(path);
+    while (reader.Next()) {
+      if (rows == 0) {
+        cols = CountFields(reader.Lines().front(), delimiter);
+      }
+      if (reader.Lines().size() > static_cast<std::size_t>(INT_MAX - rows)) {
+        throw std::runtime_error("CSV file has too many rows.");
+      }
+      rows += static_cast<int>(reader.Lines().size());
+    }
+  }
+
+  S21BasicMatrix<T> result(rows, cols);
+  LineReader reader(path);
+  int row = 0;
+  while (reader.Next()) {
+    const std::vector<Line> &lines = reader.Lines();
+    if (lines.size() > static_cast<std::size_t>(rows - row)) {
+      throw std::runtime_error("CSV file changed while reading.");
+    }
+    const std::ptrdiff_t stride = result.Stride();
+    T *data = result.Data() + row * stride;
+    ParseLines(lines, 0, [&](const Line &line, std::size_t t) {
+      ParseCsvRow(line, delimiter, data + t * stride, cols);
+    });
+    row += static_cast<int>(lines.size());
+  }
+  if (row != rows) {
+    throw std::runtime_error("CSV file changed while reading.");
+  }
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> S21ReadMatrixMarket(const std::string &path) {
+  S21BasicMatrix<T> dense;
+  std::vector<S21SparseTriplet<T> > triplets;
+  const MarketHeader header = ReadMarketEntries(path, dense, triplets);
+  if (header.coordinate) {
+    MirrorTriplets(header, triplets);
+    dense = S21BasicMatrix<T>(header.rows, header.cols);
+    for (const S21SparseTriplet<T> &entry : triplets) {
+      dense(entry.row, entry.col) += entry.value;
+    }
+  }
+  return dense;
+}
+
+template <class T>
+S21BasicSparseMatrix<T> S21ReadMatrixMarketSparse(const std::string &path,
+                                                  S21SparseFormat format) {
+  S21BasicMatrix<T> dense;
+  std::vector<S21SparseTriplet<T> > triplets;
+  const MarketHeader header = ReadMarketEntries(path, dense, triplets);
+  if (!header.coordinate) {
+    return S21BasicSparseMatrix<T>(dense, T(), format);
+  }
+  MirrorTriplets(header, triplets);
+  return S21BasicSparseMatrix<T>(header.rows, header.cols, triplets, format);
+}
+
+template <class T>
+void S21WriteCsv(std::ostream &stream, const S21BasicMatrixView<T> &view,
+                 char delimiter) {
+  WriteBatches(stream, view.Rows(), view.Cols(),
+               [&](int i, std::string &text) {
+                 for (int j = 0; j < view.Cols(); ++j) {
+                   if (j > 0) {
+                     text += delimiter;
+                   }
+                   AppendNumber(text, view.Coeff(i, j));
+                 }
+                 text += '\n';
+               });
+}
+
+template <class T>
+void S21WriteCsv(std::ostream &stream, const S21BasicMatrix<T> &matrix,
+                 char delimiter) {
+  S21WriteCsv(stream, S21BasicMatrixView<T>(matrix), delimiter);
+}
+
+/**
+ * @details Элементы идут по столбцам, как того требует формат array.
+ */
+template <class T>
+void S21WriteMatrixMarket(std::ostream &stream,
+                          const S21BasicMatrixView<T> &view) {
+  stream << "%%MatrixMarket matrix array real general\n"
+         << view.Rows() << ' ' << view.Cols() << '\n';
+  WriteBatches(stream, view.Cols(), view.Rows(),
+               [&](int j, std::string &text) {
+                 for (int i = 0; i < view.Rows(); ++i) {
+                   AppendNumber(text, view.Coeff(i, j));
+                   text += '\n';
+                 }
+               });
+}
+
+template <class T>
+void S21WriteMatrixMarket(std::ostream &stream,
+                          const S21BasicMatrix<T> &matrix) {
+  S21WriteMatrixMarket(stream, S21BasicMatrixView<T>(matrix));
+}
+
+template <class T>
+void S21WriteMatrixMarket(std::ostream &stream,
+                          const S21BasicSparseMatrix<T> &matrix) {
+  stream << "%%MatrixMarket matrix coordinate real general\n"
+         << matrix.Rows() << ' ' << matrix.Cols() << ' ' << matrix.NonZeros()
+         << '\n';
+  const bool csr = matrix.Format() == S21SparseFormat::kCsr;
+  const int outer = static_cast<int>(matrix.Offsets().size()) - 1;
+  const std::vector<int> &offsets = matrix.Offsets();
+  const std::vector<int> &indices = matrix.Indices();
+  const std::vector<T> &values = matrix.Values();
+  WriteBatches(stream, outer, 3LL * matrix.NonZeros() / std::max(outer, 1),
+               [&](int i, std::string &text) {
+                 for (int p = offsets[i]; p < offsets[i + 1]; ++p) {
+                   AppendNumber(text, (csr ? i : indices[p]) + 1);
+                   text += ' ';
+                   AppendNumber(text, (csr ? indices[p] : i) + 1);
+                   text += ' ';
+                   AppendNumber(text, values[p]);
+                   text += '\n';
+                 }
+               });
+}
+
+#define S21_INSTANTIATE(T)                                                 \
+  template S21BasicMatrix<T> S21ReadCsv<T>(const std::string &, char);     \
+  template S21BasicMatrix<T> S21ReadMatrixMarket<T>(const std::string &);  \
+  template S21BasicSparseMatrix<T> S21ReadMatrixMarketSparse<T>(           \
+      const std::string &, S21SparseFormat);                               \
+  template void S21WriteCsv(std::ostream &, const S21BasicMatrixView<T> &, \
+                            char);                                         \
+  template void S21WriteCsv(std::ostream &, const S21BasicMatrix<T> &,     \
+                            char);                                         \
+  template void S21WriteMatrixMarket(std::ostream &,                       \
+                                     const S21BasicMatrixView<T> &);       \
+  template void S21WriteMatrixMarket(std::ostream &,                       \
+                                     const S21BasicMatrix<T> &);           \
+  template void S21WriteMatrixMarket(std::ostream &,                       \
+                                     const S21BasicSparseMatrix<T> &);
+S21_REAL_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
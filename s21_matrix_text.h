@@ -0,0 +1,107 @@
+#ifndef SRC_S21_MATRIX_TEXT_H
+#define SRC_S21_MATRIX_TEXT_H
+
+#include <ostream>
+#include <string>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_sparse.h"
+
+/**
+ * @brief Текстовые форматы матриц: CSV и Matrix Market
+ *
+ * @details Чтение потоковое: файл читается порциями фиксированного
+ * размера, числа разбираются std::from_chars прямо в память матрицы, а
+ * строки одной порции разбираются параллельно в общем пуле потоков (см.
+ * S21SetThreadCount). Числа вне диапазона типа разбираются через
+ * strtold, как это делает strtod: переполнение даёт бесконечность,
+ * исчезновение порядка - ноль. Запись тоже идёт порциями: строки порции
+ * форматируются std::to_chars параллельно (кратчайшая запись, которая
+ * читается обратно в то же число) и записываются в поток по порядку.
+ *
+ * Ошибки чтения - std::runtime_error с номером строки файла.
+ */
+
+/**
+ * @brief Читает CSV: одна строка файла - одна строка матрицы
+ *
+ * @details Файл читается дважды: первый проход считает строки, второй
+ * разбирает их на места в уже созданной матрице. Пустые строки
+ * пропускаются, пробелы и табуляции вокруг чисел допускаются; если
+ * разделитель - пробел или табуляция, числа разделяет любое число
+ * пробельных символов.
+ * @throw std::runtime_error если файл не открывается, в строке не то
+ * число полей или поле не число
+ */
+template <class T = double>
+S21BasicMatrix<T> S21ReadCsv(const std::string &path, char delimiter = ',');
+
+/**
+ * @brief Читает Matrix Market (array или coordinate; real, integer или
+ * pattern; general, symmetric или skew-symmetric) в плотную матрицу
+ *
+ * @throw std::runtime_error если файл не открывается, заголовок не
+ * распознан, вид матрицы не поддерживается, данные не разбираются или их
+ * меньше объявленного
+ */
+template <class T = double>
+S21BasicMatrix<T> S21ReadMatrixMarket(const std::string &path);
+
+/**
+ * @brief Читает Matrix Market в разреженную матрицу формата format
+ *
+ * @details Формат array тоже допускается, нули при этом не хранятся.
+ * @throw std::runtime_error как S21ReadMatrixMarket
+ */
+template <class T = double>
+S21BasicSparseMatrix<T> S21ReadMatrixMarketSparse(
+    const std::string &path, S21SparseFormat format = S21SparseFormat::kCsr);
+
+/**
+ * @brief Записывает матрицу в CSV; замена Print() для больших матриц
+ *
+ * @throw std::runtime_error при ошибке записи в поток
+ */
+template <class T>
+void S21WriteCsv(std::ostream &stream, const S21BasicMatrixView<T> &view,
+                 char delimiter = ',');
+template <class T>
+void S21WriteCsv(std::ostream &stream, const S21BasicMatrix<T> &matrix,
+                 char delimiter = ',');
+
+/**
+ * @brief Записывает плотную матрицу в Matrix Market (array real general),
+ * разреженную - в coordinate real general
+ *
+ * @throw std::runtime_error при ошибке записи в поток
+ */
+template <class T>
+void S21WriteMatrixMarket(std::ostream &stream,
+                          const S21BasicMatrixView<T> &view);
+template <class T>
+void S21WriteMatrixMarket(std::ostream &stream,
+                          const S21BasicMatrix<T> &matrix);
+template <class T>
+void S21WriteMatrixMarket(std::ostream &stream,
+                          const S21BasicSparseMatrix<T> &matrix);
+
+#define S21_DECLARE_INSTANTIATION(T)                                          \
+  extern template S21BasicMatrix<T> S21ReadCsv<T>(const std::string &, char); \
+  extern template S21BasicMatrix<T> S21ReadMatrixMarket<T>(                   \
+      const std::string &);                                                   \
+  extern template S21BasicSparseMatrix<T> S21ReadMatrixMarketSparse<T>(       \
+      const std::string &, S21SparseFormat);                                  \
+  extern template void S21WriteCsv(std::ostream &,                            \
+                                   const S21BasicMatrixView<T> &, char);      \
+  extern template void S21WriteCsv(std::ostream &,                            \
+                                   const S21BasicMatrix<T> &, char);          \
+  extern template void S21WriteMatrixMarket(std::ostream &,                   \
+                                            const S21BasicMatrixView<T> &);   \
+  extern template void S21WriteMatrixMarket(std::ostream &,                   \
+                                            const S21BasicMatrix<T> &);       \
+  extern template void S21WriteMatrixMarket(                                  \
+      std::ostream &, const S21BasicSparseMatrix<T> &);
+S21_REAL_ELEMENT_TYPES(S21_DECLARE_INSTANTIATION)
+#undef S21_DECLARE_INSTANTIATION
+
+#endif  // SRC_S21_MATRIX_TEXT_H
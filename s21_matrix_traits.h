@@ -0,0 +1,69 @@
+#ifndef SRC_S21_MATRIX_TRAITS_H
+#define SRC_S21_MATRIX_TRAITS_H
+
+#include <complex>
+
+/**
+ * @brief Свойства типа элементов матрицы
+ *
+ * @details Real - вещественный тип модуля элемента (std::abs), kEpsilon -
+ * точность поэлементного сравнения матриц, Conj - комплексное сопряжение
+ * (для вещественных типов - сам элемент, а не std::complex, как у
+ * std::conj). Точность выбрана по числу
+ * значащих цифр типа: для float сравнение с 1e-6 отвергало бы результаты,
+ * отличающиеся лишь ошибкой округления.
+ */
+template <class T>
+struct S21MatrixTraits;
+
+template <>
+struct S21MatrixTraits<float> {
+  typedef float Real;
+  static constexpr Real kEpsilon = 1.0e-4f;
+  static inline float Conj(float value) { return value; }
+};
+
+template <>
+struct S21MatrixTraits<double> {
+  typedef double Real;
+  static constexpr Real kEpsilon = 1.0e-6;
+  static inline double Conj(double value) { return value; }
+};
+
+template <>
+struct S21MatrixTraits<long double> {
+  typedef long double Real;
+  static constexpr Real kEpsilon = 1.0e-9L;
+  static inline long double Conj(long double value) { return value; }
+};
+
+template <>
+struct S21MatrixTraits<std::complex<double> > {
+  typedef double Real;
+  static constexpr Real kEpsilon = 1.0e-6;
+  static inline std::complex<double> Conj(std::complex<double> value) {
+    return std::conj(value);
+  }
+};
+
+/**
+ * @brief Применяет X(T) к каждому типу элементов, для которого собрана
+ * библиотека: по этому списку шаблоны явно инстанцируются в единицах
+ * трансляции, где определены их функции
+ */
+#define S21_ELEMENT_TYPES(X) \
+  X(float)                   \
+  X(double)                  \
+  X(long double)             \
+  X(std::complex<double>)
+
+/**
+ * @brief То же для вещественных типов: для них определены операции,
+ * которым нужен порядок или текстовое представление числа
+ */
+#define S21_REAL_ELEMENT_TYPES(X) \
+  X(float)                        \
+  X(double)                       \
+  X(long double)
+
+#endif  // SRC_S21_MATRIX_TRAITS_H
@@ -0,0 +1,123 @@
+#include "s21_matrix_transpose.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_traits.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+namespace detail {
+namespace {
+
+// Сторона блока: строка блока занимает одну кэш-линию (8 x 8 для double,
+// 16 x 16 для float), так что блок читается и записывается целыми
+// линиями. Более крупные блоки при шаге строки, кратном степени двойки,
+// вытесняют друг друга из L1
+template <class T>
+struct Tile {
+  static const int kSize = static_cast<int>(64 / sizeof(T));
+};
+
+template <class T>
+void TransposeTile(int rows, int cols, const T *src, std::ptrdiff_t src_s,
+                   T *dst, std::ptrdiff_t dst_s) {
+  for (int i = 0; i < rows; ++i) {
+    const T *src_row = src + i * src_s;
+    for (int j = 0; j < cols; ++j) {
+      dst[j * dst_s + i] = src_row[j];
+    }
+  }
+}
+
+template <class T>
+void SwapTiles(int rows, int cols, T *a, T *b, std::ptrdiff_t s) {
+  for (int i = 0; i < rows; ++i) {
+    T *a_row = a + i * s;
+    for (int j = 0; j < cols; ++j) {
+      std::swap(a_row[j], b[j * s + i]);
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+void Transpose(int rows, int cols, const T *src, std::ptrdiff_t src_s, T *dst,
+               std::ptrdiff_t dst_s) {
+  const int kTile = Tile<T>::kSize;
+  const int row_tiles = (rows + kTile - 1) / kTile;
+  const long long work = static_cast<long long>(rows) * cols;
+  ParallelFor(0, row_tiles, work, [&](int first, int last) {
+    for (int tile = first; tile < last; ++tile) {
+      const int i0 = tile * kTile;
+      const int ib = std::min(kTile, rows - i0);
+      for (int j0 = 0; j0 < cols; j0 += kTile) {
+        const int jb = std::min(kTile, cols - j0);
+        TransposeTile(ib, jb, src + i0 * src_s + j0, src_s,
+                      dst + j0 * dst_s + i0, dst_s);
+      }
+    }
+  });
+}
+
+template <class T>
+void TransposeSquareInPlace(T *a, int n, std::ptrdiff_t s) {
+  const int kTile = Tile<T>::kSize;
+  const int tiles = (n + kTile - 1) / kTile;
+  const long long work = static_cast<long long>(n) * n / 2;
+  ParallelFor(0, tiles, work, [&](int first, int last) {
+    for (int tile = first; tile < last; ++tile) {
+      const int i0 = tile * kTile;
+      const int ib = std::min(kTile, n - i0);
+      T *diagonal = a + i0 * s + i0;
+      for (int i = 0; i < ib; ++i) {
+        for (int j = i + 1; j < ib; ++j) {
+          std::swap(diagonal[i * s + j], diagonal[j * s + i]);
+        }
+      }
+      for (int j0 = i0 + kTile; j0 < n; j0 += kTile) {
+        const int jb = std::min(kTile, n - j0);
+        SwapTiles(ib, jb, a + i0 * s + j0, a + j0 * s + i0, s);
+      }
+    }
+  });
+}
+
+template <class T>
+void TransposeCompactInPlace(T *a, int rows, int cols) {
+  if (rows <= 1 || cols <= 1) {
+    return;
+  }
+  const std::size_t count = static_cast<std::size_t>(rows) * cols;
+  std::vector<std::uint64_t> visited((count + 63) / 64);
+  // Первый и последний элементы остаются на месте
+  for (std::size_t start = 1; start + 1 < count; ++start) {
+    if ((visited[start / 64] >> (start % 64)) & 1u) {
+      continue;
+    }
+    std::size_t k = start;
+    T value = a[start];
+    do {
+      const std::size_t i = k / cols;
+      const std::size_t j = k % cols;
+      k = j * rows + i;
+      visited[k / 64] |= std::uint64_t(1) << (k % 64);
+      std::swap(value, a[k]);
+    } while (k != start);
+  }
+}
+
+#define S21_INSTANTIATE(T)                                             \
+  template void Transpose<T>(int, int, const T *, std::ptrdiff_t, T *, \
+                             std::ptrdiff_t);                          \
+  template void TransposeSquareInPlace<T>(T *, int, std::ptrdiff_t);   \
+  template void TransposeCompactInPlace<T>(T *, int, int);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
+
+}  // namespace detail
+}  // namespace s21
@@ -0,0 +1,43 @@
+#ifndef SRC_S21_MATRIX_TRANSPOSE_H
+#define SRC_S21_MATRIX_TRANSPOSE_H
+
+#include <cstddef>
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Записывает в dst (cols x rows) транспонированную src (rows x cols)
+ *
+ * @details Матрица обходится квадратными блоками, строки которых
+ * занимают целые кэш-линии: и чтение, и запись идут целыми линиями, а не
+ * по одному элементу на строку назначения. Строки блоков распределяются
+ * между потоками. src и dst не должны пересекаться.
+ */
+template <class T>
+void Transpose(int rows, int cols, const T *src, std::ptrdiff_t src_s, T *dst,
+               std::ptrdiff_t dst_s);
+
+/**
+ * @brief Транспонирует квадратную матрицу n x n на месте
+ *
+ * @details Блок (I, J) меняется местами с транспонированным блоком (J, I).
+ */
+template <class T>
+void TransposeSquareInPlace(T *a, int n, std::ptrdiff_t s);
+
+/**
+ * @brief Транспонирует на месте плотно упакованную матрицу rows x cols
+ * (шаг строки равен cols), результат - плотно упакованная cols x rows
+ *
+ * @details Элемент с линейным индексом k = i * cols + j переходит в
+ * j * rows + i; перестановка обходится по циклам. Пройденные элементы
+ * отмечаются в битовой маске (1 бит на элемент).
+ */
+template <class T>
+void TransposeCompactInPlace(T *a, int rows, int cols);
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_MATRIX_TRANSPOSE_H
@@ -0,0 +1,225 @@
+#include "s21_matrix_update.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+/**
+ * @brief Запоминает матрицу и вычисляет её обратную
+ *
+ * @param matrix Квадратная невырожденная матрица
+ * @param drift_tolerance Наибольшее допустимое Drift(), после которого
+ * обратная матрица вычисляется заново
+ * @throw std::invalid_argument если матрица не квадратная или вырождена
+ * @details Для плохо обусловленной матрицы Drift() уже сразу после
+ * обращения порядка cond(A) * eps; если это больше drift_tolerance,
+ * обратная будет вычисляться заново после каждого обновления.
+ */
+template <class T>
+S21BasicCachedInverse<T>::S21BasicCachedInverse(
+    const S21BasicMatrix<T> &matrix, Real drift_tolerance)
+    : matrix_(matrix),
+      inverse_(),
+      tolerance_(drift_tolerance),
+      drift_(),
+      refactorizations_(0),
+      updates_(0),
+      generator_() {
+  if (!matrix.IsSquare()) {
+    throw std::invalid_argument("Cached inverse requires a square matrix.");
+  }
+  inverse_ = matrix_.InverseMatrix();
+  drift_ = MeasureDrift();
+}
+
+/**
+ * @brief A += U * V^T с пересчётом обратной матрицы
+ *
+ * @param u, v Матрицы Size() x k; k = 1 - формула Шермана - Моррисона
+ * @throw std::invalid_argument если u и v разной размерности или число их
+ * строк не совпадает с порядком матрицы; если A + U * V^T вырождена.
+ * Когда вырожденность обнаружена по матрице I + V^T * X * U порядка k,
+ * объект не изменяется; когда только при повторном обращении после
+ * проверки отклонения - Matrix() уже обновлена, а Drift() показывает,
+ * насколько неточна Inverse()
+ * @details O(n^2 * k) операций и O(n^2) на проверку отклонения.
+ */
+template <class T>
+void S21BasicCachedInverse<T>::Update(const S21BasicMatrix<T> &u,
+                                      const S21BasicMatrix<T> &v) {
+  CheckFactors(u, v);
+  if (u.Cols() == 0) {
+    return;
+  }
+  UpdateInverse(u, v);
+  S21Gemm(T(1), u, S21Transpose::kNoTrans, v, S21Transpose::kTrans, T(1),
+          &matrix_);
+  CheckDrift();
+}
+
+/**
+ * @brief Заменяет строку row матрицы
+ *
+ * @param values Матрица 1 x Size() с новыми элементами строки
+ * @throw std::out_of_range если row выходит за пределы матрицы
+ * @throw std::invalid_argument если values не 1 x Size() или матрица
+ * становится вырожденной (см. Update)
+ * @details Обновление ранга 1: U = e_row, V^T - разность новой и старой
+ * строки. Сама строка копируется точно, без накопления ошибок.
+ */
+template <class T>
+void S21BasicCachedInverse<T>::ReplaceRow(int row,
+                                          const S21BasicMatrix<T> &values) {
+  const int n = Size();
+  if (row < 0 || row >= n) {
+    throw std::out_of_range("Matrix index out of range.");
+  }
+  if (values.Rows() != 1 || values.Cols() != n) {
+    throw std::invalid_argument("Row must be a 1 x n matrix.");
+  }
+  S21BasicMatrix<T> u(n, 1), v(n, 1);
+  u(row, 0) = T(1);
+  for (int j = 0; j < n; ++j) {
+    v(j, 0) = values(0, j) - matrix_(row, j);
+  }
+  UpdateInverse(u, v);
+  std::copy(values.Data(), values.Data() + n,
+            matrix_.Data() + static_cast<std::size_t>(row) * matrix_.Stride());
+  CheckDrift();
+}
+
+/**
+ * @brief Заменяет столбец col матрицы
+ *
+ * @param values Матрица Size() x 1 с новыми элементами столбца
+ * @throw std::out_of_range если col выходит за пределы матрицы
+ * @throw std::invalid_argument если values не Size() x 1 или матрица
+ * становится вырожденной (см. Update)
+ * @details Обновление ранга 1: U - разность нового и старого столбца,
+ * V = e_col.
+ */
+template <class T>
+void S21BasicCachedInverse<T>::ReplaceColumn(
+    int col, const S21BasicMatrix<T> &values) {
+  const int n = Size();
+  if (col < 0 || col >= n) {
+    throw std::out_of_range("Matrix index out of range.");
+  }
+  if (values.Rows() != n || values.Cols() != 1) {
+    throw std::invalid_argument("Column must be an n x 1 matrix.");
+  }
+  S21BasicMatrix<T> u(n, 1), v(n, 1);
+  v(col, 0) = T(1);
+  for (int i = 0; i < n; ++i) {
+    u(i, 0) = values(i, 0) - matrix_(i, col);
+  }
+  UpdateInverse(u, v);
+  for (int i = 0; i < n; ++i) {
+    matrix_(i, col) = values(i, 0);
+  }
+  CheckDrift();
+}
+
+/**
+ * @brief Вычисляет обратную матрицу заново
+ *
+ * @throw std::invalid_argument если матрица вырождена; Inverse() тогда не
+ * изменяется
+ */
+template <class T>
+void S21BasicCachedInverse<T>::Refactorize() {
+  inverse_ = matrix_.InverseMatrix();
+  ++refactorizations_;
+  updates_ = 0;
+  drift_ = MeasureDrift();
+}
+
+/**
+ * @brief Решает систему A * X = rhs умножением на обратную матрицу
+ *
+ * @throw std::invalid_argument если число строк rhs не совпадает с
+ * порядком матрицы
+ * @details O(n^2) операций на столбец rhs.
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicCachedInverse<T>::Solve(
+    const S21BasicMatrix<T> &rhs) const {
+  if (rhs.Rows() != Size()) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  return inverse_ * rhs;
+}
+
+template <class T>
+void S21BasicCachedInverse<T>::CheckFactors(const S21BasicMatrix<T> &u,
+                                            const S21BasicMatrix<T> &v) const {
+  if (u.Rows() != Size() || v.Rows() != Size() || u.Cols() != v.Cols()) {
+    throw std::invalid_argument(
+        "Update factors must be n x k matrices of the same size.");
+  }
+}
+
+/**
+ * @details Поправка считается тремя произведениями GEMM: X * U, V^T * X и
+ * (X * U) * Z, где Z = inv(I + V^T * X * U) * (V^T * X) - решение системы
+ * порядка k. Если эта система вырождена, исключение выбрасывается до
+ * изменения X.
+ */
+template <class T>
+void S21BasicCachedInverse<T>::UpdateInverse(const S21BasicMatrix<T> &u,
+                                             const S21BasicMatrix<T> &v) {
+  const S21BasicMatrix<T> xu = inverse_ * u;
+  S21BasicMatrix<T> vx, capacitance;
+  S21Gemm(T(1), v, S21Transpose::kTrans, inverse_, S21Transpose::kNoTrans,
+          T(), &vx);
+  S21Gemm(T(1), v, S21Transpose::kTrans, xu, S21Transpose::kNoTrans, T(),
+          &capacitance);
+  for (int i = 0; i < capacitance.Rows(); ++i) {
+    capacitance(i, i) += T(1);
+  }
+  const S21BasicMatrix<T> z = capacitance.Solve(vx);
+  S21Gemm(T(-1), xu, S21Transpose::kNoTrans, z, S21Transpose::kNoTrans, T(1),
+          &inverse_);
+}
+
+template <class T>
+void S21BasicCachedInverse<T>::CheckDrift() {
+  ++updates_;
+  drift_ = MeasureDrift();
+  // NaN после почти вырожденного обновления тоже ведёт к пересчёту
+  if (!(drift_ <= tolerance_)) {
+    Refactorize();
+  }
+}
+
+/**
+ * @details Отклонение A * X от единичной матрицы оценивается по одному
+ * случайному вектору: два умножения матрицы на вектор. Вектор каждый раз
+ * новый, поэтому ошибка не может долго оставаться незамеченной из-за
+ * неудачного направления.
+ */
+template <class T>
+typename S21BasicCachedInverse<T>::Real
+S21BasicCachedInverse<T>::MeasureDrift() {
+  const int n = Size();
+  std::uniform_real_distribution<Real> distribution(Real(-1), Real(1));
+  S21BasicMatrix<T> probe(n, 1);
+  Real probe_norm = Real();
+  for (int i = 0; i < n; ++i) {
+    probe(i, 0) = T(distribution(generator_));
+    probe_norm = std::max(probe_norm, Real(std::abs(probe(i, 0))));
+  }
+  S21BasicMatrix<T> residual = matrix_ * (inverse_ * probe);
+  residual -= probe;
+  Real residual_norm = Real();
+  for (int i = 0; i < n; ++i) {
+    residual_norm = std::max(residual_norm, Real(std::abs(residual(i, 0))));
+  }
+  return residual_norm / probe_norm;
+}
+
+#define S21_INSTANTIATE(T) template class S21BasicCachedInverse<T>;
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
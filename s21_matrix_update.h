@@ -0,0 +1,75 @@
+#ifndef SRC_S21_MATRIX_UPDATE_H
+#define SRC_S21_MATRIX_UPDATE_H
+
+#include <random>
+
+#include "s21_matrix_oop.h"
+
+template <class T>
+class S21BasicCachedInverse;
+
+typedef S21BasicCachedInverse<double> S21CachedInverse;
+
+/**
+ * @brief Квадратная матрица вместе с обратной, которая пересчитывается
+ * при изменениях матрицы за O(n^2) операций
+ *
+ * @details Рассчитана на задачи, где матрица на каждом шаге меняется на
+ * произведение малого ранга: строку, столбец или U * V^T с k << n
+ * столбцами. Обратная обновляется по формуле Шермана - Моррисона -
+ * Вудбери
+ *
+ *     inv(A + U * V^T) = X - X * U * inv(I + V^T * X * U) * V^T * X,
+ *
+ * где X = inv(A): O(n^2 * k) операций вместо O(n^3) у InverseMatrix().
+ * Ошибки округления при этом накапливаются, поэтому после каждого
+ * обновления оценивается отклонение Drift() = ||A * (X * p) - p|| / ||p||
+ * (норма максимума) для случайного вектора p, тоже за O(n^2). Если оно
+ * больше DriftTolerance(), обратная матрица вычисляется заново.
+ */
+template <class T>
+class S21BasicCachedInverse {
+ public:
+  typedef T Scalar;
+  typedef typename S21MatrixTraits<T>::Real Real;
+
+  explicit S21BasicCachedInverse(
+      const S21BasicMatrix<T> &matrix,
+      Real drift_tolerance = S21MatrixTraits<T>::kEpsilon);
+
+  inline int Size() const { return matrix_.Rows(); }
+  inline const S21BasicMatrix<T> &Matrix() const { return matrix_; }
+  inline const S21BasicMatrix<T> &Inverse() const { return inverse_; }
+  inline Real Drift() const { return drift_; }
+  inline Real DriftTolerance() const { return tolerance_; }
+  inline int Refactorizations() const { return refactorizations_; }
+  inline int UpdatesSinceRefactorization() const { return updates_; }
+
+  void Update(const S21BasicMatrix<T> &u, const S21BasicMatrix<T> &v);
+  void ReplaceRow(int row, const S21BasicMatrix<T> &values);
+  void ReplaceColumn(int col, const S21BasicMatrix<T> &values);
+  void Refactorize();
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T> &rhs) const;
+
+ private:
+  void CheckFactors(const S21BasicMatrix<T> &u,
+                    const S21BasicMatrix<T> &v) const;
+  void UpdateInverse(const S21BasicMatrix<T> &u, const S21BasicMatrix<T> &v);
+  void CheckDrift();
+  Real MeasureDrift();
+
+  S21BasicMatrix<T> matrix_;
+  S21BasicMatrix<T> inverse_;
+  Real tolerance_;
+  Real drift_;
+  int refactorizations_;
+  int updates_;
+  std::minstd_rand generator_;
+};
+
+#define S21_DECLARE_INSTANTIATION(T) \
+  extern template class S21BasicCachedInverse<T>;
+S21_ELEMENT_TYPES(S21_DECLARE_INSTANTIATION)
+#undef S21_DECLARE_INSTANTIATION
+
+#endif  // SRC_S21_MATRIX_UPDATE_H
@@ -0,0 +1,481 @@
+#include "s21_matrix_oop.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <utility>
+
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_transpose.h"
+
+/**
+ * @brief Представление произвольной области памяти
+ *
+ * @param data Указатель на элемент (0, 0)
+ * @param row_stride Расстояние (в элементах) между соседними строками
+ * @param col_stride Расстояние (в элементах) между соседними столбцами
+ * @throw std::invalid_argument если размерность отрицательна
+ */
+template <class T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const T *data, int rows, int cols,
+                                          std::ptrdiff_t row_stride,
+                                          std::ptrdiff_t col_stride)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      row_stride_(row_stride),
+      col_stride_(col_stride) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Matrix dimensions must be positive.");
+  }
+}
+
+/**
+ * @brief Представление всей матрицы
+ */
+template <class T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const S21BasicMatrix<T> &matrix)
+    : data_(matrix.Data()),
+      rows_(matrix.Rows()),
+      cols_(matrix.Cols()),
+      row_stride_(matrix.Stride()),
+      col_stride_(1) {}
+
+template <class T>
+void S21BasicMatrixView<T>::CheckIndex(int row, int col) const {
+  if (data_ == nullptr || row < 0 || row >= Rows() || col < 0 ||
+      col >= Cols()) {
+    throw std::out_of_range(
+        "Matrix index out of range or matrix not allocated.");
+  }
+}
+
+/**
+ * @brief Элемент представления с проверкой индексов
+ *
+ * @throw std::out_of_range если индекс выходит за границы
+ */
+template <class T>
+const T &S21BasicMatrixView<T>::operator()(int row, int col) const {
+  CheckIndex(row, col);
+  return data_[row * row_stride_ + col * col_stride_];
+}
+
+/**
+ * @brief Транспонированное представление: шаги строки и столбца
+ * меняются местами, элементы не копируются
+ */
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Transpose() const {
+  return S21BasicMatrixView(data_, cols_, rows_, col_stride_, row_stride_);
+}
+
+/**
+ * @brief Блок rows x cols с левым верхним углом в (row, col)
+ *
+ * @throw std::out_of_range если блок выходит за границы представления
+ */
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Block(int row, int col, int rows,
+                                                   int cols) const {
+  return Slice(row, col, rows, cols, 1, 1);
+}
+
+/**
+ * @brief Прореженное представление: элемент (i, j) результата - это
+ * элемент (row + i * row_step, col + j * col_step) исходного
+ *
+ * @throw std::out_of_range если шаг не положителен или срез выходит за
+ * границы представления
+ */
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Slice(int row, int col, int rows,
+                                                   int cols, int row_step,
+                                                   int col_step) const {
+  if (row_step < 1 || col_step < 1 || rows < 0 || cols < 0 || row < 0 ||
+      col < 0 || (rows > 0 && row + (rows - 1LL) * row_step >= Rows()) ||
+      (cols > 0 && col + (cols - 1LL) * col_step >= Cols())) {
+    throw std::out_of_range("Matrix slice out of range.");
+  }
+  if (rows == 0 || cols == 0) {
+    return S21BasicMatrixView(nullptr, rows, cols, 0, 0);
+  }
+  return S21BasicMatrixView(data_ + row * row_stride_ + col * col_stride_,
+                            rows, cols, row_stride_ * row_step,
+                            col_stride_ * col_step);
+}
+
+/**
+ * @brief Поэлементное сравнение с точностью S21BasicMatrix<T>::kEpsilon
+ *
+ * @details Строки с единичным шагом столбца сравниваются векторными
+ * ядрами.
+ */
+template <class T>
+bool S21BasicMatrixView<T>::EqMatrix(const S21BasicMatrixView &other) const {
+  const typename S21BasicMatrix<T>::Real epsilon =
+      S21BasicMatrix<T>::kEpsilon;
+  if (Rows() != other.Rows() || Cols() != other.Cols()) {
+    return false;
+  }
+  if (Rows() == 0 || Cols() == 0) {
+    return true;
+  }
+  const s21::detail::ElementwiseKernels<T> &kernels =
+      s21::detail::Kernels<T>();
+  const bool contiguous = ColStride() == 1 && other.ColStride() == 1;
+  std::atomic<bool> equal(true);
+  s21::detail::ParallelFor(
+      0, Rows(), static_cast<long long>(Rows()) * Cols(),
+      [&](int first, int last) {
+        for (int i = first; i < last && equal.load(std::memory_order_relaxed);
+             ++i) {
+          bool row_equal = true;
+          if (contiguous) {
+            row_equal = kernels.equal(data_ + i * row_stride_,
+                                      other.data_ + i * other.row_stride_,
+                                      Cols(), epsilon);
+          } else {
+            for (int j = 0; j < Cols() && row_equal; ++j) {
+              row_equal = std::abs(Coeff(i, j) - other.Coeff(i, j)) <= epsilon;
+            }
+          }
+          if (!row_equal) {
+            equal.store(false, std::memory_order_relaxed);
+          }
+        }
+      });
+  return equal.load();
+}
+
+/**
+ * @brief Определитель матриц порядка не выше 3 по явным формулам
+ */
+template <class T>
+T S21BasicMatrixView<T>::DetSmall() const {
+  const S21BasicMatrixView &m = *this;
+  switch (Rows()) {
+    case 1:
+      return m.At(0, 0);
+    case 2:
+      return m.At(0, 0) * m.At(1, 1) - m.At(0, 1) * m.At(1, 0);
+    case 3:
+      return m.At(0, 0) * (m.At(1, 1) * m.At(2, 2) - m.At(1, 2) * m.At(2, 1)) -
+             m.At(0, 1) * (m.At(1, 0) * m.At(2, 2) - m.At(1, 2) * m.At(2, 0)) +
+             m.At(0, 2) * (m.At(1, 0) * m.At(2, 1) - m.At(1, 1) * m.At(2, 0));
+    default:
+      return T();
+  }
+}
+
+/**
+ * @brief Определитель
+ *
+ * @details Для порядка не выше 3 используются явные формулы прямо над
+ * памятью источника, для больших матриц - LU-разложение.
+ * @throw std::invalid_argument если представление не квадратное
+ */
+template <class T>
+T S21BasicMatrixView<T>::Determinant() const {
+  if (!IsSquare()) {
+    throw std::invalid_argument(
+        "Determinant is only defined for square matrices.");
+  }
+  if (Rows() <= 3) {
+    return DetSmall();
+  }
+  if (s21::detail::IsHermitian(data_, Rows(), row_stride_, col_stride_)) {
+    const S21BasicCholesky<T> cholesky(*this);
+    if (cholesky.IsPositiveDefinite()) {
+      return cholesky.Determinant();
+    }
+  }
+  return LU().Determinant();
+}
+
+/**
+ * @brief LU-разложение
+ *
+ * @throw std::invalid_argument если представление не квадратное
+ */
+template <class T>
+S21BasicLU<T> S21BasicMatrixView<T>::LU() const {
+  return S21BasicLU<T>(*this);
+}
+
+namespace {
+
+/**
+ * @brief Копирует элементы представления в матрицу той же размерности
+ *
+ * @details Строки с единичным шагом столбца копируются целиком,
+ * транспонированное представление плотной матрицы копируется блочным
+ * транспонированием.
+ */
+template <class T>
+void CopyView(const S21BasicMatrixView<T> &view, S21BasicMatrix<T> *matrix) {
+  T *data = matrix->Data();
+  const std::size_t stride = matrix->Stride();
+  if (view.ColStride() == 1) {
+    for (int i = 0; i < view.Rows(); ++i) {
+      const T *src = view.Data() + i * view.RowStride();
+      std::copy(src, src + view.Cols(), data + i * stride);
+    }
+  } else if (view.RowStride() == 1) {
+    s21::detail::Transpose(view.Cols(), view.Rows(), view.Data(),
+                           view.ColStride(), data, matrix->Stride());
+  } else {
+    const long long work = static_cast<long long>(view.Rows()) * view.Cols();
+    s21::detail::ParallelFor(0, view.Rows(), work, [&](int first, int last) {
+      for (int i = first; i < last; ++i) {
+        for (int j = 0; j < view.Cols(); ++j) {
+          data[i * stride + j] = view.Coeff(i, j);
+        }
+      }
+    });
+  }
+}
+
+}  // namespace
+
+/**
+ * @brief Обратная матрица
+ *
+ * @details Элементы копируются один раз - в буфер результата, где
+ * матрица раскладывается (LU-разложение с частичным выбором ведущего
+ * элемента) и затем обращается на месте. Кроме результата выделяются
+ * только массивы перестановок и рабочий столбец размера n. Симметричная
+ * (эрмитова) матрица сначала раскладывается по Холецкому, что вдвое
+ * дешевле; если она не положительно определена, элементы копируются
+ * заново в тот же буфер и обращаются через LU.
+ * @throw std::invalid_argument если матрица не квадратная или вырождена
+ * (модуль ведущего элемента не превосходит n * eps * max|a_ij|)
+ */
+template <class T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::InverseMatrix() const {
+  if (!IsSquare()) {
+    throw std::invalid_argument(
+        "Determinant is only defined for square matrices.");
+  }
+
+  const int n = Rows();
+  if (n == 0) {
+    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+  }
+  S21BasicMatrix<T> result(*this);
+  if (s21::detail::IsHermitian(data_, n, row_stride_, col_stride_)) {
+    if (s21::detail::CholeskyFactor(
+            result.Data(), n, result.Stride(),
+            s21::detail::CholeskyTolerance(result.Data(), n,
+                                           result.Stride()))) {
+      s21::detail::CholeskyInvert(result.Data(), n, result.Stride());
+      return result;
+    }
+    CopyView(*this, &result);
+  }
+  const typename S21MatrixTraits<T>::Real tolerance =
+      s21::detail::LuTolerance(result.Data(), n, result.Stride());
+  std::vector<int> pivots(n);
+  s21::detail::LuFactor(result.Data(), n, result.Stride(), pivots.data());
+  if (s21::detail::LuIsSingular(result.Data(), n, result.Stride(),
+                                tolerance)) {
+    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+  }
+
+  std::vector<T> work(n);
+  s21::detail::LuInvert(result.Data(), n, result.Stride(), pivots.data(),
+                        work.data());
+  return result;
+}
+
+/**
+ * @brief Копирует представление в новую матрицу
+ */
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrixView<T> &view)
+    : S21BasicMatrix(view.Rows(), view.Cols()) {
+  if (data_ != nullptr) {
+    CopyView(view, this);
+  }
+}
+
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() const {
+  return S21BasicMatrixView<T>(*this);
+}
+
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::TransposedView() const {
+  return View().Transpose();
+}
+
+/**
+ * @brief Представление блока rows x cols с левым верхним углом (row, col)
+ *
+ * @throw std::out_of_range если блок выходит за границы матрицы
+ */
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                               int cols) const {
+  return View().Block(row, col, rows, cols);
+}
+
+/**
+ * @brief Представление каждой row_step-й строки и col_step-го столбца
+ *
+ * @throw std::out_of_range если шаг не положителен или срез выходит за
+ * границы матрицы
+ */
+template <class T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Slice(int row, int col, int rows,
+                                               int cols, int row_step,
+                                               int col_step) const {
+  return View().Slice(row, col, rows, cols, row_step, col_step);
+}
+
+template <class T>
+bool operator==(const S21BasicMatrixView<T> &lhs,
+                const S21BasicMatrixView<T> &rhs) {
+  return lhs.EqMatrix(rhs);
+}
+
+template <class T>
+bool operator==(const S21BasicMatrix<T> &lhs,
+                const S21BasicMatrixView<T> &rhs) {
+  return lhs.View().EqMatrix(rhs);
+}
+
+template <class T>
+bool operator==(const S21BasicMatrixView<T> &lhs,
+                const S21BasicMatrix<T> &rhs) {
+  return lhs.EqMatrix(rhs.View());
+}
+
+/**
+ * @brief Произведение представлений: шаги передаются ядру GEMM, которое
+ * само упаковывает блоки операндов
+ *
+ * @throw std::invalid_argument если число столбцов lhs не равно числу
+ * строк rhs
+ */
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &lhs,
+                            const S21BasicMatrixView<T> &rhs) {
+  if (lhs.Cols() != rhs.Rows()) {
+    throw std::invalid_argument(
+        "Matrices must have compatible dimensions for multiplication.");
+  }
+
+  S21BasicMatrix<T> result(lhs.Rows(), rhs.Cols());
+  if (result.Data() != nullptr && lhs.Cols() > 0) {
+    s21::detail::Gemm(lhs.Rows(), rhs.Cols(), lhs.Cols(), T(1), lhs.Data(),
+                      lhs.RowStride(), lhs.ColStride(), rhs.Data(),
+                      rhs.RowStride(), rhs.ColStride(), T(), result.Data(),
+                      result.Stride());
+  }
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &lhs,
+                            const S21BasicMatrixView<T> &rhs) {
+  return lhs.View() * rhs;
+}
+
+template <class T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  return lhs * rhs.View();
+}
+
+template <class T>
+bool S21BasicMatrixView<T>::Overlaps(const S21BasicMatrix<T> &matrix) const {
+  if (Rows() == 0 || Cols() == 0 || matrix.Data() == nullptr) {
+    return false;
+  }
+  const std::ptrdiff_t row_span = (Rows() - 1) * RowStride();
+  const std::ptrdiff_t col_span = (Cols() - 1) * ColStride();
+  const T *first = Data() + std::min<std::ptrdiff_t>(row_span, 0) +
+                   std::min<std::ptrdiff_t>(col_span, 0);
+  const T *last = Data() + std::max<std::ptrdiff_t>(row_span, 0) +
+                  std::max<std::ptrdiff_t>(col_span, 0);
+  const T *begin = matrix.Data();
+  const T *end = begin +
+                 static_cast<std::ptrdiff_t>(matrix.Rows() - 1) *
+                     matrix.Stride() +
+                 matrix.Cols();
+  return std::less<const T *>()(first, end) &&
+         !std::less<const T *>()(last, begin);
+}
+
+/**
+ * @details Пересечение C с операндами проверяется до перевыделения C:
+ * иначе представления A и B указывали бы на освобождённую память.
+ */
+template <class T>
+void S21Gemm(T alpha, const S21BasicMatrixView<T> &a, S21Transpose trans_a,
+             const S21BasicMatrixView<T> &b, S21Transpose trans_b, T beta,
+             S21BasicMatrix<T> *c) {
+  const S21BasicMatrixView<T> op_a =
+      trans_a == S21Transpose::kTrans ? a.Transpose() : a;
+  const S21BasicMatrixView<T> op_b =
+      trans_b == S21Transpose::kTrans ? b.Transpose() : b;
+  if (op_a.Cols() != op_b.Rows()) {
+    throw std::invalid_argument(
+        "Matrices must have compatible dimensions for multiplication.");
+  }
+  const int m = op_a.Rows(), n = op_b.Cols(), k = op_a.Cols();
+  const bool resize = c->Rows() != m || c->Cols() != n;
+  if (resize && beta != T()) {
+    throw std::invalid_argument(
+        "Accumulator must have the dimensions of the product.");
+  }
+  const bool aliased = op_a.Overlaps(*c) || op_b.Overlaps(*c);
+  S21BasicMatrix<T> result;
+  if (aliased) {
+    result = beta == T() ? S21BasicMatrix<T>(m, n) : *c;
+  } else if (resize) {
+    *c = S21BasicMatrix<T>(m, n);
+  }
+  S21BasicMatrix<T> *dst = aliased ? &result : c;
+  if (dst->Data() != nullptr) {
+    s21::detail::Gemm(m, n, k, alpha, op_a.Data(), op_a.RowStride(),
+                      op_a.ColStride(), op_b.Data(), op_b.RowStride(),
+                      op_b.ColStride(), beta, dst->Data(), dst->Stride());
+  }
+  if (aliased) {
+    *c = std::move(result);
+  }
+}
+
+#define S21_INSTANTIATE(T)                                                    \
+  template class S21BasicMatrixView<T>;                                       \
+  template S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrixView<T> &);  \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::View() const;             \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::TransposedView() const;   \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int, int, int, int) \
+      const;                                                                  \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::Slice(                    \
+      int, int, int, int, int, int) const;                                    \
+  template bool operator==(const S21BasicMatrixView<T> &,                     \
+                           const S21BasicMatrixView<T> &);                    \
+  template bool operator==(const S21BasicMatrix<T> &,                         \
+                           const S21BasicMatrixView<T> &);                    \
+  template bool operator==(const S21BasicMatrixView<T> &,                     \
+                           const S21BasicMatrix<T> &);                        \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &,         \
+                                       const S21BasicMatrixView<T> &);        \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &,             \
+                                       const S21BasicMatrixView<T> &);        \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &,         \
+                                       const S21BasicMatrix<T> &);            \
+  template void S21Gemm(T, const S21BasicMatrixView<T> &, S21Transpose,       \
+                        const S21BasicMatrixView<T> &, S21Transpose, T,       \
+                        S21BasicMatrix<T> *);
+S21_ELEMENT_TYPES(S21_INSTANTIATE)
+#undef S21_INSTANTIATE
@@ -0,0 +1,213 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+// Объём работы, начиная с которого операция делится между потоками
+const long long kDefaultParallelThreshold = 100000;
+// Число частей на поток: мелкие части выравнивают нагрузку
+const int kChunksPerThread = 4;
+
+thread_local bool t_in_parallel = false;
+
+std::mutex g_pool_mutex;
+std::shared_ptr<S21ThreadPool> g_pool;
+int g_thread_count = 0;
+std::atomic<long long> g_threshold(kDefaultParallelThreshold);
+
+int DefaultThreadCount() {
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware == 0 ? 1 : static_cast<int>(hardware);
+}
+
+std::shared_ptr<S21ThreadPool> GlobalPool() {
+  std::lock_guard<std::mutex> lock(g_pool_mutex);
+  if (!g_pool) {
+    if (g_thread_count == 0) {
+      g_thread_count = DefaultThreadCount();
+    }
+    g_pool = std::make_shared<S21ThreadPool>(g_thread_count);
+  }
+  return g_pool;
+}
+}  // namespace
+
+/**
+ * @brief Создаёт пул из threads потоков (включая вызывающий)
+ */
+S21ThreadPool::S21ThreadPool(int threads)
+    : body_(nullptr),
+      end_(0),
+      chunk_(1),
+      next_(0),
+      active_(0),
+      generation_(0),
+      stop_(false) {
+  for (int i = 1; i < threads; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this);
+  }
+}
+
+S21ThreadPool::~S21ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_ready_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+void S21ThreadPool::WorkerLoop() {
+  t_in_parallel = true;
+  unsigned long seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_ready_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+    }
+    RunChunks();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--active_ == 0) {
+        job_done_.notify_one();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Забирает части текущей задачи, пока они не закончатся
+ *
+ * @details После первого исключения оставшиеся части пропускаются, а
+ * исключение передаётся в вызывающий поток.
+ */
+void S21ThreadPool::RunChunks() {
+  for (;;) {
+    const int first = next_.fetch_add(chunk_);
+    if (first >= end_) {
+      return;
+    }
+    try {
+      (*body_)(first, std::min(end_, first + chunk_));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      next_.store(end_);
+    }
+  }
+}
+
+/**
+ * @brief Выполняет body(first, last) над частями [begin, end) не короче grain
+ * и возвращает управление, когда все части выполнены
+ *
+ * @throw Первое исключение, выброшенное body
+ */
+void S21ThreadPool::ParallelFor(int begin, int end, int grain,
+                                const std::function<void(int, int)> &body) {
+  if (begin >= end) {
+    return;
+  }
+  grain = std::max(grain, 1);
+  // Вложенный вызов из тела на том же потоке не должен трогать run_mutex_:
+  // поток уже может его держать
+  if (workers_.empty() || t_in_parallel || end - begin <= grain) {
+    body(begin, end);
+    return;
+  }
+  std::unique_lock<std::mutex> run(run_mutex_, std::try_to_lock);
+  if (!run.owns_lock()) {
+    body(begin, end);
+    return;
+  }
+
+  const int parts = Size() * kChunksPerThread;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    end_ = end;
+    chunk_ = std::max(grain, (end - begin + parts - 1) / parts);
+    next_.store(begin);
+    active_ = static_cast<int>(workers_.size());
+    error_ = nullptr;
+    ++generation_;
+  }
+  job_ready_.notify_all();
+
+  t_in_parallel = true;
+  RunChunks();
+  t_in_parallel = false;
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_done_.wait(lock, [&] { return active_ == 0; });
+    body_ = nullptr;
+    error = error_;
+    error_ = nullptr;
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Число потоков, между которыми делятся крупные операции
+ */
+int S21GetThreadCount() {
+  std::lock_guard<std::mutex> lock(g_pool_mutex);
+  return g_thread_count == 0 ? DefaultThreadCount() : g_thread_count;
+}
+
+/**
+ * @brief Задаёт число потоков; 0 - по числу аппаратных потоков
+ *
+ * @details Пул пересоздаётся при следующей параллельной операции. Операции,
+ * уже запущенные в старом пуле, завершаются в нём.
+ */
+void S21SetThreadCount(int threads) {
+  std::lock_guard<std::mutex> lock(g_pool_mutex);
+  g_thread_count = threads > 0 ? threads : DefaultThreadCount();
+  g_pool.reset();
+}
+
+/**
+ * @brief Объём работы (число операций), меньше которого операция
+ * выполняется в одном потоке
+ */
+long long S21GetParallelThreshold() { return g_threshold.load(); }
+
+void S21SetParallelThreshold(long long work) {
+  g_threshold.store(std::max(work, 0LL));
+}
+
+namespace s21 {
+namespace detail {
+
+void ParallelFor(int begin, int end, long long work,
+                 const std::function<void(int, int)> &body) {
+  if (begin >= end) {
+    return;
+  }
+  if (work < g_threshold.load() || t_in_parallel) {
+    body(begin, end);
+    return;
+  }
+  const std::shared_ptr<S21ThreadPool> pool = GlobalPool();
+  const long long per_item = std::max(work / (end - begin), 1LL);
+  const long long grain = (g_threshold.load() + per_item - 1) / per_item;
+  pool->ParallelFor(begin, end, static_cast<int>(std::min(grain, 1LL << 30)),
+                    body);
+}
+
+}  // namespace detail
+}  // namespace s21
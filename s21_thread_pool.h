@@ -0,0 +1,71 @@
+#ifndef SRC_S21_THREAD_POOL_H
+#define SRC_S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Пул потоков для параллельного выполнения операций над матрицами
+ *
+ * @details Пул из N потоков держит N - 1 рабочих потоков, N-м работает
+ * вызывающий поток. Одновременно выполняется одна задача ParallelFor:
+ * вложенные вызовы и вызовы из других потоков, пока пул занят, выполняются
+ * последовательно в вызывающем потоке.
+ */
+class S21ThreadPool {
+ public:
+  explicit S21ThreadPool(int threads);
+  ~S21ThreadPool();
+  S21ThreadPool(const S21ThreadPool &) = delete;
+  S21ThreadPool &operator=(const S21ThreadPool &) = delete;
+
+  inline int Size() const { return static_cast<int>(workers_.size()) + 1; }
+  void ParallelFor(int begin, int end, int grain,
+                   const std::function<void(int, int)> &body);
+
+ private:
+  void WorkerLoop();
+  void RunChunks();
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable job_ready_;
+  std::condition_variable job_done_;
+  const std::function<void(int, int)> *body_;
+  int end_;
+  int chunk_;
+  std::atomic<int> next_;
+  int active_;
+  unsigned long generation_;
+  bool stop_;
+  std::exception_ptr error_;
+};
+
+int S21GetThreadCount();
+void S21SetThreadCount(int threads);
+long long S21GetParallelThreshold();
+void S21SetParallelThreshold(long long work);
+
+namespace s21 {
+namespace detail {
+
+/**
+ * @brief Выполняет body(first, last) над непересекающимися частями
+ * [begin, end) в общем пуле потоков
+ *
+ * @param work Оценка объёма работы (число операций); если она меньше
+ * S21GetParallelThreshold(), body вызывается один раз в текущем потоке
+ */
+void ParallelFor(int begin, int end, long long work,
+                 const std::function<void(int, int)> &body);
+
+}  // namespace detail
+}  // namespace s21
+
+#endif  // SRC_S21_THREAD_POOL_H
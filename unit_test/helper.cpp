@@ -33,3 +33,29 @@ void check_zero_values(int i, int j) {
     }
   }
 }
+
+void fill_uniform(S21Matrix& matrix) {
+  for (int i = 0; i < matrix.Rows(); ++i) {
+    for (int j = 0; j < matrix.Cols(); ++j) {
+      matrix(i, j) = 2.0 * random() / RAND_MAX - 1.0;
+    }
+  }
+}
+
+S21Matrix uniform_matrix(int rows, int cols) {
+  S21Matrix matrix(rows, cols);
+  fill_uniform(matrix);
+  return matrix;
+}
+
+S21Matrix naive_multiply(const S21Matrix& a, const S21Matrix& b) {
+  S21Matrix result(a.Rows(), b.Cols());
+  for (int i = 0; i < a.Rows(); ++i) {
+    for (int j = 0; j < b.Cols(); ++j) {
+      for (int k = 0; k < a.Cols(); ++k) {
+        result(i, j) += a(i, k) * b(k, j);
+      }
+    }
+  }
+  return result;
+}
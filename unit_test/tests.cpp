@@ -1,8 +1,18 @@
 #include "tests.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -534,6 +544,2100 @@ TEST(S21MatrixTest, Inverse5) {
   TestMethodOperationFailure<std::invalid_argument>(
       A, [](const S21Matrix& a) { return a.InverseMatrix(); });
 }
+TEST(S21MatrixTest, Storage) {
+  double dataA[] = {1, 2, 3, 4, 5, 6};
+  S21Matrix A(2, 3, dataA);
+  ASSERT_NE(A.Data(), nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(A.Data()) % S21Matrix::kAlignment,
+            0u);
+  EXPECT_GE(A.Stride(), A.Cols());
+  for (int i = 0; i < A.Rows(); ++i) {
+    for (int j = 0; j < A.Cols(); ++j) {
+      EXPECT_EQ(A.Data()[i * A.Stride() + j], dataA[i * A.Cols() + j]);
+      EXPECT_EQ(&A(i, j), A.Data() + i * A.Stride() + j);
+    }
+  }
+
+  S21Matrix empty;
+  EXPECT_EQ(empty.Data(), nullptr);
+  S21Matrix moved = std::move(A);
+  EXPECT_EQ(A.Data(), nullptr);
+  EXPECT_EQ(moved(1, 2), 6);
+}
+TEST(S21MatrixTest, MulMatrixBlocked) {
+  const int shapes[][3] = {{1, 1, 1},    {2, 300, 3},   {33, 33, 33},
+                           {64, 64, 64}, {130, 257, 9}, {5, 600, 200},
+                           {150, 70, 131}};
+  for (const auto& shape : shapes) {
+    S21Matrix A(shape[0], shape[1]);
+    S21Matrix B(shape[1], shape[2]);
+    fill_uniform(A);
+    fill_uniform(B);
+    const S21Matrix expected = naive_multiply(A, B);
+    EXPECT_EQ(A * B, expected);
+    S21Matrix C = A;
+    C *= B;
+    EXPECT_EQ(C, expected);
+  }
+}
+TEST(S21MatrixTest, LU) {
+  const int sizes[] = {1, 4, 7, 65, 150};
+  for (int n : sizes) {
+    S21Matrix A(n, n);
+    fill_uniform(A);
+    const S21LU lu = A.LU();
+    ASSERT_FALSE(lu.IsSingular());
+    S21Matrix L(n, n);
+    S21Matrix U(n, n);
+    S21Matrix PA(n, n);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        if (i > j) {
+          L(i, j) = lu.Factors()(i, j);
+        } else {
+          U(i, j) = lu.Factors()(i, j);
+        }
+        PA(i, j) = A(lu.Permutation()[i], j);
+      }
+      L(i, i) = 1.0;
+    }
+    EXPECT_EQ(L * U, PA);
+  }
+  ASSERT_THROW(S21Matrix(2, 3).LU(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, LUSolve) {
+  const int n = 90;
+  S21Matrix A(n, n);
+  S21Matrix B(n, 3);
+  fill_uniform(A);
+  fill_uniform(B);
+  const S21LU lu = A.LU();
+  EXPECT_EQ(A * lu.Solve(B), B);
+  S21Matrix b(n, 1);
+  fill_uniform(b);
+  EXPECT_EQ(A * lu.Solve(b), b);
+  ASSERT_THROW(lu.Solve(S21Matrix(n + 1, 1)), std::invalid_argument);
+
+  double dataS[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  const S21LU singular = S21Matrix(4, 4, dataS).LU();
+  EXPECT_TRUE(singular.IsSingular() ||
+              std::fabs(singular.Determinant()) < S21Matrix::kEpsilon);
+}
+
+TEST(S21MatrixTest, DeterminantLarge) {
+  // det(A * B) = det(A) * det(B) для хорошо обусловленных A = I + R / n
+  const int n = 120;
+  S21Matrix A(n, n);
+  S21Matrix B(n, n);
+  fill_uniform(A);
+  fill_uniform(B);
+  A *= 1.0 / n;
+  B *= 1.0 / n;
+  for (int i = 0; i < n; ++i) {
+    A(i, i) += 1.0;
+    B(i, i) -= 1.0;
+  }
+  const double expected = A.Determinant() * B.Determinant();
+  const double det = (A * B).Determinant();
+  EXPECT_LT(std::fabs(det - expected), 1e-10 * std::fabs(expected));
+}
+TEST(S21MatrixTest, InverseLarge) {
+  const int sizes[] = {5, 64, 100, 131};
+  for (int n : sizes) {
+    S21Matrix A(n, n);
+    fill_uniform(A);
+    S21Matrix identity(n, n);
+    for (int i = 0; i < n; ++i) {
+      identity(i, i) = 1.0;
+    }
+    const S21Matrix inverse = A.InverseMatrix();
+    EXPECT_EQ(A * inverse, identity);
+    EXPECT_EQ(inverse * A, identity);
+  }
+}
+TEST(S21MatrixTest, InverseSingular) {
+  double dataA[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  TestMethodOperationFailure<std::invalid_argument>(
+      S21Matrix(4, 4, dataA),
+      [](const S21Matrix& a) { return a.InverseMatrix(); });
+  TestMethodOperationFailure<std::invalid_argument>(
+      S21Matrix(3, 3), [](const S21Matrix& a) { return a.InverseMatrix(); });
+
+  double dataB[] = {1e-200, 0, 0, 2e-200};
+  const S21Matrix inverse = S21Matrix(2, 2, dataB).InverseMatrix();
+  EXPECT_LT(std::fabs(inverse(0, 0) * 1e-200 - 1.0), 1e-12);
+  EXPECT_LT(std::fabs(inverse(1, 1) * 2e-200 - 1.0), 1e-12);
+}
+TEST(S21MatrixTest, Solve) {
+  const int n = 70;
+  S21Matrix A(n, n);
+  S21Matrix B(n, 4);
+  fill_uniform(A);
+  fill_uniform(B);
+  for (int i = 0; i < n; ++i) {
+    A(i, i) += 4.0;
+  }
+  EXPECT_EQ(A.DetectStructure(), S21MatrixStructure::kGeneral);
+  EXPECT_EQ(A * A.Solve(B), B);
+
+  S21Matrix lower = A;
+  S21Matrix upper = A;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      (i < j ? lower : upper)(i, j) = (i == j) ? A(i, j) : 0.0;
+    }
+  }
+  EXPECT_EQ(lower.DetectStructure(), S21MatrixStructure::kLowerTriangular);
+  EXPECT_EQ(upper.DetectStructure(), S21MatrixStructure::kUpperTriangular);
+  EXPECT_EQ(lower * lower.Solve(B), B);
+  EXPECT_EQ(upper * upper.Solve(B), B);
+  EXPECT_EQ(lower * A.Solve(B, S21MatrixStructure::kLowerTriangular), B);
+  EXPECT_EQ(upper * A.Solve(B, S21MatrixStructure::kUpperTriangular), B);
+  EXPECT_EQ(A.Solve(B, S21MatrixStructure::kGeneral), A.Solve(B));
+
+  ASSERT_THROW(A.Solve(S21Matrix(n - 1, 1)), std::invalid_argument);
+  ASSERT_THROW(S21Matrix(2, 3).Solve(S21Matrix(2, 1)), std::invalid_argument);
+  upper(n / 2, n / 2) = 0.0;
+  ASSERT_THROW(upper.Solve(B), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, SolveTriangularIgnoresOtherTriangle) {
+  const int n = 40;
+  S21Matrix A(n, n);
+  S21Matrix B(n, 3);
+  fill_uniform(A);
+  fill_uniform(B);
+  S21Matrix lower = A;
+  S21Matrix upper = A;
+  for (int i = 0; i < n; ++i) {
+    A(i, i) += 4.0;
+    lower(i, i) = upper(i, i) = A(i, i);
+    for (int j = 0; j < n; ++j) {
+      if (i < j) {
+        A(i, j) = 1e20;
+        lower(i, j) = 0.0;
+      } else if (i > j) {
+        upper(i, j) = 0.0;
+      }
+    }
+  }
+  EXPECT_EQ(lower * A.Solve(B, S21MatrixStructure::kLowerTriangular), B);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < i; ++j) {
+      A(i, j) = 1e20;
+    }
+    for (int j = i + 1; j < n; ++j) {
+      A(i, j) = upper(i, j);
+    }
+  }
+  EXPECT_EQ(upper * A.Solve(B, S21MatrixStructure::kUpperTriangular), B);
+}
+
+TEST(S21MatrixTest, SolveEmptyTriangular) {
+  const S21Matrix empty;
+  const S21Matrix rhs(0, 3);
+  for (S21MatrixStructure structure :
+       {S21MatrixStructure::kAuto, S21MatrixStructure::kGeneral,
+        S21MatrixStructure::kLowerTriangular,
+        S21MatrixStructure::kUpperTriangular}) {
+    const S21Matrix x = empty.Solve(rhs, structure);
+    EXPECT_EQ(x.Rows(), 0);
+    EXPECT_EQ(x.Cols(), 3);
+  }
+}
+
+TEST(S21MatrixTest, DetectStructureNonSquare) {
+  EXPECT_EQ(S21Matrix(40, 2).DetectStructure(),
+            S21MatrixStructure::kUpperTriangular);
+  S21Matrix tall(40, 2);
+  tall(5, 1) = 1.0;
+  EXPECT_EQ(tall.DetectStructure(), S21MatrixStructure::kLowerTriangular);
+  tall(0, 1) = 1.0;
+  EXPECT_EQ(tall.DetectStructure(), S21MatrixStructure::kGeneral);
+  S21Matrix wide(2, 40);
+  wide(0, 30) = 1.0;
+  EXPECT_EQ(wide.DetectStructure(), S21MatrixStructure::kUpperTriangular);
+  wide(1, 0) = 1.0;
+  EXPECT_EQ(wide.DetectStructure(), S21MatrixStructure::kGeneral);
+}
+
+TEST(S21MatrixTest, DetectStructureZero) {
+  const S21Matrix zero(4, 4);
+  EXPECT_EQ(zero.DetectStructure(), S21MatrixStructure::kUpperTriangular);
+  EXPECT_THROW(zero.Solve(S21Matrix(4, 1)), std::invalid_argument);
+  EXPECT_THROW(zero.Solve(S21Matrix(4, 1), S21MatrixStructure::kGeneral),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, Expressions) {
+  S21Matrix A(7, 5);
+  S21Matrix B(7, 5);
+  S21Matrix C(7, 5);
+  fill_uniform(A);
+  fill_uniform(B);
+  fill_uniform(C);
+
+  S21Matrix expected = A;
+  expected += B;
+  S21Matrix scaled = C;
+  scaled *= 2.0;
+  expected -= scaled;
+  const S21Matrix result = A + B - C * 2.0;
+  EXPECT_EQ(result, expected);
+  S21Matrix assigned(1, 1);
+  assigned = A + B - 2.0 * C;
+  EXPECT_EQ(assigned, expected);
+
+  S21Matrix accumulated = A;
+  accumulated += B - C * 2.0;
+  EXPECT_EQ(accumulated, expected);
+  accumulated -= B - C * 2.0;
+  EXPECT_EQ(accumulated, A);
+
+  S21Matrix aliased = A;
+  aliased = aliased + aliased * 2.0;
+  EXPECT_EQ(aliased, A * 3.0);
+  EXPECT_EQ(A * 3.0, aliased);
+  EXPECT_EQ(A + A * 2.0, A * 3.0);
+  EXPECT_FALSE(A + B == A - B);
+
+  S21Matrix D(5, 3);
+  fill_uniform(D);
+  EXPECT_EQ((A + B) * D, naive_multiply(A + B, D));
+  S21Matrix E(3, 7);
+  fill_uniform(E);
+  EXPECT_EQ(E * (A - B), naive_multiply(E, A - B));
+  EXPECT_EQ((E * 2.0) * (A - B) * 0.5, naive_multiply(E, A - B));
+
+  ASSERT_THROW(A + D, std::invalid_argument);
+  ASSERT_THROW(A + B - D, std::invalid_argument);
+  ASSERT_THROW(accumulated += D * 1.0, std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ExpressionMembers) {
+  S21Matrix A(4, 4);
+  S21Matrix B(4, 4);
+  fill_uniform(A);
+  fill_uniform(B);
+  const S21Matrix sum = S21Matrix(A) += B;
+  const S21Matrix difference = S21Matrix(A) -= B;
+  const S21Matrix scaled = S21Matrix(A) *= 2.0;
+
+  EXPECT_EQ((A + B).Transpose(), sum.Transpose());
+  EXPECT_EQ((A - B).Transpose(), difference.Transpose());
+  EXPECT_EQ((A * 2.0).Transpose(), scaled.Transpose());
+  EXPECT_DOUBLE_EQ((A + B).Determinant(), sum.Determinant());
+  EXPECT_DOUBLE_EQ((A - B).Determinant(), difference.Determinant());
+  EXPECT_DOUBLE_EQ((A * 2.0).Determinant(), scaled.Determinant());
+  EXPECT_EQ((A + B).InverseMatrix(), sum.InverseMatrix());
+  EXPECT_EQ((A * 2.0).CalcComplements(), scaled.CalcComplements());
+  EXPECT_EQ((A - B).Solve(B), difference.Solve(B));
+  EXPECT_TRUE((A + B).EqMatrix(sum));
+  EXPECT_EQ((A + B).Eval(), sum);
+  EXPECT_EQ((A - B).Rows(), 4);
+  EXPECT_EQ((A - B).Cols(), 4);
+  EXPECT_TRUE((A * 2.0).IsSquare());
+  EXPECT_EQ((A + B)(1, 2), sum(1, 2));
+  EXPECT_EQ((A - B)(0, 0), difference(0, 0));
+  EXPECT_EQ((2.0 * A)(3, 1), scaled(3, 1));
+  EXPECT_THROW((A + B)(4, 0), std::out_of_range);
+  EXPECT_THROW((A - B)(0, -1), std::out_of_range);
+}
+
+// Все пути вычитания сообщают о несовпадении размерностей одинаково
+TEST(S21MatrixTest, ExpressionDimensionErrors) {
+  const S21Matrix A(2, 3), B(3, 2);
+  const std::string addition =
+      "Matrices must have the same dimensions for addition.";
+  const std::string subtraction =
+      "Matrices must have the same dimensions for subtraction.";
+  const auto message = [](const std::function<void()>& operation) {
+    try {
+      operation();
+    } catch (const std::invalid_argument& error) {
+      return std::string(error.what());
+    }
+    return std::string();
+  };
+  EXPECT_EQ(message([&] { A + B; }), addition);
+  EXPECT_EQ(message([&] { S21Matrix(A) + B * 1.0; }), addition);
+  EXPECT_EQ(message([&] { S21Matrix(A) += B; }), addition);
+  EXPECT_EQ(message([&] { A - B; }), subtraction);
+  EXPECT_EQ(message([&] { A - S21Matrix(B); }), subtraction);
+  EXPECT_EQ(message([&] { B * 1.0 - S21Matrix(A); }), subtraction);
+  EXPECT_EQ(message([&] { S21Matrix(A) - B * 1.0; }), subtraction);
+  EXPECT_EQ(message([&] { S21Matrix(A) -= B; }), subtraction);
+  EXPECT_EQ(message([&] { S21Matrix(A) -= B * 1.0; }), subtraction);
+}
+
+TEST(S21MatrixTest, RvalueArithmetic) {
+  static_assert(std::is_nothrow_move_constructible<S21Matrix>::value,
+                "S21Matrix move constructor must be noexcept");
+  static_assert(std::is_nothrow_move_assignable<S21Matrix>::value,
+                "S21Matrix move assignment must be noexcept");
+  S21Matrix A(6, 4);
+  S21Matrix B(6, 4);
+  fill_uniform(A);
+  fill_uniform(B);
+
+  S21Matrix tmp = A;
+  const double* buffer = tmp.Data();
+  S21Matrix sum = std::move(tmp) + B;
+  EXPECT_EQ(sum.Data(), buffer);
+  EXPECT_EQ(sum, A + B);
+
+  tmp = B;
+  buffer = tmp.Data();
+  S21Matrix diff = A - std::move(tmp);
+  EXPECT_EQ(diff.Data(), buffer);
+  EXPECT_EQ(diff, A - B);
+
+  tmp = A;
+  buffer = tmp.Data();
+  S21Matrix chained = std::move(tmp) * 2.0 - B + A;
+  EXPECT_EQ(chained.Data(), buffer);
+  EXPECT_EQ(chained, A * 3.0 - B);
+  EXPECT_EQ(S21Matrix(A) - S21Matrix(B), A - B);
+  EXPECT_EQ(S21Matrix(A) + S21Matrix(B), A + B);
+  EXPECT_EQ(0.5 * S21Matrix(A), A * 0.5);
+  ASSERT_THROW(S21Matrix(A) + S21Matrix(2, 2), std::invalid_argument);
+  ASSERT_THROW(A - S21Matrix(2, 2), std::invalid_argument);
+
+  std::vector<S21Matrix> matrices;
+  matrices.push_back(A);
+  buffer = matrices[0].Data();
+  for (int i = 0; i < 100; ++i) {
+    matrices.push_back(B);
+  }
+  EXPECT_EQ(matrices[0].Data(), buffer);
+}
+TEST(S21MatrixTest, SimdLevels) {
+  const S21SimdLevel detected = S21DetectSimdLevel();
+  const S21SimdLevel levels[] = {S21SimdLevel::kScalar, S21SimdLevel::kSse2,
+                                 S21SimdLevel::kAvx2, S21SimdLevel::kAvx512};
+  S21Matrix A(13, 67);
+  S21Matrix B(13, 67);
+  S21Matrix C(67, 29);
+  fill_uniform(A);
+  fill_uniform(B);
+  fill_uniform(C);
+  const S21Matrix product = naive_multiply(A, C);
+  for (S21SimdLevel level : levels) {
+    S21SetSimdLevel(level);
+    EXPECT_LE(static_cast<int>(S21GetSimdLevel()), static_cast<int>(detected));
+
+    S21Matrix sum = A;
+    sum += B;
+    S21Matrix diff = A;
+    diff -= B;
+    S21Matrix scaled = A;
+    scaled *= -1.5;
+    for (int i = 0; i < A.Rows(); ++i) {
+      for (int j = 0; j < A.Cols(); ++j) {
+        EXPECT_EQ(sum(i, j), A(i, j) + B(i, j));
+        EXPECT_EQ(diff(i, j), A(i, j) - B(i, j));
+        EXPECT_EQ(scaled(i, j), A(i, j) * -1.5);
+      }
+    }
+    EXPECT_TRUE(A == A);
+    S21Matrix almost = A;
+    almost(12, 66) += S21Matrix::kEpsilon / 2;
+    EXPECT_TRUE(A == almost);
+    almost(12, 66) += S21Matrix::kEpsilon;
+    EXPECT_FALSE(A == almost);
+    EXPECT_EQ(A * C, product);
+  }
+  S21SetSimdLevel(detected);
+  EXPECT_EQ(S21GetSimdLevel(), detected);
+}
+TEST(S21MatrixTest, UncheckedAccess) {
+  double dataA[] = {1, 2, 3, 4, 5, 6};
+  S21Matrix A(2, 3, dataA);
+  const S21Matrix& cA = A;
+  for (int i = 0; i < A.Rows(); ++i) {
+    for (int j = 0; j < A.Cols(); ++j) {
+      EXPECT_EQ(&A.At(i, j), &A(i, j));
+      EXPECT_EQ(&cA.At(i, j), &cA(i, j));
+      EXPECT_EQ(&A[i][j], &A(i, j));
+      EXPECT_EQ(&cA[i][j], &cA(i, j));
+    }
+  }
+  A.At(1, 2) = 60;
+  A[0][1] = 20;
+  EXPECT_EQ(A(1, 2), 60);
+  EXPECT_EQ(A(0, 1), 20);
+
+  S21MatrixRow row = A.Row(1);
+  EXPECT_EQ(row.size(), 3);
+  for (double& value : row) {
+    value *= 2;
+  }
+  EXPECT_EQ(A(1, 0), 8);
+  EXPECT_EQ(A(1, 2), 120);
+  double sum = 0;
+  for (double value : cA.Row(0)) {
+    sum += value;
+  }
+  EXPECT_EQ(sum, 24);
+  EXPECT_EQ(cA.Row(0)[2], 3);
+#ifdef DEBUG
+  ASSERT_THROW(A.At(2, 0), std::out_of_range);
+  ASSERT_THROW(A.Row(-1), std::out_of_range);
+  ASSERT_THROW(row[3], std::out_of_range);
+#endif
+}
+TEST(S21MatrixTest, Parallel) {
+  const int threads = S21GetThreadCount();
+  const long long threshold = S21GetParallelThreshold();
+  S21Matrix A(150, 150);
+  S21Matrix B(150, 150);
+  fill_uniform(A);
+  fill_uniform(B);
+  for (int i = 0; i < A.Rows(); ++i) {
+    A(i, i) += 2;
+  }
+  const S21Matrix product = naive_multiply(A, B);
+  const S21Matrix serial_inverse = A.InverseMatrix();
+  const double serial_det = A.Determinant();
+
+  S21SetThreadCount(4);
+  S21SetParallelThreshold(0);
+  EXPECT_EQ(S21GetThreadCount(), 4);
+  EXPECT_EQ(S21GetParallelThreshold(), 0);
+  S21Matrix sum = A;
+  sum += B;
+  S21Matrix diff = A;
+  diff -= B;
+  S21Matrix scaled = A;
+  scaled *= 3;
+  const S21Matrix fused = A + B * 2;
+  const S21Matrix transpose = A.Transpose();
+  for (int i = 0; i < A.Rows(); ++i) {
+    for (int j = 0; j < A.Cols(); ++j) {
+      EXPECT_EQ(sum(i, j), A(i, j) + B(i, j));
+      EXPECT_EQ(diff(i, j), A(i, j) - B(i, j));
+      EXPECT_EQ(scaled(i, j), A(i, j) * 3);
+      EXPECT_EQ(fused(i, j), A(i, j) + B(i, j) * 2);
+      EXPECT_EQ(transpose(j, i), A(i, j));
+    }
+  }
+  EXPECT_TRUE(A == A);
+  EXPECT_FALSE(A == B);
+  S21Matrix C = A;
+  C *= B;
+  EXPECT_EQ(C, product);
+  EXPECT_EQ(A.InverseMatrix(), serial_inverse);
+  EXPECT_NEAR(A.Determinant(), serial_det, std::fabs(serial_det) * 1e-12);
+
+  std::vector<int> hits(1000, 0);
+  s21::detail::ParallelFor(0, 1000, 1000, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      ++hits[i];
+    }
+  });
+  EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 1000);
+  ASSERT_THROW(s21::detail::ParallelFor(0, 1000, 1000,
+                                        [](int first, int) {
+                                          if (first > 0) {
+                                            throw std::out_of_range("chunk");
+                                          }
+                                        }),
+               std::out_of_range);
+
+  S21SetThreadCount(threads);
+  S21SetParallelThreshold(threshold);
+}
+
+// Вложенный вызов на том же пуле из тела выполняется последовательно
+TEST(S21MatrixTest, ThreadPoolNested) {
+  S21ThreadPool pool(4);
+  std::vector<std::atomic<int> > hits(100 * 100);
+  pool.ParallelFor(0, 100, 1, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      pool.ParallelFor(0, 100, 1, [&](int inner_first, int inner_last) {
+        for (int j = inner_first; j < inner_last; ++j) {
+          ++hits[i * 100 + j];
+        }
+      });
+    }
+  });
+  for (const std::atomic<int>& hit : hits) {
+    EXPECT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(S21MatrixTest, TransposeBlocked) {
+  const int shapes[][2] = {{1, 1}, {3, 70}, {70, 3}, {33, 65}, {130, 97}};
+  for (const auto& shape : shapes) {
+    S21Matrix A(shape[0], shape[1]);
+    fill_uniform(A);
+    const S21Matrix T = A.Transpose();
+    ASSERT_EQ(T.Rows(), A.Cols());
+    ASSERT_EQ(T.Cols(), A.Rows());
+    for (int i = 0; i < A.Rows(); ++i) {
+      for (int j = 0; j < A.Cols(); ++j) {
+        EXPECT_EQ(T(j, i), A(i, j));
+      }
+    }
+  }
+}
+TEST(S21MatrixTest, TransposeInPlace) {
+  const int shapes[][2] = {{1, 1}, {67, 67}, {2, 3},  {5, 13},
+                           {1, 9}, {9, 1},   {64, 3}, {40, 100}};
+  for (const auto& shape : shapes) {
+    S21Matrix A(shape[0], shape[1]);
+    fill_uniform(A);
+    const S21Matrix expected = A.Transpose();
+    const double* data = A.Data();
+    const bool fits = static_cast<std::size_t>(A.Cols()) * expected.Stride() <=
+                      static_cast<std::size_t>(A.Rows()) * A.Stride();
+    A.TransposeInPlace();
+    if (fits) {
+      EXPECT_EQ(A.Data(), data);
+    }
+    ASSERT_EQ(A.Rows(), shape[1]);
+    ASSERT_EQ(A.Cols(), shape[0]);
+    EXPECT_EQ(A.Stride(), expected.Stride());
+    for (int i = 0; i < A.Rows(); ++i) {
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(A[i]) % S21Matrix::kAlignment,
+                0u);
+    }
+    EXPECT_EQ(A, expected);
+    A.TransposeInPlace();
+    EXPECT_EQ(A, expected.Transpose());
+    A += A;
+    S21Matrix copy(A);
+    EXPECT_EQ(copy, A);
+  }
+
+  S21Matrix empty(0, 4);
+  empty.TransposeInPlace();
+  EXPECT_EQ(empty.Rows(), 4);
+  EXPECT_EQ(empty.Cols(), 0);
+}
+
+// Широкой матрице не хватает прежнего буфера: он расширяется один раз,
+// дальше транспонирование идёт в том же буфере
+TEST(S21MatrixTest, TransposeInPlaceWide) {
+  const int shapes[][2] = {{3, 1000}, {1001, 2000}};
+  for (const auto& shape : shapes) {
+    S21Matrix A = uniform_matrix(shape[0], shape[1]);
+    const S21Matrix expected = A.Transpose();
+    A.TransposeInPlace();
+    EXPECT_EQ(A.Stride(), expected.Stride());
+    EXPECT_EQ(A, expected);
+    const double* data = A.Data();
+    A.TransposeInPlace();
+    EXPECT_EQ(A.Data(), data);
+    EXPECT_EQ(A, expected.Transpose());
+    A.TransposeInPlace();
+    EXPECT_EQ(A.Data(), data);
+    EXPECT_EQ(A, expected);
+    for (int i = 0; i < A.Rows(); ++i) {
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(A[i]) % S21Matrix::kAlignment,
+                0u);
+    }
+  }
+}
+
+TEST(S21MatrixTest, TransposeInPlacePooled) {
+  S21MatrixPool pool;
+  S21MatrixPoolScope scope(pool);
+  S21Matrix A = uniform_matrix(3, 1000);
+  const S21Matrix expected = A.Transpose();
+  A.TransposeInPlace();
+  EXPECT_EQ(A, expected);
+  const double* data = A.Data();
+  A.TransposeInPlace();
+  EXPECT_EQ(A.Data(), data);
+  EXPECT_EQ(A, expected.Transpose());
+}
+TEST(S21MatrixTest, ViewWhole) {
+  const S21Matrix A = uniform_matrix(7, 9);
+  const S21MatrixView whole = A.View();
+  EXPECT_EQ(whole.Data(), A.Data());
+  EXPECT_TRUE(whole == A);
+  EXPECT_TRUE(A == whole);
+}
+
+TEST(S21MatrixTest, ViewTransposed) {
+  const S21Matrix A = uniform_matrix(7, 9);
+  const S21MatrixView t = A.TransposedView();
+  EXPECT_EQ(t.Rows(), 9);
+  EXPECT_EQ(t.Cols(), 7);
+  EXPECT_EQ(t.Data(), A.Data());
+  EXPECT_TRUE(t == A.Transpose());
+  EXPECT_TRUE(t.Transpose() == A);
+  EXPECT_EQ(S21Matrix(t), A.Transpose());
+}
+
+TEST(S21MatrixTest, ViewBlockSlice) {
+  S21Matrix A = uniform_matrix(7, 9);
+  const S21MatrixView block = A.Block(2, 3, 4, 5);
+  const S21MatrixView slice = A.Slice(1, 0, 3, 5, 2, 2);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      EXPECT_EQ(&block(i, j), &A(2 + i, 3 + j));
+    }
+  }
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      EXPECT_EQ(&slice(i, j), &A(1 + 2 * i, 2 * j));
+      EXPECT_EQ(slice.Transpose().At(j, i), A(1 + 2 * i, 2 * j));
+    }
+  }
+  EXPECT_EQ(block.Block(1, 1, 2, 2)(1, 1), A(4, 5));
+}
+
+TEST(S21MatrixTest, ViewBounds) {
+  const S21Matrix A = uniform_matrix(7, 9);
+  const S21MatrixView block = A.Block(2, 3, 4, 5);
+  ASSERT_THROW(A.Block(5, 0, 3, 1), std::out_of_range);
+  ASSERT_THROW(A.Slice(0, 0, 2, 2, 0, 1), std::out_of_range);
+  ASSERT_THROW(A.Slice(0, 0, 4, 1, 3, 1), std::out_of_range);
+  ASSERT_THROW(block(4, 0), std::out_of_range);
+  EXPECT_EQ(A.Block(0, 0, 0, 3).Rows(), 0);
+}
+
+// Произведения представлений совпадают с произведениями копий
+TEST(S21MatrixTest, ViewProduct) {
+  const S21Matrix A = uniform_matrix(7, 9);
+  const S21Matrix B = uniform_matrix(9, 6);
+  const S21MatrixView block = A.Block(2, 3, 4, 5);
+  const S21MatrixView slice = A.Slice(1, 0, 3, 5, 2, 2);
+  EXPECT_EQ(A.TransposedView() * A, naive_multiply(A.Transpose(), A));
+  EXPECT_EQ(A * B.Block(0, 0, 9, 4),
+            naive_multiply(A, S21Matrix(B.Block(0, 0, 9, 4))));
+  EXPECT_EQ(block * slice.Transpose(),
+            naive_multiply(S21Matrix(block), S21Matrix(slice).Transpose()));
+  EXPECT_EQ(B.TransposedView() * A.TransposedView(), (A * B).Transpose());
+  ASSERT_THROW(block * block, std::invalid_argument);
+}
+
+// Определитель и обратная матрица без копирования представления
+TEST(S21MatrixTest, ViewDeterminantInverse) {
+  S21Matrix C = uniform_matrix(40, 40);
+  for (int i = 0; i < C.Rows(); ++i) {
+    C(i, i) += 2;
+  }
+  const S21MatrixView inner = C.Block(1, 1, 30, 30);
+  const S21Matrix inner_copy(inner);
+  EXPECT_NEAR(inner.Determinant(), inner_copy.Determinant(),
+              1e-12 * std::fabs(inner_copy.Determinant()));
+  EXPECT_NEAR(C.TransposedView().Determinant(), C.Determinant(),
+              1e-9 * std::fabs(C.Determinant()));
+  EXPECT_EQ(inner.InverseMatrix(), inner_copy.InverseMatrix());
+  EXPECT_EQ(C.Block(0, 0, 3, 3).Determinant(),
+            S21Matrix(C.Block(0, 0, 3, 3)).Determinant());
+  ASSERT_THROW(C.Block(2, 3, 4, 5).Determinant(), std::invalid_argument);
+}
+
+// Представления участвуют в поэлементных выражениях
+TEST(S21MatrixTest, ViewExpression) {
+  const S21Matrix A = uniform_matrix(7, 9);
+  const S21Matrix sum = A.Block(2, 3, 4, 5) + A.Block(0, 0, 4, 5) * 2.0;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      EXPECT_EQ(sum(i, j), A(2 + i, 3 + j) + A(i, j) * 2.0);
+    }
+  }
+}
+
+// Представление приёмника в выражении не портит результат
+TEST(S21MatrixTest, ViewAliasedAddition) {
+  const double values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  S21Matrix b(3, 3, values);
+  b += b.TransposedView();
+  const double expected[] = {2, 6, 10, 6, 10, 14, 10, 14, 18};
+  EXPECT_EQ(b, S21Matrix(3, 3, expected));
+
+  S21Matrix big = uniform_matrix(300, 300);
+  const S21Matrix copy = big;
+  big -= big.TransposedView() * 2.0;
+  EXPECT_EQ(big, copy - copy.Transpose() * 2.0);
+}
+
+TEST(S21MatrixTest, ViewAliasedAssignment) {
+  const double values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  S21Matrix c(3, 3, values);
+  c = c.TransposedView();
+  EXPECT_EQ(c, S21Matrix(3, 3, values).Transpose());
+
+  S21Matrix d = uniform_matrix(40, 40);
+  const S21Matrix copy = d;
+  d = d.Block(1, 1, 2, 2);
+  ASSERT_EQ(d.Rows(), 2);
+  ASSERT_EQ(d.Cols(), 2);
+  EXPECT_EQ(d, S21Matrix(copy.Block(1, 1, 2, 2)));
+
+  S21Matrix e = uniform_matrix(40, 40);
+  const S21Matrix e_copy = e;
+  e = e + e.TransposedView();
+  EXPECT_EQ(e, e_copy + e_copy.Transpose());
+}
+
+TEST(S21MatrixTest, PoolReuse) {
+  EXPECT_EQ(S21MatrixPool::Current(), nullptr);
+  S21MatrixPool pool;
+  {
+    S21MatrixPoolScope scope(pool);
+    EXPECT_EQ(S21MatrixPool::Current(), &pool);
+    for (int i = 0; i < 100; ++i) {
+      S21Matrix temporary(30, 30);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(temporary.Data()) %
+                    S21Matrix::kAlignment,
+                0u);
+      EXPECT_EQ(temporary(29, 29), 0);
+      temporary(29, 29) = i;
+    }
+  }
+  EXPECT_EQ(S21MatrixPool::Current(), nullptr);
+  const S21MatrixPoolStats stats = pool.Stats();
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.hits, 99u);
+  EXPECT_EQ(stats.recycled, 100u);
+  EXPECT_GE(stats.cached_bytes, 30u * 32 * sizeof(double));
+}
+
+// Близкие размеры попадают в один класс
+TEST(S21MatrixTest, PoolSizeClass) {
+  S21MatrixPool pool;
+  S21MatrixPoolScope scope(pool);
+  { S21Matrix temporary(30, 30); }
+  S21Matrix similar(31, 30);
+  EXPECT_EQ(pool.Stats().misses, 1u);
+  EXPECT_EQ(pool.Stats().hits, 1u);
+}
+
+TEST(S21MatrixTest, PoolNestedScope) {
+  S21MatrixPool pool;
+  {
+    S21MatrixPoolScope scope(pool);
+    S21MatrixPool inner;
+    {
+      S21MatrixPoolScope inner_scope(inner);
+      EXPECT_EQ(S21MatrixPool::Current(), &inner);
+      S21Matrix other(4, 4);
+      EXPECT_EQ(inner.Stats().misses, 1u);
+    }
+    EXPECT_EQ(S21MatrixPool::Current(), &pool);
+    EXPECT_EQ(pool.Stats().misses, 0u);
+  }
+  EXPECT_EQ(S21MatrixPool::Current(), nullptr);
+  S21Matrix unpooled(30, 30);
+  EXPECT_EQ(pool.Stats().misses, 0u);
+}
+
+TEST(S21MatrixTest, PoolClear) {
+  S21MatrixPool pool;
+  {
+    S21MatrixPoolScope scope(pool);
+    S21Matrix temporary(30, 30);
+  }
+  EXPECT_GT(pool.Stats().cached_bytes, 0u);
+  pool.Clear();
+  EXPECT_EQ(pool.Stats().cached_bytes, 0u);
+}
+
+// Буфер, переживший пул, освобождается обычным образом
+TEST(S21MatrixTest, PoolOutlived) {
+  S21Matrix outlived;
+  {
+    S21MatrixPool pool;
+    S21MatrixPoolScope scope(pool);
+    outlived = S21Matrix(50, 50);
+  }
+  outlived(49, 49) = 1;
+  EXPECT_EQ(outlived(49, 49), 1);
+  outlived = S21Matrix();
+}
+
+TEST(S21MatrixTest, PoolLimit) {
+  S21MatrixPool tiny(0);
+  {
+    S21MatrixPoolScope scope(tiny);
+    S21Matrix first(8, 8);
+  }
+  EXPECT_EQ(tiny.Stats().released, 1u);
+  EXPECT_EQ(tiny.Stats().cached_bytes, 0u);
+}
+
+TEST(S21MatrixTest, FixedMatrix) {
+  constexpr S21Matrix2 a(1, 2, 3, 4);
+  constexpr S21Matrix2 b(5, 6, 7, 8);
+  static_assert((a * b).At(0, 0) == 19 && (a * b).At(1, 1) == 50, "");
+  static_assert(a.Determinant() == -2, "");
+  static_assert((a + b - b) == a, "");
+  static_assert(a.Transpose().At(0, 1) == 3, "");
+  static_assert(S21Matrix3::Identity().Determinant() == 1, "");
+  static_assert((a * a.InverseMatrix()) == S21Matrix2::Identity(), "");
+  static_assert(std::is_trivially_copyable<S21Matrix4>::value, "");
+  static_assert(sizeof(S21Matrix4) == 16 * sizeof(double), "");
+
+  constexpr S21FixedMatrix<2, 3> wide(1, 2, 3, 4, 5, 6);
+  constexpr S21FixedMatrix<3, 1> column(1, 1, 1);
+  constexpr S21FixedMatrix<2, 1> sums = wide * column;
+  EXPECT_EQ(sums(0, 0), 6);
+  EXPECT_EQ(sums(1, 0), 15);
+  EXPECT_THROW(sums(2, 0), std::out_of_range);
+
+  // Явные формулы и исключение Гаусса сверяются с S21Matrix
+  S21Matrix dynamic4(4, 4);
+  fill_uniform(dynamic4);
+  for (int i = 0; i < 4; ++i) {
+    dynamic4(i, i) += 2;
+  }
+  const S21Matrix4 fixed4(dynamic4);
+  EXPECT_NEAR(fixed4.Determinant(), dynamic4.Determinant(), 1e-9);
+  EXPECT_TRUE(fixed4.InverseMatrix().ToMatrix() == dynamic4.InverseMatrix());
+  EXPECT_TRUE(static_cast<S21Matrix>(fixed4 * fixed4) == dynamic4 * dynamic4);
+
+  S21Matrix dynamic6(6, 6);
+  fill_uniform(dynamic6);
+  for (int i = 0; i < 6; ++i) {
+    dynamic6(i, i) += 2;
+  }
+  const S21Matrix6 fixed6(dynamic6);
+  EXPECT_NEAR(fixed6.Determinant(), dynamic6.Determinant(),
+              1e-9 * std::fabs(dynamic6.Determinant()));
+  EXPECT_TRUE(fixed6.InverseMatrix().ToMatrix() == dynamic6.InverseMatrix());
+  EXPECT_TRUE(fixed6.View() == dynamic6);
+  EXPECT_TRUE(fixed6 * fixed6.InverseMatrix() == S21Matrix6::Identity());
+
+  const S21Matrix3 singular(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  S21Matrix6 singular6;
+  EXPECT_THROW(singular6.InverseMatrix(), std::invalid_argument);
+  EXPECT_EQ(singular6.Determinant(), 0);
+  EXPECT_THROW(S21Matrix3(S21Matrix(3, 4)), std::invalid_argument);
+}
+
+typedef std::complex<double> Complex;
+typedef S21BasicMatrix<Complex> ComplexMatrix;
+
+S21BasicMatrix<float> ToFloat(const S21Matrix& matrix) {
+  S21BasicMatrix<float> result(matrix.Rows(), matrix.Cols());
+  for (int i = 0; i < matrix.Rows(); ++i) {
+    for (int j = 0; j < matrix.Cols(); ++j) {
+      result(i, j) = static_cast<float>(matrix(i, j));
+    }
+  }
+  return result;
+}
+
+ComplexMatrix ComplexSample() {
+  const Complex z[] = {{1, 1}, {2, 0}, {3, 0}, {4, -1}};
+  return ComplexMatrix(2, 2, z);
+}
+
+const S21SimdLevel kSimdLevels[] = {S21SimdLevel::kScalar,
+                                    S21SimdLevel::kSse2, S21SimdLevel::kAvx2,
+                                    S21SimdLevel::kAvx512};
+
+TEST(S21MatrixTest, ElementTypesEpsilon) {
+  static_assert(std::is_same<S21Matrix, S21BasicMatrix<double> >::value, "");
+  EXPECT_EQ(S21BasicMatrix<float>::kEpsilon, 1.0e-4f);
+  EXPECT_EQ(S21Matrix::kEpsilon, 1.0e-6);
+}
+
+// float: микроядро GEMM на каждом уровне
+TEST(S21MatrixTest, ElementTypesFloatMultiply) {
+  const S21Matrix A = uniform_matrix(37, 45);
+  const S21Matrix B = uniform_matrix(45, 51);
+  const S21BasicMatrix<float> a = ToFloat(A), b = ToFloat(B);
+  const S21Matrix product = naive_multiply(A, B);
+  const S21SimdLevel detected = S21DetectSimdLevel();
+  for (S21SimdLevel level : kSimdLevels) {
+    S21SetSimdLevel(level);
+    const S21BasicMatrix<float> ab = a * b;
+    for (int i = 0; i < product.Rows(); ++i) {
+      for (int j = 0; j < product.Cols(); ++j) {
+        EXPECT_NEAR(ab(i, j), product(i, j), 1e-4);
+      }
+    }
+  }
+  S21SetSimdLevel(detected);
+}
+
+// float: векторные поэлементные ядра на каждом уровне
+TEST(S21MatrixTest, ElementTypesFloatArithmetic) {
+  const S21BasicMatrix<float> a = ToFloat(uniform_matrix(37, 45));
+  const S21SimdLevel detected = S21DetectSimdLevel();
+  for (S21SimdLevel level : kSimdLevels) {
+    S21SetSimdLevel(level);
+    S21BasicMatrix<float> sum = a;
+    sum += a;
+    sum -= a * 0.5f;
+    sum *= 2.0f;
+    for (int j = 0; j < a.Cols(); ++j) {
+      EXPECT_EQ(sum(36, j), 3.0f * a(36, j));
+    }
+  }
+  S21SetSimdLevel(detected);
+  const S21BasicMatrix<float> expr = a + a * 2 - a;
+  EXPECT_TRUE(expr == a * 2);
+}
+
+// float: сравнение с допуском kEpsilon на каждом уровне
+TEST(S21MatrixTest, ElementTypesFloatCompare) {
+  const S21BasicMatrix<float> a = ToFloat(uniform_matrix(37, 45));
+  const S21SimdLevel detected = S21DetectSimdLevel();
+  for (S21SimdLevel level : kSimdLevels) {
+    S21SetSimdLevel(level);
+    S21BasicMatrix<float> almost = a;
+    almost(36, 44) += 0.5e-4f;
+    EXPECT_TRUE(a == almost);
+    almost(36, 44) += 1.0e-4f;
+    EXPECT_FALSE(a == almost);
+  }
+  S21SetSimdLevel(detected);
+}
+
+TEST(S21MatrixTest, ElementTypesLongDouble) {
+  const long double values[] = {4, 1, 2, 1, 5, 3, 2, 3, 6};
+  const S21BasicMatrix<long double> l(3, 3, values);
+  const long double unit[] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+  EXPECT_NEAR(static_cast<double>(l.Determinant()), 70, 1e-12);
+  EXPECT_TRUE(l * l.InverseMatrix() == S21BasicMatrix<long double>(3, 3, unit));
+}
+
+TEST(S21MatrixTest, ElementTypesLongDoubleLarge) {
+  S21BasicMatrix<long double> big(70, 70);
+  for (int i = 0; i < 70; ++i) {
+    for (int j = 0; j < 70; ++j) {
+      big(i, j) = (i == j) ? 3.0L : 1.0L / (1 + i + j);
+    }
+  }
+  const S21BasicMatrix<long double> identity = big * big.InverseMatrix();
+  for (int i = 0; i < 70; ++i) {
+    EXPECT_NEAR(static_cast<double>(identity(i, i)), 1, 1e-12);
+  }
+}
+
+TEST(S21MatrixTest, ElementTypesComplexDeterminant) {
+  const ComplexMatrix c = ComplexSample();
+  EXPECT_NEAR(std::abs(c.Determinant() - Complex(-1, 3)), 0, 1e-12);
+  EXPECT_NEAR(std::abs(c.LU().Determinant() - Complex(-1, 3)), 0, 1e-12);
+}
+
+TEST(S21MatrixTest, ElementTypesComplexInverse) {
+  const ComplexMatrix c = ComplexSample();
+  const ComplexMatrix c_identity = c * c.InverseMatrix();
+  EXPECT_NEAR(std::abs(c_identity(0, 0) - 1.0), 0, 1e-12);
+  EXPECT_NEAR(std::abs(c_identity(0, 1)), 0, 1e-12);
+  const Complex singular[] = {{1, 1}, {2, 2}, {1, 1}, {2, 2}};
+  EXPECT_THROW(ComplexMatrix(2, 2, singular).InverseMatrix(),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ElementTypesComplexArithmetic) {
+  const ComplexMatrix c = ComplexSample();
+  ComplexMatrix rotated = c;
+  rotated *= Complex(0, 1);
+  EXPECT_EQ(rotated(0, 0), Complex(-1, 1));
+  rotated += c;
+  rotated -= c * 2.0;
+  EXPECT_EQ(rotated(1, 1), Complex(-3, 5));
+  EXPECT_EQ(c.Transpose()(0, 1), Complex(3, 0));
+}
+
+TEST(S21MatrixTest, ElementTypesComplexSolve) {
+  const ComplexMatrix c = ComplexSample();
+  const ComplexMatrix x = c.Solve(c);
+  EXPECT_NEAR(std::abs(x(0, 0) - 1.0), 0, 1e-12);
+  EXPECT_NEAR(std::abs(x(1, 0)), 0, 1e-12);
+}
+
+S21Matrix SparseSample() {
+  S21Matrix dense(3, 4);
+  dense(0, 1) = 2;
+  dense(1, 0) = -1;
+  dense(1, 3) = 1e-9;
+  dense(2, 2) = 5;
+  return dense;
+}
+
+// Случайная матрица, где ненулевые только элементы с
+// (i * row_step + j * col_step) % period == 0
+S21Matrix SparsePattern(int rows, int cols, int row_step, int col_step,
+                        int period) {
+  S21Matrix matrix(rows, cols);
+  fill_uniform(matrix);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      if ((i * row_step + j * col_step) % period != 0) {
+        matrix(i, j) = 0;
+      }
+    }
+  }
+  return matrix;
+}
+
+TEST(S21MatrixTest, SparseFromDense) {
+  const S21Matrix dense = SparseSample();
+  const S21SparseMatrix exact(dense);
+  EXPECT_EQ(exact.NonZeros(), 4);
+  EXPECT_EQ(exact.ToDense(), dense);
+}
+
+TEST(S21MatrixTest, SparseDropTolerance) {
+  const S21Matrix dense = SparseSample();
+  const S21SparseMatrix dropped(dense, 1e-6, S21SparseFormat::kCsc);
+  EXPECT_EQ(dropped.Format(), S21SparseFormat::kCsc);
+  EXPECT_EQ(dropped.NonZeros(), 3);
+  EXPECT_EQ(dropped.Offsets(), (std::vector<int>{0, 1, 2, 3, 3}));
+  EXPECT_EQ(dropped.Indices(), (std::vector<int>{1, 0, 2}));
+  EXPECT_EQ(dropped(0, 1), 2);
+  EXPECT_EQ(dropped(1, 3), 0);
+  ASSERT_THROW(dropped(3, 0), std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix(dense, -1), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, SparseTriplets) {
+  const S21SparseMatrix triplets(
+      3, 4, {{2, 2, 4}, {0, 1, 2}, {1, 0, -1}, {2, 2, 1}, {1, 3, 1e-9}});
+  EXPECT_EQ(triplets.NonZeros(), 4);
+  EXPECT_EQ(triplets.ToDense(), SparseSample());
+  ASSERT_THROW(S21SparseMatrix(3, 4, {{3, 0, 1}}), std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix(2, 2, S21SparseFormat::kCsr, {0, 2, 2},
+                               {1, 0}, {1, 2}),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, SparsePrune) {
+  S21SparseMatrix pruned(SparseSample());
+  pruned.Prune(1e-6);
+  EXPECT_EQ(pruned.NonZeros(), 3);
+}
+
+TEST(S21MatrixTest, SparseTransposeFormat) {
+  const S21Matrix dense = SparseSample();
+  const S21SparseMatrix exact(dense);
+  EXPECT_EQ(exact.Transpose().ToDense(), dense.Transpose());
+  EXPECT_EQ(exact.ToFormat(S21SparseFormat::kCsc).ToDense(), dense);
+}
+
+TEST(S21MatrixTest, SparseDenseProduct) {
+  const int threads = S21GetThreadCount();
+  const long long threshold = S21GetParallelThreshold();
+  S21SetThreadCount(4);
+  S21SetParallelThreshold(0);
+  const S21Matrix a = SparsePattern(60, 50, 7, 13, 9);
+  const S21Matrix b = SparsePattern(50, 40, 5, 3, 7);
+  const S21Matrix ab = naive_multiply(a, b);
+  const S21Matrix bt_at = naive_multiply(b.Transpose(), a.Transpose());
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    const S21SparseMatrix sa(a, 0, format);
+    EXPECT_TRUE((sa * b).EqMatrix(ab));
+    EXPECT_TRUE((b.Transpose() * sa.Transpose()).EqMatrix(bt_at));
+  }
+  ASSERT_THROW(S21SparseMatrix(a) * a, std::invalid_argument);
+  ASSERT_THROW(b * S21SparseMatrix(b), std::invalid_argument);
+  S21SetThreadCount(threads);
+  S21SetParallelThreshold(threshold);
+}
+
+TEST(S21MatrixTest, SparseSparseProduct) {
+  const int threads = S21GetThreadCount();
+  const long long threshold = S21GetParallelThreshold();
+  S21SetThreadCount(4);
+  S21SetParallelThreshold(0);
+  const S21Matrix a = SparsePattern(60, 50, 7, 13, 9);
+  const S21Matrix b = SparsePattern(50, 40, 5, 3, 7);
+  const S21Matrix ab = naive_multiply(a, b);
+  for (S21SparseFormat lhs : {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    const S21SparseMatrix sa(a, 0, lhs);
+    for (S21SparseFormat rhs :
+         {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+      const S21SparseMatrix product = sa * S21SparseMatrix(b, 0, rhs);
+      EXPECT_EQ(product.Format(), lhs == rhs ? lhs : S21SparseFormat::kCsr);
+      EXPECT_TRUE(product.ToDense().EqMatrix(ab));
+    }
+  }
+  ASSERT_THROW(S21SparseMatrix(a) * S21SparseMatrix(a), std::invalid_argument);
+  S21SetThreadCount(threads);
+  S21SetParallelThreshold(threshold);
+}
+
+TEST(S21MatrixTest, SparseComplex) {
+  const std::complex<double> i(0, 1);
+  const S21BasicSparseMatrix<std::complex<double> > rotation(
+      2, 2, {{0, 1, i}, {1, 0, i}});
+  const S21BasicSparseMatrix<std::complex<double> > square =
+      rotation * rotation;
+  EXPECT_EQ(square.Coeff(0, 0), -1.0);
+  EXPECT_EQ(square.Coeff(1, 1), -1.0);
+  EXPECT_EQ(square.Coeff(0, 1), 0.0);
+}
+
+// Удаляет файл при выходе из области видимости, в том числе когда тест
+// прерван неудачной проверкой ASSERT_*
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string& path) : path_(path) {}
+  TemporaryFile(const TemporaryFile&) = delete;
+  TemporaryFile& operator=(const TemporaryFile&) = delete;
+  ~TemporaryFile() { std::remove(path_.c_str()); }
+
+  const std::string& Path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+const char kBinaryPath[] = "unit_test_matrix.s21m";
+
+S21Matrix SaveSample(const std::string& path) {
+  const S21Matrix matrix = uniform_matrix(37, 53);
+  S21SaveMatrix(path, matrix);
+  return matrix;
+}
+
+std::vector<char> ReadBytes(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>());
+}
+
+void WriteBytes(const std::string& path, const std::vector<char>& content) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), content.size());
+}
+
+TEST(S21MatrixTest, BinaryIORoundTrip) {
+  const TemporaryFile file(kBinaryPath);
+  const S21Matrix matrix = SaveSample(file.Path());
+  EXPECT_EQ(S21LoadMatrix(file.Path()), matrix);
+  ASSERT_THROW(S21LoadMatrix<float>(file.Path()), std::runtime_error);
+  ASSERT_THROW(S21LoadMatrix("missing.s21m"), std::runtime_error);
+}
+
+TEST(S21MatrixTest, BinaryIOMapped) {
+  const TemporaryFile file(kBinaryPath);
+  const S21Matrix matrix = SaveSample(file.Path());
+  const S21MappedMatrix mapped(file.Path());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.Data()) %
+                S21MatrixFileFormat::kDataAlignment,
+            0u);
+  EXPECT_TRUE(mapped.View() == matrix);
+  EXPECT_TRUE(mapped.VerifyChecksum());
+}
+
+// Файл, записанный на машине с другим порядком байтов
+TEST(S21MatrixTest, BinaryIOByteSwapped) {
+  const TemporaryFile file(kBinaryPath);
+  const S21Matrix matrix = SaveSample(file.Path());
+  std::vector<char> swapped = ReadBytes(file.Path());
+  for (std::size_t offset : {8, 10}) {
+    std::reverse(swapped.begin() + offset, swapped.begin() + offset + 2);
+  }
+  for (std::size_t offset = S21MatrixFileFormat::kHeaderSize;
+       offset < swapped.size(); offset += 8) {
+    std::reverse(swapped.begin() + offset, swapped.begin() + offset + 8);
+  }
+  s21::detail::Checksum64 swapped_checksum;
+  swapped_checksum.Update(swapped.data() + S21MatrixFileFormat::kHeaderSize,
+                          swapped.size() - S21MatrixFileFormat::kHeaderSize);
+  const std::uint64_t checksum_value = swapped_checksum.Value();
+  std::memcpy(swapped.data() + 40, &checksum_value, sizeof(checksum_value));
+  for (std::size_t offset : {16, 24, 32, 40}) {
+    std::reverse(swapped.begin() + offset, swapped.begin() + offset + 8);
+  }
+  WriteBytes(file.Path(), swapped);
+  EXPECT_EQ(S21LoadMatrix(file.Path()), matrix);
+  ASSERT_THROW(S21MappedMatrix mapped(file.Path()), std::runtime_error);
+}
+
+TEST(S21MatrixTest, BinaryIOCorrupted) {
+  const TemporaryFile file(kBinaryPath);
+  SaveSample(file.Path());
+  std::vector<char> corrupted = ReadBytes(file.Path());
+  corrupted[S21MatrixFileFormat::kHeaderSize + 100] ^= 1;
+  WriteBytes(file.Path(), corrupted);
+  ASSERT_THROW(S21LoadMatrix(file.Path()), std::runtime_error);
+  EXPECT_FALSE(S21MappedMatrix(file.Path()).VerifyChecksum());
+}
+
+TEST(S21MatrixTest, BinaryIOTruncated) {
+  const TemporaryFile file(kBinaryPath);
+  SaveSample(file.Path());
+  const std::vector<char> bytes = ReadBytes(file.Path());
+  WriteBytes(file.Path(), std::vector<char>(bytes.begin(), bytes.end() - 8));
+  ASSERT_THROW(S21LoadMatrix(file.Path()), std::runtime_error);
+  ASSERT_THROW(S21MappedMatrix mapped(file.Path()), std::runtime_error);
+}
+
+TEST(S21MatrixTest, BinaryIOWriter) {
+  const TemporaryFile file(kBinaryPath);
+  const S21Matrix matrix = uniform_matrix(37, 53);
+  const S21Matrix transpose = matrix.Transpose();
+  {
+    S21MatrixWriter writer(file.Path(), matrix.Cols(), matrix.Rows());
+    writer.WriteRow(transpose.Data());
+    writer.WriteRows(matrix.TransposedView().Block(1, 0, 20, matrix.Rows()));
+    ASSERT_THROW(writer.Close(), std::runtime_error);
+    ASSERT_THROW(writer.WriteRows(matrix.View()), std::invalid_argument);
+    writer.WriteRows(matrix.TransposedView().Block(21, 0, 32, matrix.Rows()));
+    ASSERT_THROW(writer.WriteRow(matrix.Data()), std::out_of_range);
+    writer.Close();
+  }
+  EXPECT_EQ(S21LoadMatrix(file.Path()), transpose);
+}
+
+TEST(S21MatrixTest, BinaryIOComplex) {
+  const TemporaryFile file(kBinaryPath);
+  const std::complex<double> data[] = {{1, 2}, {3, -4}, {0.5, 0}};
+  const S21BasicMatrix<std::complex<double> > complex(1, 3, data);
+  S21SaveMatrix(file.Path(), complex);
+  EXPECT_EQ(S21LoadMatrix<std::complex<double> >(file.Path()), complex);
+}
+
+TEST(S21MatrixTest, BinaryIOEmpty) {
+  const TemporaryFile file(kBinaryPath);
+  S21SaveMatrix(file.Path(), S21Matrix());
+  EXPECT_EQ(S21LoadMatrix(file.Path()).Rows(), 0);
+}
+
+TEST(S21MatrixTest, BinaryIOChecksum) {
+  s21::detail::Checksum64 checksum;
+  EXPECT_EQ(checksum.Value(), 0xEF46DB3751D8E999ULL);
+  checksum.Update("a", 1);
+  checksum.Update("bc", 2);
+  EXPECT_EQ(checksum.Value(), 0x44BC2CF5AD770999ULL);
+}
+
+const char kTextPath[] = "unit_test_matrix.txt";
+
+bool ExactEqual(const S21Matrix& lhs, const S21Matrix& rhs) {
+  bool equal = lhs.Rows() == rhs.Rows() && lhs.Cols() == rhs.Cols();
+  for (int i = 0; equal && i < lhs.Rows(); ++i) {
+    for (int j = 0; j < lhs.Cols(); ++j) {
+      equal = equal && lhs(i, j) == rhs(i, j);
+    }
+  }
+  return equal;
+}
+
+// Больше одной порции чтения (1 МиБ) в обоих форматах
+S21Matrix LargeTextMatrix() {
+  S21Matrix matrix(6000, 13);
+  fill_uniform(matrix);
+  matrix(3, 4) = 1e300;
+  matrix(5, 6) = -0.0;
+  return matrix;
+}
+
+void WriteText(const std::string& text) {
+  std::ofstream out(kTextPath, std::ios::binary | std::ios::trunc);
+  out << text;
+}
+
+template <typename ReadOp>
+auto ReadText(const std::string& text, ReadOp read_action)
+    -> decltype(read_action(kTextPath)) {
+  const TemporaryFile file(kTextPath);
+  WriteText(text);
+  return read_action(kTextPath);
+}
+
+template <typename ReadOp>
+auto ReadTextParallel(const std::string& text, ReadOp read_action)
+    -> decltype(read_action(kTextPath)) {
+  const int threads = S21GetThreadCount();
+  const long long threshold = S21GetParallelThreshold();
+  S21SetThreadCount(4);
+  S21SetParallelThreshold(0);
+  auto result = ReadText(text, read_action);
+  S21SetThreadCount(threads);
+  S21SetParallelThreshold(threshold);
+  return result;
+}
+
+template <typename ReadOp>
+void TestTextReadFailure(const std::string& text, ReadOp read_action) {
+  const TemporaryFile file(kTextPath);
+  WriteText(text);
+  EXPECT_THROW(read_action(kTextPath), std::runtime_error);
+}
+
+S21Matrix ReadCsvFile(const char* path) { return S21ReadCsv(path); }
+
+S21Matrix ReadMarketFile(const char* path) {
+  return S21ReadMatrixMarket(path);
+}
+
+TEST(S21MatrixTest, TextIOCsvRoundTrip) {
+  const S21Matrix matrix = LargeTextMatrix();
+  std::ostringstream csv;
+  S21WriteCsv(csv, matrix);
+  EXPECT_TRUE(ExactEqual(ReadTextParallel(csv.str(), ReadCsvFile), matrix));
+}
+
+TEST(S21MatrixTest, TextIOCsvDelimiter) {
+  const S21Matrix matrix = LargeTextMatrix();
+  const S21Matrix block = matrix.View().Block(10, 2, 5, 3);
+  std::ostringstream tsv;
+  S21WriteCsv(tsv, block, '\t');
+  const S21Matrix result = ReadTextParallel(
+      tsv.str(), [](const char* path) { return S21ReadCsv(path, '\t'); });
+  EXPECT_TRUE(ExactEqual(result, block));
+}
+
+TEST(S21MatrixTest, TextIOCsvParse) {
+  const std::string text = "1, 2,3\r\n\n +4,5e0 ,-6\n7,8,9";
+  const double expected_data[] = {1, 2, 3, 4, 5, -6, 7, 8, 9};
+  EXPECT_EQ(ReadText(text, ReadCsvFile), S21Matrix(3, 3, expected_data));
+  const S21BasicMatrix<float> result =
+      ReadText(text, [](const char* path) { return S21ReadCsv<float>(path); });
+  EXPECT_EQ(result(1, 2), -6.0f);
+}
+
+TEST(S21MatrixTest, TextIOCsvSpaceDelimiter) {
+  const double expected_data[] = {1, 2, 3, 4, 5, -6, 7, 8, 9};
+  const S21Matrix result =
+      ReadText("1  2\t 3\n4 5 -6\n7 8 9\n",
+               [](const char* path) { return S21ReadCsv(path, ' '); });
+  EXPECT_EQ(result, S21Matrix(3, 3, expected_data));
+}
+
+TEST(S21MatrixTest, TextIOCsvOutOfRange) {
+  const S21Matrix extreme = ReadText("1e999,-1e999,1e-999\n", ReadCsvFile);
+  EXPECT_TRUE(std::isinf(extreme(0, 0)) && extreme(0, 0) > 0);
+  EXPECT_TRUE(std::isinf(extreme(0, 1)) && extreme(0, 1) < 0);
+  EXPECT_EQ(extreme(0, 2), 0.0);
+}
+
+TEST(S21MatrixTest, TextIOCsvMalformed) {
+  for (const char* text : {"1,2\n3\n", "1,2\n3,4,5\n", "1,x\n", "1,,2\n",
+                           "1,2 3\n", "1,+-2\n"}) {
+    TestTextReadFailure(text, ReadCsvFile);
+  }
+}
+
+TEST(S21MatrixTest, TextIOCsvEmpty) {
+  EXPECT_EQ(ReadText("", ReadCsvFile).Rows(), 0);
+  ASSERT_THROW(S21ReadCsv("missing.csv"), std::runtime_error);
+}
+
+TEST(S21MatrixTest, TextIOMatrixMarketArray) {
+  const S21Matrix matrix = LargeTextMatrix();
+  std::ostringstream market;
+  S21WriteMatrixMarket(market, matrix);
+  EXPECT_TRUE(
+      ExactEqual(ReadTextParallel(market.str(), ReadMarketFile), matrix));
+  const S21SparseMatrix sparse = ReadTextParallel(
+      market.str(),
+      [](const char* path) { return S21ReadMatrixMarketSparse(path); });
+  EXPECT_TRUE(ExactEqual(sparse.ToDense(), matrix));
+}
+
+TEST(S21MatrixTest, TextIOMatrixMarketCoordinate) {
+  S21Matrix dense(40, 30);
+  dense(0, 0) = 1.5;
+  dense(39, 29) = -2;
+  dense(7, 3) = 0.1;
+  std::ostringstream coordinate;
+  S21WriteMatrixMarket(coordinate, S21SparseMatrix(dense));
+  EXPECT_EQ(ReadText(coordinate.str(), ReadMarketFile), dense);
+  const S21SparseMatrix csc =
+      ReadText(coordinate.str(), [](const char* path) {
+        return S21ReadMatrixMarketSparse(path, S21SparseFormat::kCsc);
+      });
+  EXPECT_EQ(csc.Format(), S21SparseFormat::kCsc);
+  EXPECT_EQ(csc.NonZeros(), 3);
+  EXPECT_EQ(csc.ToDense(), dense);
+}
+
+TEST(S21MatrixTest, TextIOMatrixMarketSymmetric) {
+  const std::string text =
+      "%%MatrixMarket matrix coordinate real symmetric\n"
+      "% comment\n3 3 3\n1 1 4\n3 1 -1\n3 2 2.5\n";
+  const double symmetric_data[] = {4, 0, -1, 0, 0, 2.5, -1, 2.5, 0};
+  EXPECT_EQ(ReadText(text, ReadMarketFile), S21Matrix(3, 3, symmetric_data));
+  const S21SparseMatrix sparse = ReadText(text, [](const char* path) {
+    return S21ReadMatrixMarketSparse(path);
+  });
+  EXPECT_EQ(sparse.NonZeros(), 5);
+}
+
+TEST(S21MatrixTest, TextIOMatrixMarketSkewSymmetric) {
+  const std::string text =
+      "%%MatrixMarket matrix array integer skew-symmetric\n"
+      "3 3\n1\n2\n3\n";
+  const double skew_data[] = {0, -1, -2, 1, 0, -3, 2, 3, 0};
+  EXPECT_EQ(ReadText(text, ReadMarketFile), S21Matrix(3, 3, skew_data));
+}
+
+TEST(S21MatrixTest, TextIOMatrixMarketPattern) {
+  const std::string text =
+      "%%MatrixMarket Matrix Coordinate Pattern General\n"
+      "2 3 2\n1 3\n2 1\n";
+  const double pattern_data[] = {0, 0, 1, 1, 0, 0};
+  EXPECT_EQ(ReadText(text, ReadMarketFile), S21Matrix(2, 3, pattern_data));
+}
+
+TEST(S21MatrixTest, TextIOMatrixMarketMalformed) {
+  for (const char* text :
+       {"%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n",
+        "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n",
+        "%%MatrixMarket matrix array real general\n1 1\n1\n2\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n",
+        "%%MatrixMarket matrix coordinate real symmetric\n2 3 0\n",
+        "% comment\n%%MatrixMarket matrix array real general\n1 1\n1\n",
+        "%%MatrixMarket matrix array real general\n1 1\n1 2\n"}) {
+    TestTextReadFailure(text, ReadMarketFile);
+  }
+}
+
+const int kBatchSize = 21;
+const int kBatchOrder = 5;
+
+S21MatrixBatch RandomBatch(int rows, int cols,
+                           std::vector<S21Matrix>* matrices) {
+  S21MatrixBatch batch(kBatchSize, rows, cols);
+  matrices->assign(kBatchSize, S21Matrix(rows, cols));
+  for (int index = 0; index < kBatchSize; ++index) {
+    fill_uniform((*matrices)[index]);
+    batch.Set(index, (*matrices)[index]);
+  }
+  return batch;
+}
+
+TEST(S21MatrixTest, MatrixBatchStorage) {
+  const int n = kBatchOrder;
+  std::vector<S21Matrix> a;
+  const S21MatrixBatch batch_a = RandomBatch(n, n, &a);
+  EXPECT_EQ(batch_a.Groups(), 3);
+  EXPECT_EQ(batch_a.Get(7), a[7]);
+  EXPECT_EQ(batch_a(9, 1, 2), a[9](1, 2));
+  EXPECT_EQ(batch_a.Data()[(n * n + 1 * n + 2) * S21MatrixBatch::kLanes + 1],
+            a[9](1, 2));
+}
+
+TEST(S21MatrixTest, MatrixBatchCopyMove) {
+  std::vector<S21Matrix> a;
+  const S21MatrixBatch batch_a = RandomBatch(kBatchOrder, kBatchOrder, &a);
+  S21MatrixBatch copy = batch_a;
+  S21MatrixBatch moved = std::move(copy);
+  EXPECT_EQ(copy.Data(), nullptr);
+  EXPECT_EQ(moved.Get(20), a[20]);
+  copy = moved;
+  moved = S21MatrixBatch();
+  EXPECT_EQ(copy.Get(3), a[3]);
+}
+
+TEST(S21MatrixTest, MatrixBatchErrors) {
+  const int n = kBatchOrder;
+  std::vector<S21Matrix> a, b;
+  S21MatrixBatch batch_a = RandomBatch(n, n, &a);
+  const S21MatrixBatch batch_b = RandomBatch(n, 3, &b);
+  ASSERT_THROW(batch_a(kBatchSize, 0, 0), std::out_of_range);
+  ASSERT_THROW(batch_a(0, n, 0), std::out_of_range);
+  ASSERT_THROW(batch_a.Get(-1), std::out_of_range);
+  ASSERT_THROW(batch_a.Set(0, b[0]), std::invalid_argument);
+  ASSERT_THROW(S21MatrixBatch(-1, 2, 2), std::invalid_argument);
+  ASSERT_THROW(batch_b * batch_a, std::invalid_argument);
+  ASSERT_THROW(batch_b.Determinant(), std::invalid_argument);
+  ASSERT_THROW(batch_a.Solve(S21MatrixBatch(kBatchSize, 4, 1)),
+               std::invalid_argument);
+  ASSERT_THROW(batch_a.Solve(S21MatrixBatch(kBatchSize + 1, n, 1)),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, MatrixBatchOperations) {
+  const int n = kBatchOrder;
+  std::vector<S21Matrix> a, b;
+  const S21MatrixBatch batch_a = RandomBatch(n, n, &a);
+  const S21MatrixBatch batch_b = RandomBatch(n, 3, &b);
+  const int threads = S21GetThreadCount();
+  const long long threshold = S21GetParallelThreshold();
+  S21SetThreadCount(4);
+  S21SetParallelThreshold(0);
+  const S21SimdLevel detected = S21DetectSimdLevel();
+  for (S21SimdLevel level : {S21SimdLevel::kScalar, S21SimdLevel::kAvx2,
+                             S21SimdLevel::kAvx512}) {
+    S21SetSimdLevel(level);
+    const S21MatrixBatch product = batch_a * batch_b;
+    const std::vector<double> det = batch_a.Determinant();
+    const S21MatrixBatch inverse = batch_a.InverseMatrix();
+    const S21MatrixBatch solution = batch_a.Solve(batch_b);
+    ASSERT_EQ(det.size(), static_cast<std::size_t>(kBatchSize));
+    for (int index = 0; index < kBatchSize; ++index) {
+      EXPECT_EQ(product.Get(index), a[index] * b[index]);
+      EXPECT_NEAR(det[index], a[index].Determinant(), 1e-9);
+      EXPECT_EQ(inverse.Get(index), a[index].InverseMatrix());
+      EXPECT_EQ(solution.Get(index), a[index].Solve(b[index]));
+    }
+  }
+  S21SetSimdLevel(detected);
+  S21SetThreadCount(threads);
+  S21SetParallelThreshold(threshold);
+}
+
+TEST(S21MatrixTest, MatrixBatchSingular) {
+  const int n = kBatchOrder;
+  std::vector<S21Matrix> a, b;
+  S21MatrixBatch batch_a = RandomBatch(n, n, &a);
+  const S21MatrixBatch batch_b = RandomBatch(n, 3, &b);
+  const int threads = S21GetThreadCount();
+  const long long threshold = S21GetParallelThreshold();
+  S21SetThreadCount(4);
+  S21SetParallelThreshold(0);
+  S21Matrix singular = a[4];
+  for (int j = 0; j < n; ++j) {
+    singular(3, j) = 2 * singular(1, j);
+  }
+  batch_a.Set(4, singular);
+  EXPECT_NEAR(batch_a.Determinant()[4], 0.0, 1e-12);
+  EXPECT_NEAR(batch_a.Determinant()[5], a[5].Determinant(), 1e-9);
+  try {
+    batch_a.InverseMatrix();
+    ADD_FAILURE() << "InverseMatrix accepted a singular matrix";
+  } catch (const std::invalid_argument& error) {
+    EXPECT_STREQ(error.what(), "Matrix is singular and cannot be inverted.");
+  }
+  try {
+    batch_a.Solve(batch_b);
+    ADD_FAILURE() << "Solve accepted a singular matrix";
+  } catch (const std::invalid_argument& error) {
+    EXPECT_STREQ(error.what(),
+                 "Matrix is singular; the system has no unique solution.");
+  }
+  S21SetThreadCount(threads);
+  S21SetParallelThreshold(threshold);
+}
+
+TEST(S21MatrixTest, MatrixBatchPivoting) {
+  const float swap_data[] = {0, 1, 1, 0};
+  S21BasicMatrixBatch<float> swaps(1, 2, 2);
+  swaps.Set(0, S21BasicMatrix<float>(2, 2, swap_data));
+  EXPECT_EQ(swaps.Determinant()[0], -1.0f);
+  EXPECT_EQ(swaps.InverseMatrix().Get(0), swaps.Get(0));
+}
+
+TEST(S21MatrixTest, MatrixBatchEmpty) {
+  EXPECT_TRUE(S21MatrixBatch().Determinant().empty());
+  EXPECT_EQ(S21MatrixBatch(3, 0, 0).Determinant(),
+            std::vector<double>(3, 1.0));
+}
+
+TEST(S21MatrixTest, StrassenMultiply) {
+  const S21MultiplyMode mode = S21GetMultiplyMode();
+  const int crossover = S21GetStrassenCrossover();
+  EXPECT_EQ(mode, S21MultiplyMode::kFast);
+  S21SetStrassenCrossover(1);
+  EXPECT_EQ(S21GetStrassenCrossover(), 16);
+  for (int m : {40, 67}) {
+    for (int n : {64, 71}) {
+      for (int k : {48, 99}) {
+        S21Matrix a(m, k), b(k, n);
+        fill_uniform(a);
+        fill_uniform(b);
+        const S21Matrix expected = naive_multiply(a, b);
+        EXPECT_EQ(a * b, expected);
+        const S21Matrix a_t = a.Transpose();
+        EXPECT_EQ(a_t.TransposedView() * b, expected);
+
+        S21Matrix c(m, n);
+        fill_uniform(c);
+        S21Matrix d = c;
+        s21::detail::StrassenGemm(m, n, k, 2.0, a.Data(), a.Stride(), 1,
+                                  b.Data(), b.Stride(), 1, 0.5, c.Data(),
+                                  c.Stride());
+        s21::detail::ClassicGemm(m, n, k, 2.0, a.Data(), a.Stride(), 1,
+                                 b.Data(), b.Stride(), 1, 0.5, d.Data(),
+                                 d.Stride());
+        EXPECT_EQ(c, d);
+      }
+    }
+  }
+  S21BasicMatrix<float> a(90, 90), b(90, 90);
+  for (int i = 0; i < 90; ++i) {
+    for (int j = 0; j < 90; ++j) {
+      a(i, j) = static_cast<float>((i * 7 + j * 3) % 11) / 11;
+      b(i, j) = static_cast<float>((i * 5 + j) % 13) / 13;
+    }
+  }
+  const S21BasicMatrix<float> fast = a * b;
+  S21SetMultiplyMode(S21MultiplyMode::kAccurate);
+  EXPECT_EQ(S21GetMultiplyMode(), S21MultiplyMode::kAccurate);
+  EXPECT_TRUE(fast == a * b);
+  S21SetMultiplyMode(mode);
+  S21SetStrassenCrossover(crossover);
+}
+
+TEST(S21MatrixTest, FusedGemm) {
+  S21Matrix a(23, 17), b(17, 31), c(23, 31);
+  fill_uniform(a);
+  fill_uniform(b);
+  fill_uniform(c);
+  const S21Matrix a_t = a.Transpose(), b_t = b.Transpose();
+  const S21Matrix expected = c + naive_multiply(a, b) * 2.0;
+  const S21Transpose no = S21Transpose::kNoTrans, tr = S21Transpose::kTrans;
+
+  S21Matrix d = c;
+  S21Gemm(2.0, a, no, b, no, 1.0, &d);
+  EXPECT_EQ(d, expected);
+  d = c;
+  S21Gemm(2.0, a_t, tr, b, no, 1.0, &d);
+  EXPECT_EQ(d, expected);
+  d = c;
+  S21Gemm(2.0, a, no, b_t, tr, 1.0, &d);
+  EXPECT_EQ(d, expected);
+  d = c;
+  S21Gemm(2.0, a_t.View(), tr, b_t.View(), tr, 1.0, &d);
+  EXPECT_EQ(d, expected);
+  d = c;
+  S21Gemm(1.0, a.Block(0, 0, 23, 17), no, b, no, -0.5, &d);
+  EXPECT_EQ(d, naive_multiply(a, b) - c * 0.5);
+
+  S21Matrix e;
+  S21Gemm(1.0, a, no, b, no, 0.0, &e);
+  EXPECT_EQ(e, naive_multiply(a, b));
+  S21Matrix f(23, 31);
+  f(0, 0) = std::numeric_limits<double>::quiet_NaN();
+  S21Gemm(1.0, a, no, b, no, 0.0, &f);
+  EXPECT_EQ(f, e);
+
+  S21Matrix g = a * a_t;
+  const S21Matrix h = g;
+  S21Gemm(1.0, g, no, g, tr, 1.0, &g);
+  EXPECT_EQ(g, h + naive_multiply(h, h.Transpose()));
+  S21Matrix s = a;
+  S21Gemm(1.0, s, tr, s, no, 0.0, &s);
+  EXPECT_EQ(s, naive_multiply(a_t, a));
+
+  EXPECT_THROW(S21Gemm(1.0, a, no, b, tr, 0.0, &e), std::invalid_argument);
+  EXPECT_THROW(S21Gemm(1.0, a, no, b, no, 1.0, &s), std::invalid_argument);
+}
+
+S21Matrix DominantMatrix(int n) {
+  S21Matrix matrix = uniform_matrix(n, n);
+  for (int i = 0; i < n; ++i) {
+    matrix(i, i) += 16.0;
+  }
+  return matrix;
+}
+
+template <typename Op>
+auto ComputeNative(Op op) -> decltype(op()) {
+  const S21Backend backend = S21GetBackend();
+  S21SetBackend(S21Backend::kNative);
+  EXPECT_EQ(S21GetBackend(), S21Backend::kNative);
+  auto result = op();
+  S21SetBackend(backend);
+  return result;
+}
+
+TEST(S21MatrixTest, BackendSelection) {
+  const S21Backend backend = S21GetBackend();
+  EXPECT_EQ(backend, S21HasBlas() ? S21Backend::kBlas : S21Backend::kNative);
+  S21SetBackend(S21Backend::kBlas);
+  EXPECT_EQ(S21GetBackend(), backend);
+  S21SetBackend(S21Backend::kNative);
+  EXPECT_EQ(S21GetBackend(), S21Backend::kNative);
+  S21SetBackend(backend);
+}
+
+TEST(S21MatrixTest, BackendMultiply) {
+  const S21Matrix a = DominantMatrix(150);
+  const S21Matrix b = uniform_matrix(150, 40);
+  const S21Matrix a_t = a.Transpose();
+  const S21Matrix product = ComputeNative([&] { return a * b; });
+  EXPECT_EQ(a * b, product);
+  EXPECT_EQ(product, naive_multiply(a, b));
+  EXPECT_EQ(a_t.TransposedView() * b,
+            ComputeNative([&] { return a_t.TransposedView() * b; }));
+}
+
+TEST(S21MatrixTest, BackendGemm) {
+  const S21Matrix a_t = DominantMatrix(150).Transpose();
+  const S21Matrix b = uniform_matrix(150, 40);
+  const S21Matrix c = uniform_matrix(150, 40);
+  const auto gemm = [&] {
+    S21Matrix d = c;
+    S21Gemm(2.0, a_t, S21Transpose::kTrans, b, S21Transpose::kNoTrans, -1.0,
+            &d);
+    return d;
+  };
+  EXPECT_EQ(gemm(), ComputeNative(gemm));
+}
+
+TEST(S21MatrixTest, BackendDeterminant) {
+  const S21Matrix a = DominantMatrix(150);
+  const double det = ComputeNative([&] { return a.Determinant(); });
+  EXPECT_NEAR(a.Determinant() / det, 1.0, 1e-9);
+}
+
+TEST(S21MatrixTest, BackendInverse) {
+  const S21Matrix a = DominantMatrix(150);
+  EXPECT_EQ(a.InverseMatrix(),
+            ComputeNative([&] { return a.InverseMatrix(); }));
+}
+
+TEST(S21MatrixTest, BackendSolve) {
+  const S21Matrix a = DominantMatrix(150);
+  const S21Matrix b = uniform_matrix(150, 40);
+  const S21Matrix solution = ComputeNative([&] { return a.Solve(b); });
+  EXPECT_EQ(a.Solve(b), solution);
+  EXPECT_EQ(a * solution, b);
+}
+
+TEST(S21MatrixTest, BackendSolveTriangular) {
+  const S21Matrix a = DominantMatrix(150);
+  const S21Matrix b = uniform_matrix(150, 40);
+  const auto solve = [&] {
+    return a.Solve(b, S21MatrixStructure::kLowerTriangular);
+  };
+  EXPECT_EQ(solve(), ComputeNative(solve));
+}
+
+TEST(S21MatrixTest, BackendSingular) {
+  S21Matrix singular = uniform_matrix(120, 120);
+  for (int j = 0; j < 120; ++j) {
+    singular(119, j) = singular(0, j);
+  }
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+}
+
+template <class T>
+S21BasicMatrix<T> IdentityMatrix(int n) {
+  S21BasicMatrix<T> identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    identity(i, i) = T(1);
+  }
+  return identity;
+}
+
+// A = B * B^T + n * I положительно определена
+S21Matrix PositiveDefiniteMatrix(int n) {
+  const S21Matrix b = uniform_matrix(n, n);
+  S21Matrix a = b * b.Transpose();
+  for (int i = 0; i < n; ++i) {
+    a(i, i) += n;
+  }
+  return a;
+}
+
+// C = diag(A11, -A22) - симметричная, но знаконеопределённая
+S21Matrix IndefiniteMatrix(int n) {
+  const S21Matrix a = PositiveDefiniteMatrix(n);
+  S21Matrix c(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      if (i < n / 2 && j < n / 2) {
+        c(i, j) = a(i, j);
+      } else if (i >= n / 2 && j >= n / 2) {
+        c(i, j) = -a(i, j);
+      }
+    }
+  }
+  return c;
+}
+
+ComplexMatrix UniformComplexMatrix(int rows, int cols) {
+  const S21Matrix re = uniform_matrix(rows, cols);
+  const S21Matrix im = uniform_matrix(rows, cols);
+  ComplexMatrix z(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      z(i, j) = Complex(re(i, j), im(i, j));
+    }
+  }
+  return z;
+}
+
+ComplexMatrix ConjugateTranspose(const ComplexMatrix& matrix) {
+  ComplexMatrix result(matrix.Cols(), matrix.Rows());
+  for (int i = 0; i < matrix.Rows(); ++i) {
+    for (int j = 0; j < matrix.Cols(); ++j) {
+      result(j, i) = std::conj(matrix(i, j));
+    }
+  }
+  return result;
+}
+
+// Эрмитова матрица H = Z * Z^H + m * I
+ComplexMatrix HermitianMatrix(int m) {
+  const ComplexMatrix z = UniformComplexMatrix(m, m);
+  ComplexMatrix h = z * ConjugateTranspose(z);
+  for (int i = 0; i < m; ++i) {
+    h(i, i) += static_cast<double>(m);
+  }
+  return h;
+}
+
+TEST(S21MatrixTest, DetectStructureSymmetric) {
+  EXPECT_EQ(PositiveDefiniteMatrix(150).DetectStructure(),
+            S21MatrixStructure::kSymmetric);
+  EXPECT_EQ(IndefiniteMatrix(150).DetectStructure(),
+            S21MatrixStructure::kSymmetric);
+  EXPECT_EQ(uniform_matrix(150, 150).DetectStructure(),
+            S21MatrixStructure::kGeneral);
+  EXPECT_EQ(HermitianMatrix(90).DetectStructure(),
+            S21MatrixStructure::kSymmetric);
+  EXPECT_NE(UniformComplexMatrix(90, 90).DetectStructure(),
+            S21MatrixStructure::kSymmetric);
+}
+
+TEST(S21MatrixTest, CholeskyFactor) {
+  const S21Matrix a = PositiveDefiniteMatrix(150);
+  const S21Cholesky cholesky = a.Cholesky();
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  const S21Matrix l = cholesky.L();
+  EXPECT_EQ(l.DetectStructure(), S21MatrixStructure::kLowerTriangular);
+  EXPECT_EQ(l * l.Transpose(), a);
+}
+
+TEST(S21MatrixTest, CholeskyInverse) {
+  const S21Matrix a = PositiveDefiniteMatrix(150);
+  const S21Matrix inverse = a.InverseMatrix();
+  EXPECT_EQ(inverse, a.Cholesky().InverseMatrix());
+  EXPECT_EQ(inverse, inverse.Transpose());
+  EXPECT_EQ(a * inverse, IdentityMatrix<double>(150));
+}
+
+TEST(S21MatrixTest, CholeskySolve) {
+  const S21Matrix a = PositiveDefiniteMatrix(150);
+  const S21Matrix rhs = uniform_matrix(150, 7);
+  EXPECT_EQ(a.Solve(rhs), a.Solve(rhs, S21MatrixStructure::kGeneral));
+  EXPECT_EQ(a.Solve(rhs, S21MatrixStructure::kPositiveDefinite),
+            a.Cholesky().Solve(rhs));
+  EXPECT_EQ(a * a.Solve(rhs), rhs);
+}
+
+TEST(S21MatrixTest, CholeskyDeterminant) {
+  S21Matrix scaled = PositiveDefiniteMatrix(150);
+  scaled.MulNumber(1.0 / 150);
+  EXPECT_NEAR(scaled.Determinant() / scaled.LU().Determinant(), 1.0, 1e-9);
+}
+
+TEST(S21MatrixTest, CholeskyIndefinite) {
+  const S21Matrix c = IndefiniteMatrix(150);
+  const S21Matrix rhs = uniform_matrix(150, 7);
+  EXPECT_FALSE(c.Cholesky().IsPositiveDefinite());
+  EXPECT_THROW(c.Cholesky().L(), std::invalid_argument);
+  EXPECT_THROW(c.Solve(rhs, S21MatrixStructure::kPositiveDefinite),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CholeskyIndefiniteFallback) {
+  const S21Matrix c = IndefiniteMatrix(150);
+  const S21Matrix rhs = uniform_matrix(150, 7);
+  EXPECT_EQ(c.Solve(rhs), c.Solve(rhs, S21MatrixStructure::kGeneral));
+  EXPECT_EQ(c * c.InverseMatrix(), IdentityMatrix<double>(150));
+  S21Matrix scaled = c;
+  scaled.MulNumber(1.0 / 150);
+  EXPECT_NEAR(scaled.Determinant() / scaled.LU().Determinant(), 1.0, 1e-9);
+}
+
+// Переход к LU после неудачи Холецкого не выделяет второй матрицы
+TEST(S21MatrixTest, CholeskyIndefiniteFallbackAllocation) {
+  const S21Matrix c = IndefiniteMatrix(150);
+  S21MatrixPool pool;
+  S21MatrixPoolScope scope(pool);
+  const S21Matrix inverse = c.InverseMatrix();
+  EXPECT_EQ(pool.Stats().misses, 1u);
+  EXPECT_EQ(inverse, c.Transpose().InverseMatrix().Transpose());
+}
+
+TEST(S21MatrixTest, CholeskyNonSquare) {
+  EXPECT_THROW(S21Matrix(3, 4).Cholesky(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CholeskyHermitian) {
+  const int m = 90;
+  const ComplexMatrix h = HermitianMatrix(m);
+  ComplexMatrix rhs(m, 3);
+  for (int i = 0; i < m; ++i) {
+    rhs(i, i % 3) = Complex(1.0, -2.0);
+  }
+  const ComplexMatrix l = h.Cholesky().L();
+  EXPECT_EQ(l * ConjugateTranspose(l), h);
+  EXPECT_EQ(h * h.InverseMatrix(), IdentityMatrix<Complex>(m));
+  EXPECT_EQ(h.Solve(rhs), h.Solve(rhs, S21MatrixStructure::kGeneral));
+}
+
+TEST(S21MatrixTest, QRFactor) {
+  const S21Matrix tall = uniform_matrix(180, 70);
+  const S21QR qr = tall.QR();
+  EXPECT_TRUE(qr.IsFullRank());
+  const S21Matrix q = qr.Q(), r = qr.R();
+  EXPECT_EQ(q.Rows(), 180);
+  EXPECT_EQ(q.Cols(), 70);
+  EXPECT_EQ(r.DetectStructure(), S21MatrixStructure::kUpperTriangular);
+  EXPECT_EQ(q * r, tall);
+  EXPECT_EQ(q.TransposedView() * q, IdentityMatrix<double>(70));
+}
+
+TEST(S21MatrixTest, QRSolve) {
+  const S21Matrix b = uniform_matrix(150, 150);
+  const S21Matrix rhs = uniform_matrix(150, 7);
+  EXPECT_EQ(b.QR().Solve(rhs), b.Solve(rhs));
+}
+
+TEST(S21MatrixTest, QRComplex) {
+  const ComplexMatrix wide = UniformComplexMatrix(40, 70);
+  const S21BasicQR<Complex> qr = wide.QR();
+  const ComplexMatrix q = qr.Q();
+  EXPECT_EQ(q * qr.R(), wide);
+  EXPECT_EQ(ConjugateTranspose(q) * q, IdentityMatrix<Complex>(40));
+}
+
+// Наименьшие квадраты против нормальных уравнений
+TEST(S21MatrixTest, LeastSquares) {
+  const S21Matrix tall = uniform_matrix(180, 70);
+  const S21Matrix y = uniform_matrix(180, 2);
+  const S21Matrix tall_t = tall.Transpose();
+  EXPECT_EQ(tall.LeastSquares(y), (tall_t * tall).Solve(tall_t * y));
+  EXPECT_THROW(tall_t.LeastSquares(S21Matrix(70, 1)), std::invalid_argument);
+  EXPECT_THROW(tall.LeastSquares(S21Matrix(150, 7)), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, LeastSquaresRankDeficient) {
+  S21Matrix deficient = uniform_matrix(180, 70);
+  for (int i = 0; i < deficient.Rows(); ++i) {
+    deficient(i, 50) = 2.0 * deficient(i, 3);
+  }
+  EXPECT_FALSE(deficient.QR().IsFullRank());
+  EXPECT_THROW(deficient.LeastSquares(uniform_matrix(180, 2)),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CachedInverse) {
+  const S21Matrix a = DominantMatrix(120);
+  const S21CachedInverse cache(a);
+  EXPECT_EQ(cache.Size(), 120);
+  EXPECT_EQ(cache.Inverse(), a.InverseMatrix());
+  EXPECT_LE(cache.Drift(), cache.DriftTolerance());
+}
+
+// Онлайн-сценарий: на каждом шаге меняется одна строка или столбец
+TEST(S21MatrixTest, CachedInverseReplace) {
+  const int n = 120;
+  const S21Matrix b = uniform_matrix(n, 3);
+  S21Matrix reference = DominantMatrix(n);
+  S21CachedInverse cache(reference);
+  S21Matrix row(1, n), column(n, 1);
+  for (int tick = 0; tick < 200; ++tick) {
+    fill_uniform(row);
+    fill_uniform(column);
+    const int index = tick * 7 % n;
+    row(0, index) += 16.0;
+    column(index, 0) += 16.0;
+    if (tick % 2 == 0) {
+      cache.ReplaceRow(index, row);
+      for (int j = 0; j < n; ++j) {
+        reference(index, j) = row(0, j);
+      }
+    } else {
+      cache.ReplaceColumn(index, column);
+      for (int i = 0; i < n; ++i) {
+        reference(i, index) = column(i, 0);
+      }
+    }
+  }
+  EXPECT_TRUE(cache.Matrix() == reference);
+  EXPECT_LE(cache.Drift(), cache.DriftTolerance());
+  EXPECT_EQ(cache.Inverse(), reference.InverseMatrix());
+  EXPECT_EQ(cache.Solve(b), reference.Solve(b));
+}
+
+// Вудбери: обновление ранга 3
+TEST(S21MatrixTest, CachedInverseUpdate) {
+  const S21Matrix u = uniform_matrix(120, 3), v = uniform_matrix(120, 3);
+  S21Matrix reference = DominantMatrix(120);
+  S21CachedInverse cache(reference);
+  cache.Update(u, v);
+  reference += u * v.Transpose();
+  EXPECT_EQ(cache.Matrix(), reference);
+  EXPECT_EQ(cache.Inverse(), reference.InverseMatrix());
+  EXPECT_EQ(cache.UpdatesSinceRefactorization(), 1);
+  EXPECT_EQ(cache.Refactorizations(), 0);
+}
+
+// Явный пересчёт сбрасывает счётчик обновлений
+TEST(S21MatrixTest, CachedInverseExplicitRefactorize) {
+  const S21Matrix u = uniform_matrix(120, 3), v = uniform_matrix(120, 3);
+  S21Matrix reference = DominantMatrix(120);
+  S21CachedInverse cache(reference);
+  cache.Update(u, v);
+  cache.Refactorize();
+  reference += u * v.Transpose();
+  EXPECT_EQ(cache.UpdatesSinceRefactorization(), 0);
+  EXPECT_EQ(cache.Refactorizations(), 1);
+  EXPECT_EQ(cache.Inverse(), reference.InverseMatrix());
+}
+
+// Нулевой порог: проверка отклонения вызывает пересчёт после каждого
+// обновления
+TEST(S21MatrixTest, CachedInverseRefactorize) {
+  S21Matrix row = uniform_matrix(1, 120);
+  row(0, 3) += 16.0;
+  S21CachedInverse strict(DominantMatrix(120), 0.0);
+  strict.ReplaceRow(3, row);
+  strict.Update(uniform_matrix(120, 3), uniform_matrix(120, 3));
+  EXPECT_EQ(strict.Refactorizations(), 2);
+  EXPECT_EQ(strict.UpdatesSinceRefactorization(), 0);
+}
+
+TEST(S21MatrixTest, CachedInverseSingular) {
+  const int n = 120;
+  S21CachedInverse cache(DominantMatrix(n));
+  S21Matrix row(1, n);
+  for (int j = 0; j < n; ++j) {
+    row(0, j) = cache.Matrix()(1, j);
+  }
+  EXPECT_THROW(cache.ReplaceRow(4, row), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CachedInverseErrors) {
+  const int n = 120;
+  S21CachedInverse cache(DominantMatrix(n));
+  const S21Matrix row(1, n), column(n, 1), u(n, 3), b(n, 3);
+  EXPECT_THROW(cache.ReplaceRow(n, row), std::out_of_range);
+  EXPECT_THROW(cache.ReplaceColumn(-1, column), std::out_of_range);
+  EXPECT_THROW(cache.ReplaceRow(0, column), std::invalid_argument);
+  EXPECT_THROW(cache.Update(u, b.Transpose()), std::invalid_argument);
+  EXPECT_THROW(S21CachedInverse(S21Matrix(3, 4)), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CholeskyUpdate) {
+  const S21Matrix spd = PositiveDefiniteMatrix(120);
+  const S21Matrix u = uniform_matrix(120, 3);
+  S21Cholesky cholesky = spd.Cholesky();
+  const S21Matrix l = cholesky.L();
+  cholesky.Update(u);
+  EXPECT_EQ(cholesky.L(), (spd + u * u.Transpose()).Cholesky().L());
+  cholesky.Downdate(u);
+  EXPECT_EQ(cholesky.L(), l);
+}
+
+TEST(S21MatrixTest, CholeskyDowndateIndefinite) {
+  const S21Matrix spd = PositiveDefiniteMatrix(120);
+  S21Cholesky cholesky = spd.Cholesky();
+  const S21Matrix l = cholesky.L();
+  S21Matrix too_large(120, 2);
+  too_large(0, 1) = 2.0 * std::sqrt(spd(0, 0));
+  EXPECT_THROW(cholesky.Downdate(too_large), std::invalid_argument);
+  EXPECT_TRUE(cholesky.L() == l);
+  EXPECT_THROW(cholesky.Update(S21Matrix(3, 120)), std::invalid_argument);
+  EXPECT_THROW(spd.Cholesky().Downdate(too_large), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CholeskyUpdateHermitian) {
+  const ComplexMatrix h = HermitianMatrix(120);
+  const ComplexMatrix x = UniformComplexMatrix(120, 2);
+  S21BasicCholesky<Complex> cholesky = h.Cholesky();
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  const ComplexMatrix l = cholesky.L();
+  cholesky.Update(x);
+  EXPECT_EQ(cholesky.L(), (h + x * ConjugateTranspose(x)).Cholesky().L());
+  cholesky.Downdate(x);
+  EXPECT_EQ(cholesky.L(), l);
+}
 }  // namespace
 
 int main(int argc, char** argv) {
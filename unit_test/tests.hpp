@@ -3,10 +3,20 @@
 
 #include <gtest/gtest.h>
 
+#include "../s21_fixed_matrix.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_matrix_gemm.h"
+#include "../s21_matrix_io.h"
 #include "../s21_matrix_oop.h"
+#include "../s21_matrix_sparse.h"
+#include "../s21_matrix_text.h"
+#include "../s21_matrix_update.h"
 
 void random_matrix(S21Matrix& matrix);
 void check_sizes(int i, int j);
 void check_zero_values(int i, int j);
+void fill_uniform(S21Matrix& matrix);
+S21Matrix uniform_matrix(int rows, int cols);
+S21Matrix naive_multiply(const S21Matrix& a, const S21Matrix& b);
 
 #endif  // UNIT_TEST_TESTS_HPP